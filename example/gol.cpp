@@ -123,8 +123,8 @@ int gol(const unsigned nCells, const unsigned nTimeSteps ) {
     
     // Cage
     typedef graybat::Cage<CP, GP> Cage;
-    typedef typename Cage::Event  Event;
     typedef typename Cage::Vertex Vertex;
+    typedef typename Cage::Edge   Edge;
 
     /***************************************************************************
      * Initialize Communication
@@ -144,7 +144,6 @@ int gol(const unsigned nCells, const unsigned nTimeSteps ) {
     /***************************************************************************
      * Run Simulation
      ****************************************************************************/
-    std::vector<Event> events;   
     std::vector<unsigned> golDomain(grid.getVertices().size(), 0); 
     Vertex root = grid.getVertex(0);
 
@@ -156,24 +155,24 @@ int gol(const unsigned nCells, const unsigned nTimeSteps ) {
 	    printGolDomain(golDomain, width, height, timestep);
 	}
 	
-	// Send cell state to neighbor cells
-	std::vector<Event> es;	 
+	// Exchange cell states with the neighbor cells, the states
+	// of all cells of a peer are sent in one message
 	for(Vertex &cell : grid.getHostedVertices()){
-	    cell.spread(cell().isAlive, events);
+	    cell().aliveNeighbors = 0;
 	}
 
-	// Recv cell state from neighbor cells and update own cell states
+	grid.exchange([](const Vertex &cell) -> const std::array<unsigned, 1>& {
+		return cell.vertexProperty.isAlive;
+	    },
+	    [](const Edge &edge, const unsigned *first, const unsigned *){
+		edge.target.vertexProperty.aliveNeighbors += *first;
+	    });
+
+	// Update own cell states
 	for(Vertex &cell : grid.getHostedVertices()){
-	    cell().aliveNeighbors = cell.accumulate(std::plus<unsigned>(), 0);
 	    updateState(cell);
 	}
 
-	// Wait to finish events
-	for(unsigned i = 0; i < events.size(); ++i){
-	    events.back().wait();
-	    events.pop_back();
-	}
-
 	// Gather state by vertex with id = 0
 	for(Vertex &cell: grid.getHostedVertices()){
 	    grid.gather(root, cell, cell().isAlive, golDomain, true);
@@ -81,3 +81,11 @@ set(graybat_LIBRARIES ${graybat_LIBRARIES} ${MPI_CXX_LIBRARIES})
 ################################################################################
 find_package(Threads MODULE)
 set(graybat_LIBRARIES ${graybat_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+
+################################################################################
+# Find RT (shm_open of the SHM communication policy)
+################################################################################
+find_library(RT_LIBRARY rt)
+if(RT_LIBRARY)
+  set(graybat_LIBRARIES ${graybat_LIBRARIES} ${RT_LIBRARY})
+endif(RT_LIBRARY)
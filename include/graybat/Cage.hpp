@@ -25,20 +25,30 @@
 #include <cstddef>   /* nullptr_t */
 
 // STL
+#include <array>     /* std::array */
 #include <map>       /* map */
 #include <exception> /* std::out_of_range */
-#include <algorithm> /* std::max */
+#include <algorithm> /* std::max, std::min */
 #include <stdexcept> /* std::runtime_error */
 #include <tuple>     /* std::tie */
 #include <memory>    /* std::shared_memory */
 #include <sstream>   /* std::stringstream */
+#include <limits>    /* std::numeric_limits */
+#include <vector>    /* std::vector */
+#include <type_traits> /* std::decay, std::is_reference */
+#include <utility>   /* std::declval */
 
 // GRAYBAT
 #include <graybat/utils/exclusivePrefixSum.hpp> /* exclusivePrefixSum */
+#include <graybat/utils/reduceElements.hpp>     /* utils::reduceElements */
+#include <graybat/utils/LazyRange.hpp>          /* utils::LazyRange */
+#include <graybat/LocalMailbox.hpp>             /* LocalMailbox, LocalRecvStorage, LocalSendChannel, LocalRecvChannel */
 #include <graybat/Vertex.hpp>                   /* CommunicationVertex */
 #include <graybat/Edge.hpp>                     /* CommunicationEdge */
 #include <graybat/pattern/None.hpp>             /* graybatt::pattern::None */
 #include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/Operation.hpp> /* Operation */
+#include <graybat/communicationPolicy/RecvView.hpp>  /* RecvView */
 #include <graybat/graphPolicy/Traits.hpp>
 
 namespace graybat {
@@ -57,6 +67,10 @@ namespace graybat {
      *
      * @remark A peer can host several vertices.
      *
+     * @remark Messages on edges between two vertices of the same peer
+     *         do not enter the communication policy, they are kept in
+     *         a mailbox of the cage until they are received.
+     *
      *
      ***************************************************************************/
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
@@ -69,6 +83,7 @@ namespace graybat {
         using Event               = graybat::communicationPolicy::Event<CommunicationPolicy>;
         using CPConfig            = graybat::communicationPolicy::Config<CommunicationPolicy>;
         using ContextID           = graybat::communicationPolicy::ContextID<CommunicationPolicy>;
+        using Tag                 = graybat::communicationPolicy::Tag<CommunicationPolicy>;
         using Edge                = graybat::CommunicationEdge<Cage>;
         using Vertex              = graybat::CommunicationVertex<Cage>;
 
@@ -79,6 +94,40 @@ namespace graybat {
         using GraphID             = graybat::graphPolicy::GraphID;
         using Peer                = size_t;
 
+        template<typename T>
+        using RecvView            = graybat::communicationPolicy::RecvView<T, LocalRecvStorage<T, typename CommunicationPolicy::template RecvView<T> > >;
+
+        template<typename T>
+        using SendChannel         = LocalSendChannel<EdgeID, T, typename CommunicationPolicy::template SendChannel<T> >;
+
+        template<typename T>
+        using RecvChannel         = LocalRecvChannel<EdgeID, T, typename CommunicationPolicy::template RecvChannel<T> >;
+
+        // Build vertices and edges from the elements the graph
+        // policy iterates, when a range is dereferenced
+        struct MakeVertex {
+            Cage *cage;
+
+            template<typename T_Vertex>
+            Vertex operator()(T_Vertex const &vertex) const {
+                return cage->makeVertex(vertex);
+            }
+        };
+
+        struct MakeEdge {
+            Cage *cage;
+
+            template<typename T_Edge>
+            Edge operator()(T_Edge const &edge) const {
+                return cage->makeEdge(edge);
+            }
+        };
+
+        using VertexRange         = utils::LazyRange<Vertex, graybat::graphPolicy::AllVertexIter<GraphPolicy>, MakeVertex>;
+        using AdjacentVertexRange = utils::LazyRange<Vertex, graybat::graphPolicy::AdjacentVertexIter<GraphPolicy>, MakeVertex>;
+        using OutEdgeRange        = utils::LazyRange<Edge, graybat::graphPolicy::OutEdgeIter<GraphPolicy>, MakeEdge>;
+        using InEdgeRange         = utils::LazyRange<Edge, graybat::graphPolicy::InEdgeIter<GraphPolicy>, MakeEdge>;
+
         template<class T_Functor>
         Cage(CPConfig const cpConfig, T_Functor graphFunctor) :
             comm(new CommunicationPolicy(cpConfig)),
@@ -125,17 +174,23 @@ namespace graybat {
         template<typename T_Functor>
         void setGraph(T_Functor graphFunctor);
 
-        auto getVertices() -> std::vector<Vertex>;
+        /**
+         * @brief The accessors of vertices and edges return ranges, that
+         *        build each vertex or edge not until it is visited. Thus
+         *        iterating them allocates no memory. The ranges convert
+         *        to std::vector if all elements are needed at once.
+         */
+        auto getVertices() -> VertexRange;
 
         auto getVertex(const VertexID &vertexID) -> Vertex;
 
         auto getEdge(const Vertex &source, const Vertex &target) -> Edge;
 
-        auto getAdjacentVertices(const Vertex &v) -> std::vector<Vertex>;
+        auto getAdjacentVertices(const Vertex &v) -> AdjacentVertexRange;
 
-        auto getOutEdges(const Vertex &v) -> std::vector<Edge>;
+        auto getOutEdges(const Vertex &v) -> OutEdgeRange;
 
-        auto getInEdges(const Vertex &v) -> std::vector<Edge>;
+        auto getInEdges(const Vertex &v) -> InEdgeRange;
         /** @} */
 
         /***********************************************************************//**
@@ -288,6 +343,18 @@ namespace graybat {
         template<typename T>
         Edge recv(T &data);
 
+        /**
+         * @brief Synchron receive from the *srcVertex* on *edge*, without
+         *        copying the payload into a user buffer.
+         *
+         * @param[in]  edge Edge over which the data will be transmitted.
+         *
+         * @return Read-only view of the received elements of type T.
+         *
+         */
+        template<typename T>
+        RecvView<T> recv(const Edge &edge);
+
         /**
          * @brief Asynchron receive of *data* from the *srcVertex* on *edge*.
          *
@@ -300,6 +367,37 @@ namespace graybat {
         template<typename T>
         void recv(const Edge &edge, T &data, std::vector<Event> &events);
 
+        /**
+         * @brief Binds *data* to repeated transmissions on *edge*. The
+         *        returned channel sends the current content of *data* on
+         *        start() and completes the send on wait().
+         *
+         * The host of the target vertex is located once, thus codes that
+         * send over the same edges every step only pay for the transport.
+         * *data* needs to keep its address and size as long as the channel
+         * is used and must not be changed from start() until wait() returned.
+         * Between vertices of the same peer the channel uses the local
+         * mailbox, thus it can be paired with send and recv as well.
+         *
+         * @param[in] edge Edge over which the *data* will be transmitted.
+         * @param[in] data Data that will be send on each start().
+         *
+         */
+        template<typename T>
+        SendChannel<T> bindSend(const Edge &edge, const T &data);
+
+        /**
+         * @brief Binds *data* to repeated receives on *edge*, the
+         *        counterpart of bindSend. Each start() is matched by
+         *        one start() of the channel of the source vertex.
+         *
+         * @param[in]  edge Edge over which the *data* will be transmitted.
+         * @param[out] data Data that will be received between start() and wait().
+         *
+         */
+        template<typename T>
+        RecvChannel<T> bindRecv(const Edge &edge, T &data);
+
         /** @} */
 
         /**********************************************************************//**
@@ -324,6 +422,20 @@ namespace graybat {
         template<typename T_Send, typename T_Recv>
         void allGather(const Vertex &srcVertex, T_Send sendData, T_Recv &recvData, const bool reorder);
 
+        /**
+         * @brief Sends a block of *sendData* to every vertex and
+         *        receives a block from every vertex. Needs to be
+         *        called for all hosted vertices, the exchange starts
+         *        with the last call.
+         *
+         * @param[in]  srcVertex vertex that sends and receives
+         * @param[in]  sendData  one block for each vertex, ordered by vertex id
+         * @param[out] recvData  one block from each vertex, ordered by vertex id
+         *
+         */
+        template<typename T_Send, typename T_Recv>
+        void allToAll(const Vertex &srcVertex, const T_Send &sendData, T_Recv &recvData);
+
         /**
          * @brief Spread data from a vertex to all adjacent vertices
          *        connected by an outgoing edge (async).
@@ -360,8 +472,41 @@ namespace graybat {
         template<typename T>
         void collect(const Vertex &vertex, T &data);
 
+        /**
+         * @brief Spreads the data of every hosted vertex over its
+         *        outgoing edges and delivers the data of all incoming
+         *        edges, in one call for all hosted vertices.
+         *
+         * The data sent to a peer is packed into a single message, the
+         * receives of all peers are posted before the first send and
+         * the data of a peer is delivered as soon as its message
+         * arrived. Data on local edges is delivered without a copy.
+         * All vertices need to send the same number of elements, like
+         * for collect, otherwise a std::runtime_error is thrown before
+         * anything is sent. Needs to be called by all peers, that host
+         * vertices.
+         *
+         * @param[in] sendFn sendFn(vertex) returns a reference to the
+         *                   data of a hosted *vertex*, which provides
+         *                   data() and size().
+         * @param[in] recvFn recvFn(edge, first, last) is called once for
+         *                   every incoming *edge* of the hosted vertices
+         *                   with the elements [first, last) sent on it.
+         *
+         */
+        template<typename T_SendFn, typename T_RecvFn>
+        void exchange(T_SendFn sendFn, T_RecvFn recvFn);
+
         void synchronize();
 
+        /**
+         * @brief Enters the barrier of all peers of the graph and
+         *        returns an event, that is ready when all peers
+         *        have entered it.
+         *
+         */
+        Event asyncSynchronize();
+
 
         /** @} */
 
@@ -383,12 +528,112 @@ namespace graybat {
          * MAPS
          *
          ***************************************************************************/
-        // Maps vertices to its hosts
-        std::map<VertexID, VAddr> vertexMap;
+        // Maps vertices to its hosts, indexed by vertex id
+        std::vector<VAddr> vertexMap;
+        static constexpr VAddr unknownVAddr = std::numeric_limits<VAddr>::max();
 
         // List of vertices of the hosts
         std::map<VAddr, std::vector<Vertex> > peerMap;
 
+        /***************************************************************************
+         *
+         * LOCAL MESSAGES
+         *
+         ***************************************************************************/
+        // Messages on edges, whose source and target are hosted by this
+        // peer. On the heap, thus events and channels keep their pointer
+        // to it when the cage is moved.
+        std::unique_ptr<LocalMailbox<EdgeID> > localMailbox{new LocalMailbox<EdgeID>()};
+        VAddr ownVAddr = unknownVAddr;
+
+        // Finished operation shared by the events of local sends
+        std::shared_ptr<graybat::communicationPolicy::Operation> localDone{makeLocalDone()};
+
+        /***************************************************************************
+         *
+         * COMMUNICATION PLAN
+         *
+         ***************************************************************************/
+        // Edge of a hosted vertex and the host of its other end
+        struct Route {
+            EdgeID edgeID;
+            VAddr vAddr;
+            bool local;
+        };
+
+        // Position of the vertex in the plan, indexed by vertex id
+        std::vector<std::size_t> planIndex;
+        static constexpr std::size_t notPlanned = std::numeric_limits<std::size_t>::max();
+
+        // Routes of the out and in edges of the i-th announced vertex
+        // are [offsets[i], offsets[i + 1]) of the routes
+        std::vector<std::size_t> outRouteOffsets;
+        std::vector<Route> outRoutes;
+        std::vector<std::size_t> inRouteOffsets;
+        std::vector<Route> inRoutes;
+
+        // Announced vertices in order of their position in the plan
+        std::vector<VertexID> planVertices;
+
+        /***************************************************************************
+         *
+         * EXCHANGE PLAN
+         *
+         ***************************************************************************/
+        // Edge to or from a remote peer and the position of the
+        // announced vertex, whose data is sent on it
+        struct Segment {
+            EdgeID edgeID;
+            std::size_t plan_i;
+        };
+
+        // Segments of the message to or from the i-th peer are
+        // [offsets[i], offsets[i + 1]) of the segments, in edge id order
+        bool exchangePlanned = false;
+        Tag exchangeTag = 0;
+        std::vector<VAddr> sendPeers;
+        std::vector<std::size_t> sendSegmentOffsets;
+        std::vector<Segment> sendSegments;
+        std::vector<VAddr> recvPeers;
+        std::vector<std::size_t> recvSegmentOffsets;
+        std::vector<Segment> recvSegments;
+
+        /**
+         * @brief Builds the routes of the out and in edges of the
+         *        announced *vertices*, once their hosts are known.
+         */
+        void buildPlan(const std::vector<Vertex> &vertices);
+
+        /**
+         * @brief Groups the routes to and from remote peers by peer,
+         *        for the first exchange after announce.
+         */
+        void buildExchangePlan();
+
+        /**
+         * @brief Returns true if source and target of *edge* are both
+         *        hosted by this peer.
+         */
+        bool isLocal(const Edge &edge) const;
+
+        /**
+         * @brief Returns a ready event for operations, that finished
+         *        without the communication policy.
+         */
+        Event localEvent();
+
+        static std::shared_ptr<graybat::communicationPolicy::Operation> makeLocalDone();
+
+        /**
+         * @brief Builds the vertex or edge of the element, that the
+         *        iterators of the graph policy point to.
+         */
+        template<typename T_Vertex>
+        Vertex makeVertex(const T_Vertex &vertex);
+
+        template<typename T_Edge>
+        Edge makeEdge(const T_Edge &edge);
+
         /**
          * @brief Reorders data received from vertices into vertex id order.
          *
@@ -397,6 +642,12 @@ namespace graybat {
         void reorder(const std::vector<T> &data, const std::vector<unsigned> &recvCount, std::vector<T> &dataReordered);
     };
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    constexpr typename Cage<T_CommunicationPolicy, T_GraphPolicy>::VAddr Cage<T_CommunicationPolicy, T_GraphPolicy>::unknownVAddr;
+
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    constexpr std::size_t Cage<T_CommunicationPolicy, T_GraphPolicy>::notPlanned;
+
     //!
     //! GRAPH OPERATIONS
     //!
@@ -410,37 +661,20 @@ namespace graybat {
 
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
-    getVertices() -> std::vector<Vertex> {
+    getVertices() -> VertexRange {
         using Iter = graybat::graphPolicy::AllVertexIter<GraphPolicy>;
-        std::vector<Vertex> vertices;
 
         Iter vi_first, vi_last;
         std::tie(vi_first, vi_last) = graph.getVertices();
 
-        while (vi_first != vi_last) {
-            vertices.push_back(Vertex(graph.getVertexProperty(*vi_first).first,
-                                      graph.getVertexProperty(*vi_first).second,
-                                      *this));
-            vi_first++;
-        }
-
-        return vertices;
+        return VertexRange(vi_first, vi_last, MakeVertex{this});
 
     }
 
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     getVertex(const VertexID &vertexID) -> Vertex {
-        typedef typename GraphPolicy::AllVertexIter Iter;
-
-        Iter vi_first, vi_last;
-        std::tie(vi_first, vi_last) = graph.getVertices();
-
-        std::advance(vi_first, vertexID);
-
-        return Vertex(graph.getVertexProperty(*vi_first).first,
-                      graph.getVertexProperty(*vi_first).second,
-                      *this);
+        return makeVertex(vertexID);
     }
 
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
@@ -449,11 +683,7 @@ namespace graybat {
         std::pair<EdgeID, bool> edge = graph.getEdge(source.id, target.id);
 
         if (edge.second) {
-            return Edge(graph.getEdgeProperty(edge.first).first,
-                        getVertex(graph.getEdgeSource(edge.first)),
-                        getVertex(graph.getEdgeTarget(edge.first)),
-                        graph.getEdgeProperty(edge.first).second,
-                        *this);
+            return makeEdge(edge.first);
         }
         else {
             throw std::runtime_error("Edge between does not exist");
@@ -463,72 +693,60 @@ namespace graybat {
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     getAdjacentVertices(const Vertex &v)
-    -> std::vector<Vertex> {
+    -> AdjacentVertexRange {
         typedef typename GraphPolicy::AdjacentVertexIter Iter;
 
-        std::vector<Vertex> adjacentVertices;
-
         Iter avi_first, avi_last;
         std::tie(avi_first, avi_last) = graph.getAdjacentVertices(v.id);
 
-        while (avi_first != avi_last) {
-            adjacentVertices.push_back(Vertex(graph.getVertexProperty(*avi_first).first,
-                                              graph.getVertexProperty(*avi_first).second,
-                                              *this));
-            avi_first++;
-        }
-
-        return adjacentVertices;
+        return AdjacentVertexRange(avi_first, avi_last, MakeVertex{this});
 
     }
 
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     getOutEdges(const Vertex &v)
-    -> std::vector<Edge> {
+    -> OutEdgeRange {
         typedef typename GraphPolicy::OutEdgeIter Iter;
-        std::vector<Edge> outEdges;
 
         Iter oi_first, oi_last;
         std::tie(oi_first, oi_last) = graph.getOutEdges(v.id);
 
-        while (oi_first != oi_last) {
-            outEdges.push_back(Edge(graph.getEdgeProperty(*oi_first).first,
-                                    getVertex(graph.getEdgeSource(*oi_first)),
-                                    getVertex(graph.getEdgeTarget(*oi_first)),
-                                    graph.getEdgeProperty(*oi_first).second,
-                                    *this));
-            oi_first++;
-
-        }
-
-        return outEdges;
+        return OutEdgeRange(oi_first, oi_last, MakeEdge{this});
 
     }
 
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     getInEdges(const Vertex &v)
-    -> std::vector<Edge> {
+    -> InEdgeRange {
         typedef typename GraphPolicy::InEdgeIter Iter;
-        std::vector<Edge> inEdges;
 
         Iter ii_first, ii_last;
         std::tie(ii_first, ii_last) = graph.getInEdges(v.id);
 
-        while (ii_first != ii_last) {
-            inEdges.push_back(Edge(graph.getEdgeProperty(*ii_first).first,
-                                   getVertex(graph.getEdgeSource(*ii_first)),
-                                   getVertex(graph.getEdgeTarget(*ii_first)),
-                                   graph.getEdgeProperty(*ii_first).second,
-                                   *this));
-            ii_first++;
+        return InEdgeRange(ii_first, ii_last, MakeEdge{this});
 
-        }
-
-        return inEdges;
+    }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T_Vertex>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    makeVertex(const T_Vertex &vertex) -> Vertex {
+        auto &property = graph.getVertexProperty(vertex);
+        return Vertex(property.first, property.second, *this);
+    }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T_Edge>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    makeEdge(const T_Edge &edge) -> Edge {
+        auto &property = graph.getEdgeProperty(edge);
+        return Edge(property.first,
+                    makeVertex(graph.getEdgeSource(edge)),
+                    makeVertex(graph.getEdgeTarget(edge)),
+                    property.second,
+                    *this);
     }
 
     //!
@@ -562,6 +780,11 @@ namespace graybat {
 
         graphContext = comm->splitContext(vertices.size(), oldContext);
 
+        // Hosts of the previous graph are forgotten, also by peers
+        // that host no vertex of this one
+        vertexMap.assign(getVertices().size(), unknownVAddr);
+        peerMap.clear();
+
         // Each peer announces the vertices it hosts
         if (graphContext.valid()) {
             std::array<unsigned, 1> nVertices{{static_cast<unsigned>(vertices.size())}};
@@ -570,10 +793,11 @@ namespace graybat {
             std::for_each(vertices.begin(), vertices.end(), [&vertexIDs](Vertex v) { vertexIDs.push_back(v.id); });
 
             // Send hostedVertices to all other peers
+            std::vector<Event> events;
             for (auto const &vAddr : graphContext) {
                 assert(nVertices[0] != 0);
-                comm->asyncSend(vAddr, 0, graphContext, nVertices);
-                comm->asyncSend(vAddr, 0, graphContext, vertexIDs);
+                events.push_back(comm->asyncSend(vAddr, 0, graphContext, nVertices));
+                events.push_back(comm->asyncSend(vAddr, 0, graphContext, vertexIDs));
             }
 
             // Recv hostedVertices from all other peers
@@ -591,17 +815,148 @@ namespace graybat {
                 peerMap[vAddr] = remoteVertices;
             }
 
+            for (Event &e : events) {
+                e.wait();
+            }
+
+        }
+
+        buildPlan(vertices);
+
+    }
+
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    buildPlan(const std::vector<Vertex> &vertices)
+    -> void {
+        planIndex.assign(vertexMap.size(), notPlanned);
+        outRouteOffsets.assign(1, 0);
+        inRouteOffsets.assign(1, 0);
+        outRoutes.clear();
+        inRoutes.clear();
+        planVertices.clear();
+        exchangePlanned = false;
+        localMailbox->clear();
+        ownVAddr = unknownVAddr;
+
+        // Peers without vertices are not part of the graph context
+        if (vertices.empty()) {
+            return;
+        }
+
+        ownVAddr = graphContext.getVAddr();
+
+        for (const Vertex &vertex : vertices) {
+            planIndex.at(vertex.id) = outRouteOffsets.size() - 1;
+            planVertices.push_back(vertex.id);
+
+            for (Edge edge : getOutEdges(vertex)) {
+                const VAddr destVAddr = locateVertex(edge.target);
+                outRoutes.push_back(Route{edge.id, destVAddr, destVAddr == ownVAddr});
+            }
+            outRouteOffsets.push_back(outRoutes.size());
+
+            for (Edge edge : getInEdges(vertex)) {
+                const VAddr srcVAddr = locateVertex(edge.source);
+                inRoutes.push_back(Route{edge.id, srcVAddr, srcVAddr == ownVAddr});
+            }
+            inRouteOffsets.push_back(inRoutes.size());
         }
 
     }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    buildExchangePlan()
+    -> void {
+        using Entry = std::tuple<VAddr, EdgeID, std::size_t>;
+
+        // Messages of the exchange are tagged by the first id, that
+        // is no edge id, so they do not match the messages of edges
+        exchangeTag = 0;
+        for (VertexID vertex = 0; vertex < vertexMap.size(); ++vertex) {
+            typename GraphPolicy::OutEdgeIter oi_first, oi_last;
+            std::tie(oi_first, oi_last) = graph.getOutEdges(vertex);
+            for (; oi_first != oi_last; ++oi_first) {
+                exchangeTag = std::max(exchangeTag, static_cast<Tag>(graph.getEdgeProperty(*oi_first).first + 1));
+            }
+        }
+
+        auto group = [](std::vector<Entry> &entries, std::vector<VAddr> &peers,
+                        std::vector<std::size_t> &offsets, std::vector<Segment> &segments) {
+            std::sort(entries.begin(), entries.end());
+            peers.clear();
+            offsets.assign(1, 0);
+            segments.clear();
+            for (const Entry &entry : entries) {
+                if (peers.empty() || peers.back() != std::get<0>(entry)) {
+                    if (!peers.empty()) {
+                        offsets.push_back(segments.size());
+                    }
+                    peers.push_back(std::get<0>(entry));
+                }
+                segments.push_back(Segment{std::get<1>(entry), std::get<2>(entry)});
+            }
+            if (!peers.empty()) {
+                offsets.push_back(segments.size());
+            }
+        };
+
+        std::vector<Entry> sends;
+        std::vector<Entry> recvs;
+        for (std::size_t plan_i = 0; plan_i < planVertices.size(); ++plan_i) {
+            for (std::size_t route_i = outRouteOffsets[plan_i]; route_i < outRouteOffsets[plan_i + 1]; ++route_i) {
+                const Route &route = outRoutes[route_i];
+                if (!route.local) {
+                    sends.push_back(Entry(route.vAddr, route.edgeID, plan_i));
+                }
+            }
+            for (std::size_t route_i = inRouteOffsets[plan_i]; route_i < inRouteOffsets[plan_i + 1]; ++route_i) {
+                const Route &route = inRoutes[route_i];
+                if (!route.local) {
+                    recvs.push_back(Entry(route.vAddr, route.edgeID, plan_i));
+                }
+            }
+        }
+
+        group(sends, sendPeers, sendSegmentOffsets, sendSegments);
+        group(recvs, recvPeers, recvSegmentOffsets, recvSegments);
+        exchangePlanned = true;
+
+    }
+
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    isLocal(const Edge &edge) const
+    -> bool {
+        return ownVAddr != unknownVAddr
+            && edge.source.id < vertexMap.size() && vertexMap[edge.source.id] == ownVAddr
+            && edge.target.id < vertexMap.size() && vertexMap[edge.target.id] == ownVAddr;
+    }
+
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    localEvent()
+    -> Event {
+        return Event(localDone);
+    }
+
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    makeLocalDone()
+    -> std::shared_ptr<graybat::communicationPolicy::Operation> {
+        // Finished up front, thus threads only read it
+        auto done = std::make_shared<graybat::communicationPolicy::Operation>([](bool const) { return true; });
+        done->wait();
+        return done;
+    }
+
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     locateVertex(const Vertex &vertex)
     -> VAddr {
-        auto it = vertexMap.find(vertex.id);
-        if (it != vertexMap.end()) {
-            return (*it).second;
+        if (vertex.id < vertexMap.size() && vertexMap[vertex.id] != unknownVAddr) {
+            return vertexMap[vertex.id];
         }
         else {
             std::stringstream errorMsg;
@@ -631,14 +986,7 @@ namespace graybat {
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     isHosting(const Vertex &vertex)
     -> bool {
-        VAddr vaddr = graphContext.getVAddr();
-
-        for (Vertex &v : getVerticesHostedBy(vaddr)) {
-            if (vertex.id == v.id)
-                return true;
-        }
-        return false;
-
+        return vertex.id < planIndex.size() && planIndex[vertex.id] != notPlanned;
 
     }
 
@@ -666,6 +1014,10 @@ namespace graybat {
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     send(const Edge &edge, const T &data)
     -> void {
+        if (isLocal(edge)) {
+            localMailbox->put(edge.id, data);
+            return;
+        }
         VAddr destVAddr = locateVertex(edge.target);
         comm->send(destVAddr, edge.id, graphContext, data);
     }
@@ -676,6 +1028,11 @@ namespace graybat {
     send(const Edge &edge, const T &data, std::vector<Event> &events)
     -> void {
         //std::cout << "send cage:" << edge.target.id << " " << edge.id << std::endl;
+        if (isLocal(edge)) {
+            localMailbox->put(edge.id, data);
+            events.push_back(localEvent());
+            return;
+        }
         VAddr destVAddr = locateVertex(edge.target);
         events.push_back(comm->asyncSend(destVAddr, edge.id, graphContext, data));
     }
@@ -686,22 +1043,44 @@ namespace graybat {
     recv(const Edge &edge, T &data)
     -> void {
         //std::cout << "recv cage:" << edge.source.id << " " << edge.id << std::endl;
+        if (isLocal(edge)) {
+            localMailbox->waitTake(edge.id, data);
+            return;
+        }
         VAddr srcVAddr = locateVertex(edge.source);
         comm->recv(srcVAddr, edge.id, graphContext, data);
     }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    recv(const Edge &edge)
+    -> RecvView<T> {
+        using Storage = LocalRecvStorage<T, typename CommunicationPolicy::template RecvView<T> >;
+
+        if (isLocal(edge)) {
+            // The buffer of the message is handed over to the view
+            typename LocalMailbox<EdgeID>::Buffer buffer;
+            localMailbox->waitTake(edge.id, buffer);
+            return RecvView<T>(Storage(std::move(buffer)));
+        }
+        VAddr srcVAddr = locateVertex(edge.source);
+        return RecvView<T>(Storage(comm->template recv<T>(srcVAddr, edge.id, graphContext)));
+    }
+
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     template<typename T>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     recv(T &data)
     -> Edge {
+        EdgeID edgeID;
+        if (localMailbox->takeAny(data, edgeID)) {
+            return makeEdge(edgeID);
+        }
+
         Event event = comm->recv(graphContext, data);
 
-        return Edge(graph.getEdgeProperty(event.getTag()).first,
-                    getVertex(graph.getEdgeSource(event.getTag())),
-                    getVertex(graph.getEdgeTarget(event.getTag())),
-                    graph.getEdgeProperty(event.getTag()).second,
-                    *this);
+        return makeEdge(static_cast<EdgeID>(event.getTag()));
     }
 
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
@@ -709,10 +1088,54 @@ namespace graybat {
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     recv(const Edge &edge, T &data, std::vector<Event> &events)
     -> void {
+        if (isLocal(edge)) {
+            if (localMailbox->take(edge.id, data)) {
+                events.push_back(localEvent());
+                return;
+            }
+
+            // Sent later by a vertex of this peer, thus the event
+            // takes the message when it is tested or waited for
+            const EdgeID edgeID = edge.id;
+            LocalMailbox<EdgeID> *mailbox = localMailbox.get();
+            events.push_back(Event(std::make_shared<graybat::communicationPolicy::Operation>(
+                [mailbox, &data, edgeID](bool const block) {
+                    if (block) {
+                        mailbox->waitTake(edgeID, data);
+                        return true;
+                    }
+                    return mailbox->take(edgeID, data);
+                })));
+            return;
+        }
         VAddr srcVAddr = locateVertex(edge.source);
         events.push_back(comm->asyncRecv(srcVAddr, edge.id, graphContext, data));
     }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    bindSend(const Edge &edge, const T &data)
+    -> SendChannel<T> {
+        if (isLocal(edge)) {
+            return SendChannel<T>(*localMailbox, edge.id, data);
+        }
+        VAddr destVAddr = locateVertex(edge.target);
+        return SendChannel<T>(comm->bindSend(destVAddr, edge.id, graphContext, data));
+    }
+
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    bindRecv(const Edge &edge, T &data)
+    -> RecvChannel<T> {
+        if (isLocal(edge)) {
+            return RecvChannel<T>(*localMailbox, edge.id, data);
+        }
+        VAddr srcVAddr = locateVertex(edge.source);
+        return RecvChannel<T>(comm->bindRecv(srcVAddr, edge.id, graphContext, data));
+    }
+
 
     //!
     //! Collective Communication Operations
@@ -724,10 +1147,11 @@ namespace graybat {
     reduce(const Vertex &rootVertex, const Vertex &srcVertex, Op op, const std::vector<T_Data> sendData,
            std::vector<T_Data> &recvData)
     -> void {
-        static std::vector<T_Data> reduce;
-        static std::vector<T_Data> *rootRecvData;
-        static unsigned vertexCount = 0;
-        static bool hasRootVertex = false;
+        // Per thread, since the peers of the Threads policy share a process
+        static thread_local std::vector<T_Data> reduce;
+        static thread_local std::vector<T_Data> *rootRecvData;
+        static thread_local unsigned vertexCount = 0;
+        static thread_local bool hasRootVertex = false;
 
         VAddr rootVAddr = locateVertex(rootVertex);
         VAddr srcVAddr = locateVertex(srcVertex);
@@ -741,7 +1165,7 @@ namespace graybat {
         }
 
         // Reduce locally
-        std::transform(reduce.begin(), reduce.end(), sendData.begin(), reduce.begin(), op);
+        utils::reduceElements(op, reduce.data(), sendData.data(), reduce.data(), reduce.size());
 
         // Remember pointer of recvData from rootVertex
         if (rootVertex.id == srcVertex.id) {
@@ -760,8 +1184,10 @@ namespace graybat {
 
             }
 
+            // The root may be hosted by another peer next time
             reduce.clear();
             vertexCount = 0;
+            hasRootVertex = false;
         }
         assert(vertexCount <= vertices.size());
 
@@ -773,9 +1199,9 @@ namespace graybat {
     allReduce(const Vertex &srcVertex, Op op, const std::vector<T_Data> sendData, T_Recv &recvData)
     -> void {
 
-        static std::vector<T_Data> reduce;
-        static unsigned vertexCount = 0;
-        static std::vector<T_Recv *> recvDatas;
+        static thread_local std::vector<T_Data> reduce;
+        static thread_local unsigned vertexCount = 0;
+        static thread_local std::vector<T_Recv *> recvDatas;
 
         VAddr srcVAddr = locateVertex(srcVertex);
         Context context = graphContext;
@@ -790,7 +1216,7 @@ namespace graybat {
         }
 
         // Reduce locally
-        std::transform(reduce.begin(), reduce.end(), sendData.begin(), reduce.begin(), op);
+        utils::reduceElements(op, reduce.data(), sendData.data(), reduce.data(), reduce.size());
 
         // Finally start reduction
         if (vertexCount == vertices.size()) {
@@ -805,6 +1231,7 @@ namespace graybat {
 
 
             reduce.clear();
+            recvDatas.clear();
             vertexCount = 0;
         }
         assert(vertexCount <= vertices.size());
@@ -819,10 +1246,10 @@ namespace graybat {
         typedef typename T_Send::value_type SendValueType;
         typedef typename T_Recv::value_type RecvValueType;
 
-        static std::vector<SendValueType> gather;
-        static T_Recv *rootRecvData = NULL;
-        static bool peerHostsRootVertex = false;
-        static unsigned nGatherCalls = 0;
+        static thread_local std::vector<SendValueType> gather;
+        static thread_local T_Recv *rootRecvData = NULL;
+        static thread_local bool peerHostsRootVertex = false;
+        static thread_local unsigned nGatherCalls = 0;
 
         nGatherCalls++;
 
@@ -859,8 +1286,11 @@ namespace graybat {
                 comm->gatherVar(rootVAddr, context, gather, recvData, recvCount);
             }
 
+            // The root may be hosted by another peer next time
             gather.clear();
             nGatherCalls = 0;
+            rootRecvData = NULL;
+            peerHostsRootVertex = false;
 
         }
 
@@ -874,9 +1304,9 @@ namespace graybat {
         typedef typename T_Send::value_type SendValueType;
         typedef typename T_Recv::value_type RecvValueType;
 
-        static std::vector<SendValueType> gather;
-        static std::vector<T_Recv *> recvDatas;
-        static unsigned nGatherCalls = 0;
+        static thread_local std::vector<SendValueType> gather;
+        static thread_local std::vector<T_Recv *> recvDatas;
+        static thread_local unsigned nGatherCalls = 0;
         nGatherCalls++;
 
         VAddr srcVAddr = locateVertex(srcVertex);
@@ -908,20 +1338,91 @@ namespace graybat {
             }
 
             gather.clear();
+            recvDatas.clear();
+            nGatherCalls = 0;
 
         }
 
     }
 
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T_Send, typename T_Recv>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    allToAll(const Vertex &srcVertex, const T_Send &sendData, T_Recv &recvData)
+    -> void {
+        typedef typename T_Send::value_type SendValueType;
+
+        static thread_local std::map<VertexID, std::vector<SendValueType> > sendDatas;
+        static thread_local std::map<VertexID, T_Recv *> recvDatas;
+
+        sendDatas[srcVertex.id].assign(sendData.begin(), sendData.end());
+        recvDatas[srcVertex.id] = &recvData;
+
+        if (sendDatas.size() == hostedVertices.size()) {
+            Context context = graphContext;
+            const std::vector<Vertex> localVertices = getVerticesHostedBy(context.getVAddr());
+            const unsigned nElementsPerVertex = sendData.size() / getVertices().size();
+
+            // The message to a peer holds the blocks from each hosted
+            // vertex to each vertex of the peer, both in announce order
+            std::vector<SendValueType> send;
+            std::vector<unsigned> sendCount(context.size(), 0);
+            for (auto const &vAddr : context) {
+                for (Vertex const &local : localVertices) {
+                    std::vector<SendValueType> const &localData = sendDatas.at(local.id);
+                    for (Vertex const &remote : getVerticesHostedBy(vAddr)) {
+                        auto const block = localData.begin() + remote.id * nElementsPerVertex;
+                        send.insert(send.end(), block, block + nElementsPerVertex);
+                        sendCount[vAddr] += nElementsPerVertex;
+                    }
+                }
+            }
+
+            std::vector<SendValueType> recv;
+            std::vector<unsigned> recvCount;
+            comm->allToAllVar(context, send, sendCount, recv, recvCount);
+
+            auto block = recv.begin();
+            for (auto const &vAddr : context) {
+                for (Vertex const &remote : getVerticesHostedBy(vAddr)) {
+                    for (Vertex const &local : localVertices) {
+                        std::copy(block, block + nElementsPerVertex,
+                                  recvDatas.at(local.id)->begin() + remote.id * nElementsPerVertex);
+                        block += nElementsPerVertex;
+                    }
+                }
+            }
+
+            sendDatas.clear();
+            recvDatas.clear();
+
+        }
+
+    }
+
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     template<typename T>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     spread(const Vertex &vertex, const T &data, std::vector<Event> &events)
     -> void {
-        std::vector<Edge> edges = getOutEdges(vertex);
-        for (Edge edge: edges) {
-            Cage::send(edge, data, events);
+        if (!isHosting(vertex)) {
+            for (Edge edge: getOutEdges(vertex)) {
+                Cage::send(edge, data, events);
+            }
+            return;
+        }
+
+        const std::size_t plan_i = planIndex[vertex.id];
+        for (std::size_t route_i = outRouteOffsets[plan_i]; route_i < outRouteOffsets[plan_i + 1]; ++route_i) {
+            const Route &route = outRoutes[route_i];
+            if (route.local) {
+                localMailbox->put(route.edgeID, data);
+                events.push_back(localEvent());
+            }
+            else {
+                events.push_back(comm->asyncSend(route.vAddr, route.edgeID, graphContext, data));
+            }
         }
     }
 
@@ -930,9 +1431,22 @@ namespace graybat {
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     spread(const Vertex &vertex, const T &data)
     -> void {
-        std::vector<Edge> edges = getOutEdges(vertex);
-        for (Edge edge: edges) {
-            Cage::send(edge, data);
+        if (!isHosting(vertex)) {
+            for (Edge edge: getOutEdges(vertex)) {
+                Cage::send(edge, data);
+            }
+            return;
+        }
+
+        const std::size_t plan_i = planIndex[vertex.id];
+        for (std::size_t route_i = outRouteOffsets[plan_i]; route_i < outRouteOffsets[plan_i + 1]; ++route_i) {
+            const Route &route = outRoutes[route_i];
+            if (route.local) {
+                localMailbox->put(route.edgeID, data);
+            }
+            else {
+                comm->send(route.vAddr, route.edgeID, graphContext, data);
+            }
         }
     }
 
@@ -941,16 +1455,160 @@ namespace graybat {
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     collect(const Vertex &vertex, T &data)
     -> void {
-        std::vector<Edge> edges = getInEdges(vertex);
-        for (unsigned i = 0; i < edges.size(); ++i) {
-            unsigned elementsPerEdge = data.size() / edges.size();
+        if (!isHosting(vertex)) {
+            InEdgeRange edges = getInEdges(vertex);
+            if (edges.empty()) {
+                return;
+            }
+
+            const unsigned elementsPerEdge = data.size() / edges.size();
             std::vector<typename T::value_type> elements(elementsPerEdge);
-            Cage::recv(edges[i], elements);
+            unsigned i = 0;
+            for (Edge edge : edges) {
+                Cage::recv(edge, elements);
+                std::copy(elements.begin(), elements.end(), data.begin() + (i * elementsPerEdge));
+                ++i;
+            }
+            return;
+        }
+
+        const std::size_t plan_i = planIndex[vertex.id];
+        const std::size_t first = inRouteOffsets[plan_i];
+        const std::size_t nEdges = inRouteOffsets[plan_i + 1] - first;
+        if (nEdges == 0) {
+            return;
+        }
+
+        const unsigned elementsPerEdge = data.size() / nEdges;
+        std::vector<typename T::value_type> elements(elementsPerEdge);
+        for (std::size_t i = 0; i < nEdges; ++i) {
+            const Route &route = inRoutes[first + i];
+            if (route.local) {
+                localMailbox->waitTake(route.edgeID, elements);
+            }
+            else {
+                comm->recv(route.vAddr, route.edgeID, graphContext, elements);
+            }
             std::copy(elements.begin(), elements.end(), data.begin() + (i * elementsPerEdge));
         }
 
     }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    template<typename T_SendFn, typename T_RecvFn>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    exchange(T_SendFn sendFn, T_RecvFn recvFn)
+    -> void {
+        static_assert(std::is_reference<decltype(sendFn(std::declval<const Vertex &>()))>::value,
+                      "sendFn needs to return a reference to the data of the vertex");
+
+        using Data  = typename std::decay<decltype(sendFn(std::declval<const Vertex &>()))>::type;
+        using Value = typename Data::value_type;
+
+        // Kept for the next exchange, thus steady exchanges do not allocate
+        static thread_local std::vector<const Data *> vertexData;
+        static thread_local std::vector<std::vector<Value> > sendBuffers;
+        static thread_local std::vector<std::vector<Value> > recvBuffers;
+
+        if (planVertices.empty()) {
+            return;
+        }
+
+        if (!exchangePlanned) {
+            buildExchangePlan();
+        }
+
+        vertexData.clear();
+        for (VertexID vertexID : planVertices) {
+            vertexData.push_back(&sendFn(makeVertex(vertexID)));
+        }
+        const std::size_t nElements = vertexData.front()->size();
+        for (std::size_t plan_i = 1; plan_i < vertexData.size(); ++plan_i) {
+            if (vertexData[plan_i]->size() != nElements) {
+                std::stringstream errorMsg;
+                errorMsg << "[" << comm->getGlobalContext().getVAddr() << "] Vertex " << planVertices[plan_i]
+                         << " exchanges " << vertexData[plan_i]->size() << " elements, but vertex "
+                         << planVertices.front() << " exchanges " << nElements << ".";
+                throw std::runtime_error(errorMsg.str());
+            }
+        }
+
+        // Post all receives before the first send
+        std::vector<Event> recvEvents;
+        recvBuffers.resize(std::max(recvBuffers.size(), recvPeers.size()));
+        for (std::size_t peer_i = 0; peer_i < recvPeers.size(); ++peer_i) {
+            const std::size_t nSegments = recvSegmentOffsets[peer_i + 1] - recvSegmentOffsets[peer_i];
+            recvBuffers[peer_i].resize(nSegments * nElements);
+            recvEvents.push_back(comm->asyncRecv(recvPeers[peer_i], exchangeTag, graphContext, recvBuffers[peer_i]));
+        }
+
+        // One message to each peer with the data of all its edges
+        std::vector<Event> sendEvents;
+        sendBuffers.resize(std::max(sendBuffers.size(), sendPeers.size()));
+        for (std::size_t peer_i = 0; peer_i < sendPeers.size(); ++peer_i) {
+            std::vector<Value> &buffer = sendBuffers[peer_i];
+            buffer.clear();
+            for (std::size_t segment_i = sendSegmentOffsets[peer_i]; segment_i < sendSegmentOffsets[peer_i + 1]; ++segment_i) {
+                const Data &data = *vertexData[sendSegments[segment_i].plan_i];
+                buffer.insert(buffer.end(), data.data(), data.data() + data.size());
+            }
+            sendEvents.push_back(comm->asyncSend(sendPeers[peer_i], exchangeTag, graphContext, buffer));
+        }
+
+        // Local edges while the messages are on their way
+        for (std::size_t plan_i = 0; plan_i < planVertices.size(); ++plan_i) {
+            const Data &data = *vertexData[plan_i];
+            for (std::size_t route_i = outRouteOffsets[plan_i]; route_i < outRouteOffsets[plan_i + 1]; ++route_i) {
+                const Route &route = outRoutes[route_i];
+                if (route.local) {
+                    recvFn(makeEdge(route.edgeID), data.data(), data.data() + data.size());
+                }
+            }
+        }
+
+        // Deliver the data of the peers in the order their messages
+        // arrive. A sweep without any arrived message blocks on the
+        // first pending one, instead of polling again.
+        std::vector<bool> delivered(recvPeers.size(), false);
+        std::size_t nPending = recvPeers.size();
+        auto deliver = [&](const std::size_t peer_i) {
+            const Value *block = recvBuffers[peer_i].data();
+            for (std::size_t segment_i = recvSegmentOffsets[peer_i]; segment_i < recvSegmentOffsets[peer_i + 1]; ++segment_i) {
+                recvFn(makeEdge(recvSegments[segment_i].edgeID), block, block + nElements);
+                block += nElements;
+            }
+            delivered[peer_i] = true;
+            --nPending;
+        };
+
+        while (nPending > 0) {
+            std::size_t firstPending = recvPeers.size();
+            bool arrived = false;
+            for (std::size_t peer_i = 0; peer_i < recvPeers.size(); ++peer_i) {
+                if (delivered[peer_i]) {
+                    continue;
+                }
+                if (recvEvents[peer_i].ready()) {
+                    deliver(peer_i);
+                    arrived = true;
+                }
+                else {
+                    firstPending = std::min(firstPending, peer_i);
+                }
+            }
+
+            if (!arrived) {
+                recvEvents[firstPending].wait();
+                deliver(firstPending);
+            }
+        }
+
+        for (Event &event : sendEvents) {
+            event.wait();
+        }
+
+    }
+
     template<typename T_CommunicationPolicy, typename T_GraphPolicy>
     auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
     synchronize()
@@ -958,6 +1616,13 @@ namespace graybat {
         comm->synchronize(graphContext);
     }
 
+    template<typename T_CommunicationPolicy, typename T_GraphPolicy>
+    auto Cage<T_CommunicationPolicy, T_GraphPolicy>::
+    asyncSynchronize()
+    -> Event {
+        return comm->asyncSynchronize(graphContext);
+    }
+
 
     //!
     //! Utilities
@@ -0,0 +1,318 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <algorithm>     /* std::min */
+#include <condition_variable> /* std::condition_variable */
+#include <cstddef>       /* std::size_t */
+#include <cstdint>       /* std::int8_t */
+#include <cstring>       /* std::memcpy */
+#include <deque>         /* std::deque */
+#include <mutex>         /* std::mutex, std::lock_guard, std::unique_lock */
+#include <unordered_map> /* std::unordered_map */
+#include <utility>       /* std::move */
+#include <vector>        /* std::vector */
+
+// BOOST
+#include <boost/optional.hpp> /* boost::optional */
+
+namespace graybat {
+
+    /**
+     * @brief Messages on edges, whose source and target vertex are
+     *        hosted by the same peer.
+     *
+     * Each edge has a queue of messages in the order they were put.
+     * The buffers of taken messages are kept and reused by later
+     * messages, thus a steady exchange does not allocate. The mailbox
+     * can be used by several threads, waitTake() blocks until another
+     * thread put a message.
+     *
+     */
+    template <typename T_Key>
+    class LocalMailbox {
+    public:
+        using Buffer = std::vector<std::int8_t>;
+
+        /**
+         * @brief Drops all messages, the spare buffers are kept.
+         */
+        void clear(){
+            std::lock_guard<std::mutex> lock(access);
+            boxes.clear();
+        }
+
+        template <typename T_Send>
+        void put(T_Key const key, T_Send const &data){
+            std::size_t const bytes = data.size() * sizeof(typename T_Send::value_type);
+            {
+                std::lock_guard<std::mutex> lock(access);
+                Buffer buffer;
+                if(!spares.empty()){
+                    buffer = std::move(spares.back());
+                    spares.pop_back();
+                }
+                buffer.resize(bytes);
+                if(bytes > 0){
+                    std::memcpy(buffer.data(), data.data(), bytes);
+                }
+                boxes[key].push_back(std::move(buffer));
+            }
+            putCondition.notify_all();
+        }
+
+        /**
+         * @brief Moves the oldest message on *key* into *buffer*.
+         *
+         * @return false if there is no message on *key*
+         */
+        bool take(T_Key const key, Buffer &buffer){
+            std::lock_guard<std::mutex> lock(access);
+            return pop(key, buffer);
+        }
+
+        /**
+         * @brief Copies the oldest message on *key* into *data*, at most
+         *        as many bytes as *data* can hold.
+         *
+         * @return false if there is no message on *key*
+         */
+        template <typename T_Recv>
+        bool take(T_Key const key, T_Recv &data){
+            std::lock_guard<std::mutex> lock(access);
+            Buffer buffer;
+            if(!pop(key, buffer)){
+                return false;
+            }
+            copyOut(std::move(buffer), data);
+            return true;
+        }
+
+        /**
+         * @brief Like take(), but waits for a message on *key*.
+         */
+        template <typename T_Recv>
+        void waitTake(T_Key const key, T_Recv &data){
+            std::unique_lock<std::mutex> lock(access);
+            Buffer buffer;
+            putCondition.wait(lock, [&]{ return pop(key, buffer); });
+            copyOut(std::move(buffer), data);
+        }
+
+        void waitTake(T_Key const key, Buffer &buffer){
+            std::unique_lock<std::mutex> lock(access);
+            putCondition.wait(lock, [&]{ return pop(key, buffer); });
+        }
+
+        /**
+         * @brief Copies the oldest message of any key into *data*.
+         *
+         * @return false if there is no message at all
+         */
+        template <typename T_Recv>
+        bool takeAny(T_Recv &data, T_Key &key){
+            std::lock_guard<std::mutex> lock(access);
+            for(auto &box : boxes){
+                if(!box.second.empty()){
+                    key = box.first;
+                    Buffer buffer;
+                    pop(key, buffer);
+                    copyOut(std::move(buffer), data);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        std::mutex access;
+        std::condition_variable putCondition;
+        std::unordered_map<T_Key, std::deque<Buffer>> boxes;
+        std::vector<Buffer> spares;
+
+        bool pop(T_Key const key, Buffer &buffer){
+            auto it = boxes.find(key);
+            if(it == boxes.end() || it->second.empty()){
+                return false;
+            }
+            buffer = std::move(it->second.front());
+            it->second.pop_front();
+            return true;
+        }
+
+        // Needs the lock, the buffer is kept for later messages
+        template <typename T_Recv>
+        void copyOut(Buffer &&buffer, T_Recv &data){
+            std::size_t const bytes = std::min(buffer.size(), data.size() * sizeof(typename T_Recv::value_type));
+            if(bytes > 0){
+                std::memcpy(data.data(), buffer.data(), bytes);
+            }
+            if(spares.size() < maxSpares){
+                spares.push_back(std::move(buffer));
+            }
+        }
+
+        static constexpr std::size_t maxSpares = 16;
+
+    };
+
+    /**
+     * @brief Storage of a RecvView, that either holds a message of
+     *        a LocalMailbox or the view of the communication policy.
+     *
+     */
+    template <typename T_Value, typename T_RemoteView>
+    struct LocalRecvStorage {
+
+        using Buffer = std::vector<std::int8_t>;
+
+        LocalRecvStorage(Buffer &&local) :
+            local(std::move(local)){
+
+        }
+
+        LocalRecvStorage(T_RemoteView &&remote) :
+            remote(std::move(remote)){
+
+        }
+
+        std::int8_t const * getData() const {
+            return local ? local->data() : reinterpret_cast<std::int8_t const *>(remote->data());
+        }
+
+        std::size_t getDataSize() const {
+            return local ? local->size() : remote->size() * sizeof(T_Value);
+        }
+
+        boost::optional<Buffer>       local;
+        boost::optional<T_RemoteView> remote;
+
+    };
+
+    /**
+     * @brief Send channel on an edge, that either puts into a
+     *        LocalMailbox or uses the channel of the communication
+     *        policy.
+     *
+     */
+    template <typename T_Key, typename T_Buffer, typename T_RemoteChannel>
+    struct LocalSendChannel {
+
+        LocalSendChannel(LocalMailbox<T_Key> &mailbox, T_Key const key, T_Buffer const &buffer) :
+            mailbox(&mailbox),
+            key(key),
+            buffer(&buffer){
+
+        }
+
+        LocalSendChannel(T_RemoteChannel &&remote) :
+            remote(std::move(remote)){
+
+        }
+
+        void start(){
+            if(remote){
+                remote->start();
+            }
+            else {
+                mailbox->put(key, *buffer);
+            }
+        }
+
+        void wait(){
+            if(remote){
+                remote->wait();
+            }
+        }
+
+        bool ready(){
+            return remote ? remote->ready() : true;
+        }
+
+    private:
+        LocalMailbox<T_Key> * mailbox = nullptr;
+        T_Key key{};
+        T_Buffer const * buffer = nullptr;
+        boost::optional<T_RemoteChannel> remote;
+
+    };
+
+    /**
+     * @brief Receive channel on an edge, the counterpart of
+     *        LocalSendChannel. A local receive takes the message
+     *        on ready() or wait(), waiting for it in wait().
+     *
+     */
+    template <typename T_Key, typename T_Buffer, typename T_RemoteChannel>
+    struct LocalRecvChannel {
+
+        LocalRecvChannel(LocalMailbox<T_Key> &mailbox, T_Key const key, T_Buffer &buffer) :
+            mailbox(&mailbox),
+            key(key),
+            buffer(&buffer){
+
+        }
+
+        LocalRecvChannel(T_RemoteChannel &&remote) :
+            remote(std::move(remote)){
+
+        }
+
+        void start(){
+            if(remote){
+                remote->start();
+            }
+            else {
+                pending = true;
+            }
+        }
+
+        void wait(){
+            if(remote){
+                remote->wait();
+            }
+            else if(pending){
+                mailbox->waitTake(key, *buffer);
+                pending = false;
+            }
+        }
+
+        bool ready(){
+            if(remote){
+                return remote->ready();
+            }
+            if(pending && mailbox->take(key, *buffer)){
+                pending = false;
+            }
+            return !pending;
+        }
+
+    private:
+        LocalMailbox<T_Key> * mailbox = nullptr;
+        T_Key key{};
+        T_Buffer * buffer = nullptr;
+        bool pending = false;
+        boost::optional<T_RemoteChannel> remote;
+
+    };
+
+} /* namespace graybat */
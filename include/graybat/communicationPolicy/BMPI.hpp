@@ -25,12 +25,16 @@
 
 // STL
 #include <array>     /* array */
-#include <numeric>   /* std::accumulate */
+#include <numeric>   /* std::accumulate, std::partial_sum */
 #include <iostream>  /* std::cout */
 #include <map>       /* std::map */
+#include <memory>    /* std::shared_ptr, std::make_shared */
 #include <exception> /* std::out_of_range */
 #include <sstream>   /* std::stringstream */
 #include <algorithm> /* std::transform */
+#include <type_traits> /* std::integral_constant, std::remove_const */
+#include <utility>   /* std::move */
+#include <vector>    /* std::vector */
 
 // BOOST
 #include <boost/mpi/environment.hpp>
@@ -48,8 +52,28 @@ namespace mpi = boost::mpi;
 #include <graybat/communicationPolicy/bmpi/Context.hpp> /* Context */
 #include <graybat/communicationPolicy/bmpi/Event.hpp>   /* Event */
 #include <graybat/communicationPolicy/bmpi/Config.hpp>   /* Config */
+#include <graybat/communicationPolicy/bmpi/Channel.hpp>  /* Channel */
 #include <graybat/communicationPolicy/Base.hpp> 
 #include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/Operation.hpp>    /* Operation */
+#include <graybat/communicationPolicy/RecvView.hpp>     /* RecvView, VectorStorage */
+#include <graybat/utils/reduceElements.hpp>             /* utils::minimum, utils::maximum */
+
+namespace boost {
+
+    namespace mpi {
+
+        // Reductions with the vectorized minimum and maximum are
+        // done by MPI_MIN and MPI_MAX
+        template <typename T_Value>
+        struct is_mpi_op<utils::minimum<T_Value>, T_Value> : is_mpi_op<minimum<T_Value>, T_Value> {};
+
+        template <typename T_Value>
+        struct is_mpi_op<utils::maximum<T_Value>, T_Value> : is_mpi_op<maximum<T_Value>, T_Value> {};
+
+    } // namespace mpi
+
+} // namespace boost
 
 namespace graybat {
     
@@ -102,6 +126,15 @@ namespace graybat {
             using Config    = typename graybat::communicationPolicy::Config<BMPI>;                        
             using Uri       = int;
 
+            template <typename T>
+            using RecvView  = graybat::communicationPolicy::RecvView<T, graybat::communicationPolicy::VectorStorage<T> >;
+
+            template <typename T_Buffer>
+            using SendChannel = graybat::communicationPolicy::bmpi::Channel;
+
+            template <typename T_Buffer>
+            using RecvChannel = graybat::communicationPolicy::bmpi::Channel;
+
 	    BMPI(Config const) :contextCount(0),
 							uriMap(0),
 							initialContext(contextCount, mpi::communicator()){
@@ -190,6 +223,26 @@ namespace graybat {
 
 	    }
 
+	    /**
+	     * @brief Blocking receive of a message from peer with virtual address srcVAddr,
+	     *        whose size does not need to be known in advance.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     *
+	     * @return Read-only view of the received elements of type T
+	     */
+            template <typename T>
+	    RecvView<T> recv(const VAddr srcVAddr, const Tag tag, const Context context){
+	    	Uri srcUri = getVAddrUri(context, srcVAddr);
+                mpi::status status = context.comm.probe(srcUri, tag);
+                std::vector<T> recvData(*status.count<T>());
+		context.comm.recv(srcUri, tag, recvData.data(), recvData.size());
+                return RecvView<T>(std::move(recvData));
+
+	    }
+
             template <typename T_Recv>
 	    Event recv(const Context context, T_Recv& recvData){
                 //std::cerr << mpi::any_source << " " << mpi::any_tag << std::endl;
@@ -205,6 +258,25 @@ namespace graybat {
 
 	    }
 
+	    /**
+	     * @brief Non blocking receive of a message of any peer with any tag of the *context*.
+	     *
+	     * @return False, if no message has arrived. Otherwise the message is received into
+	     *         *recvData* and its source and tag are returned in *srcVAddr* and *tag*.
+	     */
+            template <typename T_Recv>
+	    bool tryRecv(const Context context, T_Recv& recvData, VAddr& srcVAddr, Tag& tag){
+                auto status = context.comm.iprobe();
+                if(!status){
+                    return false;
+                }
+                context.comm.recv(status->source(), status->tag(), recvData.data(), recvData.size());
+                srcVAddr = status->source();
+                tag = status->tag();
+                return true;
+
+	    }
+
 
 	    /**
 	     * @brief Non blocking receive of a message recvData from peer with virtual address srcVAddr.
@@ -228,6 +300,47 @@ namespace graybat {
             return Event(request);
 	    }
 
+	    /**
+	     * @brief Binds *sendData* to a persistent send request (MPI_Send_init)
+	     *        to the peer with virtual address destVAddr.
+	     *
+	     * The elements of *sendData* need to be MPI datatypes, *sendData*
+	     * needs to keep its address and size as long as the channel is used.
+	     *
+	     * @return Channel, that sends the current content of *sendData* on start()
+	     */
+	    template <typename T_Send>
+	    SendChannel<T_Send> bindSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+		using SendValue = typename std::remove_const<typename T_Send::value_type>::type;
+		static_assert(mpi::is_mpi_datatype<SendValue>::value, "Channels need elements of an MPI datatype.");
+
+		Uri destUri = getVAddrUri(context, destVAddr);
+		MPI_Request request;
+		MPI_Send_init(const_cast<SendValue*>(sendData.data()), static_cast<int>(sendData.size()),
+			      mpi::get_mpi_datatype(SendValue()), destUri, static_cast<int>(tag), context.comm, &request);
+		return SendChannel<T_Send>(request);
+
+	    }
+
+	    /**
+	     * @brief Binds *recvData* to a persistent receive request (MPI_Recv_init)
+	     *        from the peer with virtual address srcVAddr.
+	     *
+	     * @return Channel, that receives into *recvData* between start() and wait()
+	     */
+	    template <typename T_Recv>
+	    RecvChannel<T_Recv> bindRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+		using RecvValue = typename T_Recv::value_type;
+		static_assert(mpi::is_mpi_datatype<RecvValue>::value, "Channels need elements of an MPI datatype.");
+
+		Uri srcUri = getVAddrUri(context, srcVAddr);
+		MPI_Request request;
+		MPI_Recv_init(recvData.data(), static_cast<int>(recvData.size()),
+			      mpi::get_mpi_datatype(RecvValue()), srcUri, static_cast<int>(tag), context.comm, &request);
+		return RecvChannel<T_Recv>(request);
+
+	    }
+
 
 	    /** @} */
     
@@ -407,6 +520,42 @@ namespace graybat {
 
 	    }
 
+	    /**
+	     * @brief Personalized exchange of blocks with **varying** size.
+	     *        The peer with VAddr i receives *sendCount[i]*
+	     *        elements of *sendData*, which follow the blocks of the
+	     *        peers with smaller VAddr.
+	     *
+	     * @param[in]  context    Set of peers that exchange data
+	     * @param[in]  sendData   Blocks for the peers of the *context*, ordered by VAddr
+	     * @param[in]  sendCount  Number of elements sent to each peer
+	     * @param[out] recvData   Blocks from the peers of the *context*, ordered by VAddr.
+	     *                        Is resized to the number of received elements.
+	     * @param[out] recvCount  Number of elements received from each peer
+	     *
+	     */
+	    template <typename T_Send, typename T_Recv>
+	    void allToAllVar(const Context context, const T_Send& sendData, std::vector<unsigned> const & sendCount, T_Recv& recvData, std::vector<unsigned>& recvCount){
+		using SendValue = typename std::remove_const<typename T_Send::value_type>::type;
+		using RecvValue = typename T_Recv::value_type;
+
+		recvCount.resize(context.size());
+		allToAll(context, sendCount, recvCount);
+		recvData.resize(std::accumulate(recvCount.begin(), recvCount.end(), 0U));
+
+		std::vector<int> sdispls(context.size(), 0);
+		std::vector<int> rdispls(context.size(), 0);
+		std::partial_sum(sendCount.begin(), sendCount.end() - 1, sdispls.begin() + 1);
+		std::partial_sum(recvCount.begin(), recvCount.end() - 1, rdispls.begin() + 1);
+
+		MPI_Alltoallv(const_cast<SendValue*>(sendData.data()), const_cast<int*>((int const*)sendCount.data()), sdispls.data(),
+			      mpi::get_mpi_datatype(SendValue()),
+			      recvData.data(), (int*)recvCount.data(), rdispls.data(),
+			      mpi::get_mpi_datatype(RecvValue()),
+			      context.comm);
+
+	    }
+
 	
 	    /**
 	     * @brief Performs a reduction with a binary operator *op* on all *sendData* elements from all peers
@@ -478,6 +627,19 @@ namespace graybat {
 		 context.comm.barrier();
 	     }
 
+	    /**
+	     * @brief Enters the barrier of all peers within *context* and
+	     *        returns without waiting for the other peers. The
+	     *        returned event is ready when all peers have entered
+	     *        the barrier.
+	     *
+	     */
+	     Event asyncSynchronize(const Context context){
+		 auto request = std::make_shared<MPI_Request>();
+		 MPI_Ibarrier(context.comm, request.get());
+		 return eventOf(request);
+	     }
+
 	
 	    /**
 	     * @brief Synchronizes all peers within the globalContext
@@ -491,6 +653,79 @@ namespace graybat {
 	     }
 	    /** @} */
 
+
+	    /************************************************************************//**
+	     *
+	     * @name Non-blocking Collective Communication Interface
+	     *
+	     * Map to the non-blocking MPI collectives. Reductions with
+	     * operators, that have no MPI counterpart, use the point to
+	     * point implementation of Base.
+	     *
+	     * @{
+	     *
+	     **************************************************************************/
+	    template <typename T_Send, typename T_Recv>
+	    Event asyncGather(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData){
+		using SendValue = typename std::remove_const<typename T_Send::value_type>::type;
+		using RecvValue = typename T_Recv::value_type;
+		Uri rootUri = getVAddrUri(context, rootVAddr);
+
+		auto request = std::make_shared<MPI_Request>();
+		MPI_Igather(const_cast<SendValue*>(sendData.data()), sendData.size(), mpi::get_mpi_datatype(SendValue()),
+			    recvData.data(), sendData.size(), mpi::get_mpi_datatype(RecvValue()),
+			    rootUri, context.comm, request.get());
+		return eventOf(request);
+	    }
+
+	    template <typename T_Send, typename T_Recv>
+	    Event asyncAllGather(const Context context, const T_Send& sendData, T_Recv& recvData){
+		using SendValue = typename std::remove_const<typename T_Send::value_type>::type;
+		using RecvValue = typename T_Recv::value_type;
+
+		auto request = std::make_shared<MPI_Request>();
+		MPI_Iallgather(const_cast<SendValue*>(sendData.data()), sendData.size(), mpi::get_mpi_datatype(SendValue()),
+			       recvData.data(), sendData.size(), mpi::get_mpi_datatype(RecvValue()),
+			       context.comm, request.get());
+		return eventOf(request);
+	    }
+
+	    template <typename T_Send, typename T_Recv>
+	    Event asyncScatter(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData){
+		using SendValue = typename std::remove_const<typename T_Send::value_type>::type;
+		using RecvValue = typename T_Recv::value_type;
+		Uri rootUri = getVAddrUri(context, rootVAddr);
+
+		auto request = std::make_shared<MPI_Request>();
+		MPI_Iscatter(const_cast<SendValue*>(sendData.data()), recvData.size(), mpi::get_mpi_datatype(SendValue()),
+			     recvData.data(), recvData.size(), mpi::get_mpi_datatype(RecvValue()),
+			     rootUri, context.comm, request.get());
+		return eventOf(request);
+	    }
+
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncReduce(const VAddr rootVAddr, const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData){
+		using Value = typename T_Recv::value_type;
+		return asyncReduce(rootVAddr, context, op, sendData, recvData, std::integral_constant<bool, mpi::is_mpi_op<T_Op, Value>::value>());
+	    }
+
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncAllReduce(const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData){
+		using Value = typename T_Recv::value_type;
+		return asyncAllReduce(context, op, sendData, recvData, std::integral_constant<bool, mpi::is_mpi_op<T_Op, Value>::value>());
+	    }
+
+	    template <typename T_SendRecv>
+	    Event asyncBroadcast(const VAddr rootVAddr, const Context context, T_SendRecv& data){
+		using Value = typename T_SendRecv::value_type;
+		Uri rootUri = getVAddrUri(context, rootVAddr);
+
+		auto request = std::make_shared<MPI_Request>();
+		MPI_Ibcast(data.data(), data.size(), mpi::get_mpi_datatype(Value()), rootUri, context.comm, request.get());
+		return eventOf(request);
+	    }
+	    /** @} */
+
     
 	    /*************************************************************************//**
 	     *
@@ -574,6 +809,54 @@ namespace graybat {
 
 	    }
 
+	    /**
+	     * @brief Returns an event, that completes with the MPI
+	     *        *request*.
+	     *
+	     */
+	    Event eventOf(std::shared_ptr<MPI_Request> request){
+		return Event(std::make_shared<Operation>([request](bool const block){
+			    int done = 0;
+			    if(block){
+				MPI_Wait(request.get(), MPI_STATUS_IGNORE);
+				return true;
+			    }
+			    MPI_Test(request.get(), &done, MPI_STATUS_IGNORE);
+			    return done != 0;
+			}));
+	    }
+
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncReduce(const VAddr rootVAddr, const Context context, const T_Op, const T_Send& sendData, T_Recv& recvData, std::true_type){
+		using Value = typename T_Recv::value_type;
+		Uri rootUri = getVAddrUri(context, rootVAddr);
+
+		auto request = std::make_shared<MPI_Request>();
+		MPI_Ireduce(const_cast<Value*>(sendData.data()), recvData.data(), sendData.size(), mpi::get_mpi_datatype(Value()),
+			    mpi::is_mpi_op<T_Op, Value>::op(), rootUri, context.comm, request.get());
+		return eventOf(request);
+	    }
+
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncReduce(const VAddr rootVAddr, const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData, std::false_type){
+		return Base<BMPI>::asyncReduce(rootVAddr, context, op, sendData, recvData);
+	    }
+
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncAllReduce(const Context context, const T_Op, const T_Send& sendData, T_Recv& recvData, std::true_type){
+		using Value = typename T_Recv::value_type;
+
+		auto request = std::make_shared<MPI_Request>();
+		MPI_Iallreduce(const_cast<Value*>(sendData.data()), recvData.data(), sendData.size(), mpi::get_mpi_datatype(Value()),
+			       mpi::is_mpi_op<T_Op, Value>::op(), context.comm, request.get());
+		return eventOf(request);
+	    }
+
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncAllReduce(const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData, std::false_type){
+		return Base<BMPI>::asyncAllReduce(context, op, sendData, recvData);
+	    }
+
 	    /**
 	     * @brief Returns the uri of a vAddr in a
 	     *        specific context.
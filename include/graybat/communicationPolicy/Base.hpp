@@ -20,7 +20,22 @@
 
 #pragma once
 
+// STL
+#include <algorithm> /* std::copy, std::find, std::min, std::rotate */
+#include <array>     /* std::array */
+#include <functional> /* std::function */
+#include <memory>    /* std::shared_ptr, std::make_shared */
+#include <numeric>   /* std::accumulate, std::partial_sum */
+#include <stdexcept> /* std::runtime_error */
+#include <string>    /* std::to_string */
+#include <type_traits> /* std::remove_const */
+#include <utility>   /* std::pair, std::move */
+#include <vector>    /* std::vector */
+
 #include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/Channel.hpp>   /* SendChannel, RecvChannel */
+#include <graybat/communicationPolicy/Operation.hpp> /* Operation */
+#include <graybat/utils/reduceElements.hpp>         /* utils::reduceElements */
 
 namespace graybat {
     
@@ -45,6 +60,14 @@ namespace graybat {
             using Context             = typename graybat::communicationPolicy::Context<CommunicationPolicy>;
             using Event               = typename graybat::communicationPolicy::Event<CommunicationPolicy>;
 
+            // Policies with persistent requests of their own replace
+            // these channels
+            template <typename T_Buffer>
+            using SendChannel         = graybat::communicationPolicy::SendChannel<CommunicationPolicy, T_Buffer>;
+
+            template <typename T_Buffer>
+            using RecvChannel         = graybat::communicationPolicy::RecvChannel<CommunicationPolicy, T_Buffer>;
+
             // TODO
             // ====
             //
@@ -82,6 +105,25 @@ namespace graybat {
 
 	    template <typename T_Recv>
 	    Event asyncRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData) = delete;
+
+	    /**
+	     * @brief Binds *sendData* to repeated sends to the peer with
+	     *        *destVAddr*. The returned channel sends the current
+	     *        content of *sendData* on start() and completes the
+	     *        send on wait().
+	     *
+	     * Peer, tag and context are resolved once. *sendData* needs to
+	     * keep its address and size as long as the channel is used.
+	     */
+	    template <typename T_Send>
+	    SendChannel<T_Send> bindSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData);
+
+	    /**
+	     * @brief Binds *recvData* to repeated receives from the peer
+	     *        with *srcVAddr*, the counterpart of bindSend().
+	     */
+	    template <typename T_Recv>
+	    RecvChannel<T_Recv> bindRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData);
             /** @} */
 
 	    /************************************************************************//**
@@ -179,6 +221,36 @@ namespace graybat {
 	     */
 	    template <typename T_Send, typename T_Recv>
 	    void allScatter(const Context context, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Sends the ith block of *sendData* to the peer with VAddr i,
+	     *        which receives it as the block of this peer in its *recvData*.
+	     *        All blocks have the same size.
+	     *
+	     * @param[in]  context  Set of peers that exchange data
+	     * @param[in]  sendData One block for each peer of the *context*, ordered by VAddr
+	     * @param[out] recvData One block from each peer of the *context*, ordered by VAddr
+	     *
+	     */
+	    template <typename T_Send, typename T_Recv>
+	    void allToAll(const Context context, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Personalized exchange of blocks with **varying** size.
+	     *        The peer with VAddr i receives *sendCount[i]*
+	     *        elements of *sendData*, which follow the blocks of the
+	     *        peers with smaller VAddr.
+	     *
+	     * @param[in]  context    Set of peers that exchange data
+	     * @param[in]  sendData   Blocks for the peers of the *context*, ordered by VAddr
+	     * @param[in]  sendCount  Number of elements sent to each peer
+	     * @param[out] recvData   Blocks from the peers of the *context*, ordered by VAddr.
+	     *                        Is resized to the number of received elements.
+	     * @param[out] recvCount  Number of elements received from each peer
+	     *
+	     */
+	    template <typename T_Send, typename T_Recv>
+	    void allToAllVar(const Context context, const T_Send& sendData, std::vector<unsigned> const & sendCount, T_Recv& recvData, std::vector<unsigned>& recvCount);
             
             /**
              * @brief Performs a reduction with a binary operator *op* on all *sendData* elements from all peers
@@ -234,6 +306,71 @@ namespace graybat {
 	     *        
 	     */
             void synchronize(const Context context);
+
+	    /**
+	     * @brief Enters the barrier of all peers within *context* and
+	     *        returns without waiting for the other peers. The
+	     *        returned event is ready when all peers have entered
+	     *        the barrier.
+	     *
+	     * The barrier only makes progress while its event is tested
+	     * with ready() or waited for.
+	     */
+            Event asyncSynchronize(const Context context);
+	    /** @} */
+
+	    /************************************************************************//**
+	     *
+	     * @name Non-blocking Collective Communication Interface
+	     *
+	     * The collectives start on call and return an event, that is
+	     * ready when the data of the peer is complete. They make
+	     * progress while the event is tested with ready() or waited
+	     * for. *sendData* and *recvData* must stay valid and keep their
+	     * size until then, *recvData* needs to have its final size on
+	     * call. At most one non-blocking collective may be pending per
+	     * context and peer, and no blocking collective may run on the
+	     * context meanwhile.
+	     *
+	     * @{
+	     *
+	     **************************************************************************/
+	    /**
+	     * @brief Non-blocking gather(), *recvData* is ordered by the
+	     *        VAddr of the peers.
+	     */
+	    template <typename T_Send, typename T_Recv>
+	    Event asyncGather(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Non-blocking allGather().
+	     */
+	    template <typename T_Send, typename T_Recv>
+	    Event asyncAllGather(const Context context, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Non-blocking scatter().
+	     */
+	    template <typename T_Send, typename T_Recv>
+	    Event asyncScatter(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Non-blocking reduce().
+	     */
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncReduce(const VAddr rootVAddr, const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Non-blocking allReduce().
+	     */
+	    template <typename T_Send, typename T_Recv, typename T_Op>
+	    Event asyncAllReduce(const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData);
+
+	    /**
+	     * @brief Non-blocking broadcast().
+	     */
+	    template <typename T_SendRecv>
+	    Event asyncBroadcast(const VAddr rootVAddr, const Context context, T_SendRecv& data);
 	    /** @} */
 
 
@@ -256,8 +393,192 @@ namespace graybat {
 	     */
 	    Context getGlobalContext() = delete;            
 
+	    /**
+	     * @brief Returns the peers of the *context* grouped by the node they
+	     *        run on, in the same order on all peers.
+	     *
+	     * The collectives first exchange data within a node and only one
+	     * peer per node (its leader) talks to the other nodes. Policies
+	     * that do not know where their peers run place every peer on a
+	     * node of its own, which gives the flat collectives.
+	     */
+            std::vector<std::vector<VAddr> > nodesOf(const Context context);
+
+	    /**
+	     * @brief Returns the size of the segments in bytes, in which
+	     *        broadcast and reduce pipeline payloads of at least two
+	     *        segments along a chain of the peers. 0 disables the
+	     *        pipelining.
+	     */
+            size_t segmentSize(const Context context);
+
 	    /** @} */            
             
+        private:
+            using Node = std::vector<VAddr>;
+
+            // Peers that take part in one level of a collective, in an
+            // order all of them agree on
+            using Group = std::vector<VAddr>;
+
+            // Payloads from this size on are reduced and gathered along a
+            // ring, which sends each byte only a constant number of times
+            static constexpr size_t ringSize = 64 * 1024;
+
+            // Number of steps of the pairwise exchange, whose transfers
+            // may be pending at once
+            static constexpr size_t exchangeWindow = 8;
+
+            // Segment size of policies that do not configure it
+            static constexpr size_t defaultSegmentSize = 1024 * 1024;
+
+            // Blocks from this size on are gathered by the root directly
+            // instead of being passed on through the tree
+            static constexpr size_t flatGatherSize = 64 * 1024;
+
+            // Slots of the scratch buffers: the data of a collective,
+            // the data received to be combined with it and the data
+            // gathered around it
+            static constexpr size_t dataSlot    = 0;
+            static constexpr size_t tmpSlot     = 1;
+            static constexpr size_t allDataSlot = 2;
+
+            // Buffers of the collectives, that keep their capacity from
+            // call to call. Per thread, since the peers of the Threads
+            // policy share a process, and per slot, since the buffers of
+            // nested algorithms are in use at the same time
+            template <typename T_Value, size_t T_Slot>
+            static std::vector<T_Value>& scratch();
+
+            /**
+             * @brief Part of a buffer, that is sent or received in place.
+             */
+            template <typename T_Value>
+            struct Slice {
+                using value_type = T_Value;
+
+                T_Value * data() const {
+                    return ptr;
+                }
+
+                size_t size() const {
+                    return n;
+                }
+
+                T_Value * ptr;
+                size_t    n;
+            };
+
+            /**
+             * @brief Transfers of a non-blocking collective, that start
+             *        together. The next phase starts when all receives
+             *        of this one finished and *then* ran.
+             */
+            struct Phase {
+                std::vector<std::pair<VAddr, Slice<char> > > sends;
+                std::vector<std::pair<VAddr, Slice<char> > > recvs;
+                std::function<void()> then;
+            };
+
+            // Returns an event that runs *phases* one after the other,
+            // *buffers* is kept alive until the event is destroyed
+            Event asyncPhases(const Context context, std::vector<Phase> phases, std::shared_ptr<void> buffers);
+
+            template <typename T_Value>
+            static Slice<char> bytesOf(T_Value const * data, const size_t nElements);
+
+            // Binomial tree of *group* rooted at its first peer
+            static Group childrenOf(Group const & group, const size_t index);
+
+            static VAddr parentOf(Group const & group, const size_t index);
+
+            static void broadcastPhases(Group const & group, const size_t index, const Slice<char> data, std::vector<Phase>& phases);
+
+            // The reduced data is folded into *result* at the first peer of
+            // *group* like the blocking reduce does, it stays in the first
+            // buffer if *result* is null
+            template <typename T_Value, typename T_Op>
+            static void reducePhases(Group const & group, const size_t index, const T_Op op, std::shared_ptr<std::vector<std::vector<T_Value> > > buffers, T_Value * result, std::vector<Phase>& phases);
+
+            static size_t indexOf(Group const & group, const VAddr vAddr);
+
+            static size_t nodeIndexOf(std::vector<Node> const & nodes, const VAddr vAddr);
+
+            static Node const & nodeOf(std::vector<Node> const & nodes, const VAddr vAddr);
+
+            // The node of the root is led by the root itself
+            static VAddr leaderOf(Node const & node, const VAddr rootVAddr);
+
+            static Group leadersOf(std::vector<Node> const & nodes, const VAddr rootVAddr);
+
+            // Peers of the node of the root starting with the root, followed
+            // by the peers of the other nodes starting with their leaders
+            static Group chainOf(std::vector<Node> const & nodes, const VAddr rootVAddr);
+
+            // Binomial tree algorithms, ops need to be associative and commutative
+            template <typename T_Data>
+            void treeBroadcast(Group const & group, const size_t rootIndex, const Context context, T_Data& data);
+
+            template <typename T_Value, typename T_Op>
+            void treeReduce(Group const & group, const size_t rootIndex, const Context context, const T_Op op, std::vector<T_Value>& data);
+
+            // *data* holds the own block on entry and the blocks of all
+            // peers in group order at the root on return
+            template <typename T_Value>
+            void treeGather(Group const & group, const size_t rootIndex, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data);
+
+            // *data* holds the blocks of all peers in group order at the
+            // root on entry and the own block on return
+            template <typename T_Value>
+            void treeScatter(Group const & group, const size_t rootIndex, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data);
+
+            // Chooses the algorithm by the payload size and the group size
+            template <typename T_Value, typename T_Op>
+            void groupAllReduce(Group const & group, const Context context, const T_Op op, std::vector<T_Value>& data);
+
+            template <typename T_Value, typename T_Op>
+            void recursiveDoublingAllReduce(Group const & group, const Context context, const T_Op op, std::vector<T_Value>& data);
+
+            // Reduce-scatter followed by an allgather along the ring
+            template <typename T_Value, typename T_Op>
+            void ringAllReduce(Group const & group, const Context context, const T_Op op, std::vector<T_Value>& data);
+
+            // Segments are passed on along the chain as soon as they arrive,
+            // the root is the first peer of the chain
+            template <typename T_Data>
+            void chainBroadcast(Group const & chain, const Context context, const size_t segmentElements, T_Data& data);
+
+            template <typename T_Value, typename T_Op>
+            void chainReduce(Group const & chain, const Context context, const T_Op op, const size_t segmentElements, std::vector<T_Value>& data);
+
+            // Number of elements of a segment, 0 if *nElements* are not pipelined
+            template <typename T_Value>
+            size_t segmentElementsOf(const Context context, const size_t nElements);
+
+            template <typename T_Value>
+            void groupAllGather(Group const & group, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data);
+
+            template <typename T_Value>
+            void ringAllGather(Group const & group, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data);
+
+            // Gathers the blocks of the peers node by node at the root,
+            // respectively at all peers
+            template <typename T_Value, typename T_CountOf>
+            void gatherNodes(const VAddr rootVAddr, const Context context, std::vector<Node> const & nodes, T_CountOf countOf, std::vector<T_Value>& data);
+
+            template <typename T_Value, typename T_CountOf>
+            void allGatherNodes(const Context context, std::vector<Node> const & nodes, T_CountOf countOf, std::vector<T_Value>& data);
+
+            template <typename T_CountOf>
+            static std::vector<size_t> countsOf(Group const & group, T_CountOf countOf);
+
+            // In step k each peer sends to the peer k after it and receives
+            // from the peer k before it, the own block is copied
+            template <typename T_Value>
+            void pairwiseExchange(const Context context, T_Value const * sendData, std::vector<unsigned> const & sendCount, T_Value * recvData, std::vector<unsigned> const & recvCount);
+
+            template <typename T_Value, typename T_CountOf, typename T_OffsetOf, typename T_Recv>
+            static void unpackNodes(std::vector<Node> const & nodes, T_CountOf countOf, T_OffsetOf offsetOf, std::vector<T_Value> const & data, T_Recv& recvData);
             
         };
 
@@ -265,26 +586,34 @@ namespace graybat {
          * Implementation
          ***********************************************************************/
         template <typename T_CommunicationPolicy>
+        template <typename T_Send>
+        auto Base<T_CommunicationPolicy>::bindSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData) -> SendChannel<T_Send> {
+            return SendChannel<T_Send>(*static_cast<CommunicationPolicy*>(this), destVAddr, tag, context, sendData);
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Recv>
+        auto Base<T_CommunicationPolicy>::bindRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData) -> RecvChannel<T_Recv> {
+            return RecvChannel<T_Recv>(*static_cast<CommunicationPolicy*>(this), srcVAddr, tag, context, recvData);
+        }
+
+        template <typename T_CommunicationPolicy>        
         template <typename T_Send, typename T_Recv>
         void Base<T_CommunicationPolicy>::gather(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData){
             using RecvValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;
 
-            Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(rootVAddr, 0, context, sendData);
-                
+            auto const &nodes = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            size_t const nElements = sendData.size();
+            auto const countOf = [nElements](VAddr){ return nElements; };
+
+            std::vector<RecvValueType> &nodeData = scratch<RecvValueType, dataSlot>();
+            nodeData.assign(sendData.begin(), sendData.end());
+            gatherNodes(rootVAddr, context, nodes, countOf, nodeData);
+
             if(rootVAddr == context.getVAddr()){
-                for(auto const &vAddr : context){
-                    size_t recvOffset = vAddr * sendData.size(); 
-                    std::vector<RecvValueType> tmpData(sendData.size());
-                    static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
-                    std::copy(tmpData.begin(), tmpData.end(), recvData.begin() + recvOffset);
-                        
-                }
-                    
+                unpackNodes(nodes, countOf, [nElements](VAddr vAddr){ return vAddr * nElements; }, nodeData, recvData);
             }
-
-            e.wait();
                 
         }
 
@@ -293,29 +622,30 @@ namespace graybat {
         void Base<T_CommunicationPolicy>::gatherVar(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData, std::vector<unsigned>& recvCount){
             using RecvValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;
 
             std::array<unsigned, 1> nElements{{(unsigned)sendData.size()}};
             recvCount.resize(context.size());
             static_cast<CommunicationPolicy*>(this)->allGather(context, nElements, recvCount);
             recvData.resize(std::accumulate(recvCount.begin(), recvCount.end(), 0U));            
-            
-            Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(rootVAddr, 0, context, sendData);
-            
+
+            auto const &nodes = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            auto const countOf = [&recvCount](VAddr vAddr){ return static_cast<size_t>(recvCount.at(vAddr)); };
+
+            std::vector<RecvValueType> &nodeData = scratch<RecvValueType, dataSlot>();
+            nodeData.assign(sendData.begin(), sendData.end());
+            gatherNodes(rootVAddr, context, nodes, countOf, nodeData);
+
             if(rootVAddr == context.getVAddr()){
-                size_t recvOffset = 0;
-                for(auto const &vAddr : context){                    
-                    std::vector<RecvValueType> tmpData(recvCount.at(vAddr));
-                    static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
-                    std::copy(tmpData.begin(), tmpData.end(), recvData.begin() + recvOffset);
-                    recvOffset += recvCount.at(vAddr);
-                        
+                // The data is ordered by the VAddr of the peers
+                std::vector<size_t> recvOffset(recvCount.size(), 0);
+                size_t offset = 0;
+                for(auto const &vAddr : context){
+                    recvOffset.at(vAddr) = offset;
+                    offset += recvCount.at(vAddr);
                 }
-
+                unpackNodes(nodes, countOf, [&recvOffset](VAddr vAddr){ return recvOffset.at(vAddr); }, nodeData, recvData);
             }
 
-            e.wait();
-
         }
         
 
@@ -325,27 +655,15 @@ namespace graybat {
         void Base<T_CommunicationPolicy>::allGather(Context context, const T_Send& sendData, T_Recv& recvData){
             using RecvValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;
-
-            std::vector<Event> events;
-            
-            for(auto const &vAddr : context){                
-                events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(vAddr, 0, context, sendData));
-
-            }
 
-            for(auto const &vAddr : context){                
-                size_t recvOffset = vAddr * sendData.size(); 
-                std::vector<RecvValueType> tmpData(sendData.size());
-                static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
-                std::copy(tmpData.begin(), tmpData.end(), recvData.begin() + recvOffset);
-                        
-            }
+            auto const &nodes = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            size_t const nElements = sendData.size();
+            auto const countOf = [nElements](VAddr){ return nElements; };
 
-            for(unsigned i = 0; i < events.size(); ++i){
-                events.back().wait();
-                events.pop_back();
-            }        
+            std::vector<RecvValueType> &nodeData = scratch<RecvValueType, dataSlot>();
+            nodeData.assign(sendData.begin(), sendData.end());
+            allGatherNodes(context, nodes, countOf, nodeData);
+            unpackNodes(nodes, countOf, [nElements](VAddr vAddr){ return vAddr * nElements; }, nodeData, recvData);
             
         }
 
@@ -354,32 +672,27 @@ namespace graybat {
         void Base<T_CommunicationPolicy>::allGatherVar(const Context context, const T_Send& sendData, T_Recv& recvData, std::vector<unsigned>& recvCount){
             using RecvValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;
 
-            std::vector<Event> events;
-            
             std::array<unsigned, 1> nElements{{(unsigned)sendData.size()}};
             recvCount.resize(context.size());
             static_cast<CommunicationPolicy*>(this)->allGather(context, nElements, recvCount);
             recvData.resize(std::accumulate(recvCount.begin(), recvCount.end(), 0U));            
 
-            for(auto const &vAddr : context){                
-                events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(vAddr, 0, context, sendData));
-            }
-            
-            size_t recvOffset = 0;
-            for(auto const &vAddr : context){                
-                std::vector<RecvValueType> tmpData(recvCount.at(vAddr));
-                static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
-                std::copy(tmpData.begin(), tmpData.end(), recvData.begin() + recvOffset);
-                recvOffset += recvCount.at(vAddr);
-                        
-            }
+            auto const &nodes = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            auto const countOf = [&recvCount](VAddr vAddr){ return static_cast<size_t>(recvCount.at(vAddr)); };
+
+            std::vector<RecvValueType> &nodeData = scratch<RecvValueType, dataSlot>();
+            nodeData.assign(sendData.begin(), sendData.end());
+            allGatherNodes(context, nodes, countOf, nodeData);
 
-            for(unsigned i = 0; i < events.size(); ++i){
-                events.back().wait();
-                events.pop_back();
+            // The data is ordered by the VAddr of the peers
+            std::vector<size_t> recvOffset(recvCount.size(), 0);
+            size_t offset = 0;
+            for(auto const &vAddr : context){
+                recvOffset.at(vAddr) = offset;
+                offset += recvCount.at(vAddr);
             }
+            unpackNodes(nodes, countOf, [&recvOffset](VAddr vAddr){ return recvOffset.at(vAddr); }, nodeData, recvData);
             
         }
         
@@ -388,61 +701,53 @@ namespace graybat {
         void Base<T_CommunicationPolicy>::scatter(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData){
             using SendValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;            
 
-            std::vector<Event> events;
-            
-            if(rootVAddr == context.getVAddr()){
-                for(auto const &vAddr : context){                    
-                    size_t sendOffset = vAddr * recvData.size(); 
-                    std::vector<SendValueType> tmpData(sendData.begin() + sendOffset,
-                                                       sendData.begin() + sendOffset + recvData.size());
-                    events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(vAddr, 0, context, tmpData));
-                        
-                }
-                    
+            // Peers of a node are neighbours in the tree
+            Group group;
+            for(Node const &node : static_cast<CommunicationPolicy*>(this)->nodesOf(context)){
+                group.insert(group.end(), node.begin(), node.end());
             }
 
-            static_cast<CommunicationPolicy*>(this)->recv(rootVAddr, 0, context, recvData);
+            size_t const nElements = recvData.size();
+            std::vector<SendValueType> &data = scratch<SendValueType, dataSlot>();
+            data.clear();
+            if(rootVAddr == context.getVAddr()){
+                for(VAddr const vAddr : group){
+                    size_t sendOffset = vAddr * nElements;
+                    data.insert(data.end(), sendData.begin() + sendOffset, sendData.begin() + sendOffset + nElements);
+                }
 
-            for(unsigned i = 0; i < events.size(); ++i){
-                events.back().wait();
-                events.pop_back();
             }
 
+            treeScatter(group, indexOf(group, rootVAddr), context, std::vector<size_t>(group.size(), nElements), data);
+            std::copy(data.begin(), data.end(), recvData.begin());
+
         }
 
         template <typename T_CommunicationPolicy>        
         template <typename T_Send, typename T_Recv>
         void Base<T_CommunicationPolicy>::allScatter(const Context context, const T_Send& sendData, T_Recv& recvData){
-            using SendValueType       = typename T_Recv::value_type;
-            using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;            
+            static_cast<T_CommunicationPolicy*>(this)->allToAll(context, sendData, recvData);
 
-            std::vector<Event> events;
-            size_t nElementsPerPeer = static_cast<size_t>(recvData.size() / context.size());
-            
-            for(auto const &vAddr : context){                
-                size_t sendOffset = vAddr * nElementsPerPeer; 
-                std::vector<SendValueType> tmpData(sendData.begin() + sendOffset,
-                                                   sendData.begin() + sendOffset + nElementsPerPeer);
-                events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(vAddr, 0, context, tmpData));
-                
-            }
+        }
 
-            for(auto const &vAddr : context){                
-                size_t recvOffset = vAddr * nElementsPerPeer;
-                std::vector<SendValueType> tmpData(nElementsPerPeer);
-                static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
-                std::copy(tmpData.begin(), tmpData.end(), recvData.begin() + recvOffset);
-                
-            }
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv>
+        void Base<T_CommunicationPolicy>::allToAll(const Context context, const T_Send& sendData, T_Recv& recvData){
+            std::vector<unsigned> const counts(context.size(), static_cast<unsigned>(sendData.size() / context.size()));
+            pairwiseExchange(context, sendData.data(), counts, recvData.data(), counts);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv>
+        void Base<T_CommunicationPolicy>::allToAllVar(const Context context, const T_Send& sendData, std::vector<unsigned> const & sendCount, T_Recv& recvData, std::vector<unsigned>& recvCount){
+            recvCount.resize(context.size());
+            static_cast<T_CommunicationPolicy*>(this)->allToAll(context, sendCount, recvCount);
+            recvData.resize(std::accumulate(recvCount.begin(), recvCount.end(), 0U));
+
+            pairwiseExchange(context, sendData.data(), sendCount, recvData.data(), recvCount);
 
-            for(unsigned i = 0; i < events.size(); ++i){
-                events.back().wait();
-                events.pop_back();
-            }
-            
         }
 
         
@@ -451,24 +756,32 @@ namespace graybat {
         void Base<T_CommunicationPolicy>::reduce(const VAddr rootVAddr, const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData){
             using RecvValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;
 
-            Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(rootVAddr, 0, context, sendData);
-            
-            if(rootVAddr == context.getVAddr()){
-                for(auto const &vAddr : context){
-                    std::vector<RecvValueType> tmpData(recvData.size());
-                    static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Node const &node    = nodeOf(nodes, context.getVAddr());
+            VAddr const leader  = leaderOf(node, rootVAddr);
 
-                    for(size_t i = 0; i < recvData.size(); ++i){
-                        recvData[i] = op(recvData[i], tmpData[i]);
-                    }
-                    
+            std::vector<RecvValueType> &nodeData = scratch<RecvValueType, dataSlot>();
+            nodeData.assign(sendData.begin(), sendData.end());
+
+            size_t const segmentElements = segmentElementsOf<RecvValueType>(context, nodeData.size());
+            if(segmentElements){
+                chainReduce(chainOf(nodes, rootVAddr), context, op, segmentElements, nodeData);
+            }
+            else {
+                // Reduce the node at its leader and the nodes at the root
+                treeReduce(node, indexOf(node, leader), context, op, nodeData);
+                if(leader != context.getVAddr()){
+                    return;
                 }
-                
+                treeReduce(leadersOf(nodes, rootVAddr), nodeIndexOf(nodes, rootVAddr), context, op, nodeData);
+            }
+
+            if(rootVAddr != context.getVAddr()){
+                return;
             }
 
-            e.wait();
+            utils::reduceElements(op, recvData.data(), nodeData.data(), recvData.data(), recvData.size());
 
         }
 
@@ -478,75 +791,1028 @@ namespace graybat {
         void  Base<T_CommunicationPolicy>::allReduce(const Context context, T_Op op, const T_Send& sendData, T_Recv& recvData){
             using RecvValueType       = typename T_Recv::value_type;
             using CommunicationPolicy = T_CommunicationPolicy;
-            using Event               = Base<CommunicationPolicy>::Event;
 
-            std::vector<Event> events;            
-            for(auto const &vAddr : context){                
-                Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(vAddr, 0, context, sendData);
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Node const &node    = nodeOf(nodes, context.getVAddr());
+            VAddr const leader  = node.front();
+
+            // Reduce the node at its leader, the leaders reduce among each
+            // other and pass the result on to their node
+            std::vector<RecvValueType> &result = scratch<RecvValueType, dataSlot>();
+            result.assign(sendData.begin(), sendData.end());
+            treeReduce(node, 0, context, op, result);
+            if(leader == context.getVAddr()){
+                groupAllReduce(leadersOf(nodes, leader), context, op, result);
             }
+            treeBroadcast(node, 0, context, result);
+
+            utils::reduceElements(op, recvData.data(), result.data(), recvData.data(), recvData.size());
             
-            for(auto const &vAddr : context){                
-                std::vector<RecvValueType> tmpData(recvData.size());
-                static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, tmpData);
+        }
 
-                for(size_t i = 0; i < recvData.size(); ++i){
-                    recvData[i] = op(recvData[i], tmpData[i]);
-                }
-                    
+        
+        template <typename T_CommunicationPolicy>
+        template <typename T_SendRecv>
+        void Base<T_CommunicationPolicy>::broadcast(const VAddr rootVAddr, const Context context, T_SendRecv& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Node const &node    = nodeOf(nodes, context.getVAddr());
+            VAddr const leader  = leaderOf(node, rootVAddr);
+
+            size_t const segmentElements = segmentElementsOf<typename T_SendRecv::value_type>(context, data.size());
+            if(segmentElements){
+                chainBroadcast(chainOf(nodes, rootVAddr), context, segmentElements, data);
+                return;
             }
 
-            for(unsigned i = 0; i < events.size(); ++i){
-                events.back().wait();
-                events.pop_back();
+            // The root sends to the leaders, which pass it on within
+            // their nodes
+            if(leader == context.getVAddr()){
+                treeBroadcast(leadersOf(nodes, rootVAddr), nodeIndexOf(nodes, rootVAddr), context, data);
             }
+            treeBroadcast(node, indexOf(node, leader), context, data);
             
         }
 
-        
+        /***********************************************************************
+         * Algorithms on a group of peers
+         *
+         * The peers of a group are addressed by their index in the group.
+         * Trees are binomial trees, whose ranks are the indices rotated
+         * such that the root has rank 0. A rank receives from the rank
+         * without its lowest set bit and its subtree covers the ranks up
+         * to that bit, thus it holds contiguous blocks of data.
+         ***********************************************************************/
         template <typename T_CommunicationPolicy>
-        template <typename T_SendRecv>
-        void Base<T_CommunicationPolicy>::broadcast(const VAddr rootVAddr, const Context context, T_SendRecv& data){
+        template <typename T_Data>
+        void Base<T_CommunicationPolicy>::treeBroadcast(Group const & group, const size_t rootIndex, const Context context, T_Data& data){
             using CommunicationPolicy = T_CommunicationPolicy;
 
+            size_t const nPeers = group.size();
+            size_t const rank   = (indexOf(group, context.getVAddr()) + nPeers - rootIndex) % nPeers;
+
+            size_t mask = 1;
+            for(; mask < nPeers; mask <<= 1){
+                if(rank & mask){
+                    static_cast<CommunicationPolicy*>(this)->recv(group[(rank - mask + rootIndex) % nPeers], 0, context, data);
+                    break;
+                }
+
+            }
+
+            // The largest subtree first
             std::vector<Event> events;
-            
-            if(rootVAddr == context.getVAddr()){
-                for(auto const &vAddr : context){                
-                    static_cast<CommunicationPolicy*>(this)->asyncSend(vAddr, 0, context, data);
-                        
+            for(mask >>= 1; mask > 0; mask >>= 1){
+                if(rank + mask < nPeers){
+                    events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(group[(rank + mask + rootIndex) % nPeers], 0, context, data));
                 }
-                    
+
+            }
+
+            for(Event &e : events){
+                e.wait();
             }
 
-            static_cast<CommunicationPolicy*>(this)->recv(rootVAddr, 0, context, data);
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_Op>
+        void Base<T_CommunicationPolicy>::treeReduce(Group const & group, const size_t rootIndex, const Context context, const T_Op op, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const nPeers = group.size();
+            size_t const rank   = (indexOf(group, context.getVAddr()) + nPeers - rootIndex) % nPeers;
+
+            std::vector<T_Value> &tmpData = scratch<T_Value, tmpSlot>();
+            tmpData.resize(nPeers > 1 ? data.size() : 0);
+            for(size_t mask = 1; mask < nPeers; mask <<= 1){
+                if(rank & mask){
+                    static_cast<CommunicationPolicy*>(this)->send(group[(rank - mask + rootIndex) % nPeers], 0, context, data);
+                    return;
+                }
+
+                // The data of the lower ranks comes first
+                if(rank + mask < nPeers){
+                    static_cast<CommunicationPolicy*>(this)->recv(group[(rank + mask + rootIndex) % nPeers], 0, context, tmpData);
+                    utils::reduceElements(op, data.data(), tmpData.data(), data.data(), data.size());
+                }
 
-            for(unsigned i = 0; i < events.size(); ++i){
-                events.back().wait();
-                events.pop_back();
             }
-            
+
         }
 
-        
-        template <typename T_CommunicationPolicy>        
-        void Base<T_CommunicationPolicy>::synchronize(const Context context){
-            std::array<char, 0> null;
-            
-            if(context.getVAddr() == 0){
-                for(auto const &vAddr : context){                    
-                    static_cast<CommunicationPolicy*>(this)->recv(vAddr, 0, context, null);
-                    
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        void Base<T_CommunicationPolicy>::treeGather(Group const & group, const size_t rootIndex, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const nPeers = group.size();
+            size_t const index  = indexOf(group, context.getVAddr());
+            size_t const rank   = (index + nPeers - rootIndex) % nPeers;
+            auto const countOf  = [&](size_t const r){ return counts[(r + rootIndex) % nPeers]; };
+            auto const sumOf    = [&](size_t const begin, size_t const end){
+                size_t sum = 0;
+                for(size_t r = begin; r < end; ++r){
+                    sum += countOf(r);
                 }
-                
-                for(auto const &vAddr : context){                    
-                    static_cast<CommunicationPolicy*>(this)->send(vAddr, 0, context, null);
-                    
+                return sum;
+            };
+
+            size_t const total = sumOf(0, nPeers);
+
+            // Large blocks are not passed on through the tree, but sent
+            // to the root directly
+            if(total * sizeof(T_Value) >= flatGatherSize * nPeers){
+                VAddr const rootVAddr = group[rootIndex];
+                if(rank != 0){
+                    static_cast<CommunicationPolicy*>(this)->send(rootVAddr, 0, context, data);
+                    return;
+                }
+
+                std::vector<T_Value> &allData = scratch<T_Value, allDataSlot>();
+                allData.resize(total);
+                size_t offset = 0;
+                for(size_t i = 0; i < nPeers; ++i){
+                    Slice<T_Value> block{allData.data() + offset, counts[i]};
+                    if(i == index){
+                        std::copy(data.begin(), data.end(), allData.begin() + offset);
+                    }
+                    else {
+                        static_cast<CommunicationPolicy*>(this)->recv(group[i], 0, context, block);
+                    }
+                    offset += counts[i];
                 }
-                    
+                data.swap(allData);
+                return;
+            }
+
+            size_t const lowestBit = rank ? (rank & (~rank + 1)) : nPeers;
+            data.resize(sumOf(rank, std::min(rank + lowestBit, nPeers)));
+
+            size_t offset = countOf(rank);
+            for(size_t mask = 1; mask < nPeers; mask <<= 1){
+                if(rank & mask){
+                    static_cast<CommunicationPolicy*>(this)->send(group[(rank - mask + rootIndex) % nPeers], 0, context, data);
+                    return;
+                }
+
+                size_t const child = rank + mask;
+                if(child < nPeers){
+                    Slice<T_Value> subtree{data.data() + offset, sumOf(child, std::min(child + mask, nPeers))};
+                    static_cast<CommunicationPolicy*>(this)->recv(group[(child + rootIndex) % nPeers], 0, context, subtree);
+                    offset += subtree.size();
+                }
+
+            }
+
+            // The root holds the blocks in rank order
+            std::rotate(data.begin(), data.begin() + sumOf(0, nPeers - rootIndex), data.end());
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        void Base<T_CommunicationPolicy>::treeScatter(Group const & group, const size_t rootIndex, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const nPeers = group.size();
+            size_t const rank   = (indexOf(group, context.getVAddr()) + nPeers - rootIndex) % nPeers;
+            auto const countOf  = [&](size_t const r){ return counts[(r + rootIndex) % nPeers]; };
+            auto const sumOf    = [&](size_t const begin, size_t const end){
+                size_t sum = 0;
+                for(size_t r = begin; r < end; ++r){
+                    sum += countOf(r);
+                }
+                return sum;
+            };
+
+            size_t mask = 1;
+            if(rank == 0){
+                // Blocks in rank order
+                size_t sum = 0;
+                for(size_t i = 0; i < rootIndex; ++i){
+                    sum += counts[i];
+                }
+                std::rotate(data.begin(), data.begin() + sum, data.end());
+                while(mask < nPeers){
+                    mask <<= 1;
+                }
+
             }
             else {
-                static_cast<CommunicationPolicy*>(this)->send(0, 0, context, null);                
-                static_cast<CommunicationPolicy*>(this)->recv(0, 0, context, null);
+                for(; mask < nPeers; mask <<= 1){
+                    if(rank & mask){
+                        data.resize(sumOf(rank, std::min(rank + mask, nPeers)));
+                        static_cast<CommunicationPolicy*>(this)->recv(group[(rank - mask + rootIndex) % nPeers], 0, context, data);
+                        break;
+                    }
+
+                }
+
+            }
+
+            std::vector<Event> events;
+            for(mask >>= 1; mask > 0; mask >>= 1){
+                size_t const child = rank + mask;
+                if(child < nPeers){
+                    Slice<T_Value> subtree{data.data() + sumOf(rank, child), sumOf(child, std::min(child + mask, nPeers))};
+                    events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(group[(child + rootIndex) % nPeers], 0, context, subtree));
+                }
+
+            }
+
+            for(Event &e : events){
+                e.wait();
+            }
+
+            data.resize(countOf(rank));
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_Op>
+        void Base<T_CommunicationPolicy>::groupAllReduce(Group const & group, const Context context, const T_Op op, std::vector<T_Value>& data){
+            if(data.size() * sizeof(T_Value) >= ringSize && data.size() >= group.size()){
+                ringAllReduce(group, context, op, data);
+            }
+            else {
+                recursiveDoublingAllReduce(group, context, op, data);
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_Op>
+        void Base<T_CommunicationPolicy>::recursiveDoublingAllReduce(Group const & group, const Context context, const T_Op op, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const nPeers = group.size();
+            size_t const index  = indexOf(group, context.getVAddr());
+
+            size_t nExchanging = 1;
+            while(nExchanging * 2 <= nPeers){
+                nExchanging *= 2;
+            }
+
+            // Peers beyond the largest power of two hand their data to a
+            // partner and get the result back from it
+            if(index >= nExchanging){
+                static_cast<CommunicationPolicy*>(this)->send(group[index - nExchanging], 0, context, data);
+                static_cast<CommunicationPolicy*>(this)->recv(group[index - nExchanging], 0, context, data);
+                return;
+            }
+
+            std::vector<T_Value> &tmpData = scratch<T_Value, tmpSlot>();
+            tmpData.resize(nPeers > 1 ? data.size() : 0);
+            if(index + nExchanging < nPeers){
+                static_cast<CommunicationPolicy*>(this)->recv(group[index + nExchanging], 0, context, tmpData);
+                utils::reduceElements(op, data.data(), tmpData.data(), data.data(), data.size());
+            }
+
+            // Both partners combine the data of the lower index first,
+            // thus all peers get the same result
+            for(size_t mask = 1; mask < nExchanging; mask <<= 1){
+                size_t const partner = index ^ mask;
+                Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(group[partner], 0, context, data);
+                static_cast<CommunicationPolicy*>(this)->recv(group[partner], 0, context, tmpData);
+                e.wait();
+                if(partner > index){
+                    utils::reduceElements(op, data.data(), tmpData.data(), data.data(), data.size());
+                }
+                else {
+                    utils::reduceElements(op, tmpData.data(), data.data(), data.data(), data.size());
+                }
+
+            }
+
+            if(index + nExchanging < nPeers){
+                static_cast<CommunicationPolicy*>(this)->send(group[index + nExchanging], 0, context, data);
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_Op>
+        void Base<T_CommunicationPolicy>::ringAllReduce(Group const & group, const Context context, const T_Op op, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const nPeers = group.size();
+            size_t const index  = indexOf(group, context.getVAddr());
+            VAddr const right   = group[(index + 1) % nPeers];
+            VAddr const left    = group[(index + nPeers - 1) % nPeers];
+            auto const chunkOf  = [&](size_t const c){
+                return Slice<T_Value>{data.data() + c * data.size() / nPeers,
+                                      (c + 1) * data.size() / nPeers - c * data.size() / nPeers};
+            };
+
+            // Every chunk travels once around the ring and is reduced on
+            // its way, the peer before its start holds the result
+            std::vector<T_Value> &tmpData = scratch<T_Value, tmpSlot>();
+            tmpData.resize(data.size() / nPeers + 1);
+            for(size_t step = 0; step + 1 < nPeers; ++step){
+                Slice<T_Value> sendChunk = chunkOf((index + nPeers - step) % nPeers);
+                Slice<T_Value> recvChunk = chunkOf((index + 2 * nPeers - step - 1) % nPeers);
+                Slice<T_Value> tmpChunk{tmpData.data(), recvChunk.size()};
+
+                Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(right, 0, context, sendChunk);
+                static_cast<CommunicationPolicy*>(this)->recv(left, 0, context, tmpChunk);
+                e.wait();
+                utils::reduceElements(op, tmpChunk.data(), recvChunk.data(), recvChunk.data(), recvChunk.size());
+
+            }
+
+            // The results travel around the ring once more
+            for(size_t step = 0; step + 1 < nPeers; ++step){
+                Slice<T_Value> sendChunk = chunkOf((index + 1 + nPeers - step) % nPeers);
+                Slice<T_Value> recvChunk = chunkOf((index + nPeers - step) % nPeers);
+
+                Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(right, 0, context, sendChunk);
+                static_cast<CommunicationPolicy*>(this)->recv(left, 0, context, recvChunk);
+                e.wait();
+
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Data>
+        void Base<T_CommunicationPolicy>::chainBroadcast(Group const & chain, const Context context, const size_t segmentElements, T_Data& data){
+            using Value               = typename std::remove_const<typename T_Data::value_type>::type;
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const index = indexOf(chain, context.getVAddr());
+
+            std::vector<Event> events;
+            for(size_t offset = 0; offset < data.size(); offset += segmentElements){
+                Slice<Value> segment{data.data() + offset, std::min(segmentElements, data.size() - offset)};
+                if(index > 0){
+                    static_cast<CommunicationPolicy*>(this)->recv(chain[index - 1], 0, context, segment);
+                }
+                if(index + 1 < chain.size()){
+                    events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(chain[index + 1], 0, context, segment));
+                }
+
+            }
+
+            for(Event &e : events){
+                e.wait();
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_Op>
+        void Base<T_CommunicationPolicy>::chainReduce(Group const & chain, const Context context, const T_Op op, const size_t segmentElements, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const index = indexOf(chain, context.getVAddr());
+
+            // Partial results flow from the end of the chain to the root
+            std::vector<Event> events;
+            std::vector<T_Value> &tmpData = scratch<T_Value, tmpSlot>();
+            tmpData.resize(index + 1 < chain.size() ? segmentElements : 0);
+            for(size_t offset = 0; offset < data.size(); offset += segmentElements){
+                Slice<T_Value> segment{data.data() + offset, std::min(segmentElements, data.size() - offset)};
+                if(index + 1 < chain.size()){
+                    Slice<T_Value> tmpSegment{tmpData.data(), segment.size()};
+                    static_cast<CommunicationPolicy*>(this)->recv(chain[index + 1], 0, context, tmpSegment);
+                    utils::reduceElements(op, segment.data(), tmpSegment.data(), segment.data(), segment.size());
+                }
+                if(index > 0){
+                    events.push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(chain[index - 1], 0, context, segment));
+                }
+
+            }
+
+            for(Event &e : events){
+                e.wait();
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        auto Base<T_CommunicationPolicy>::segmentElementsOf(const Context context, const size_t nElements)
+            -> size_t {
+            size_t const segmentElements = static_cast<T_CommunicationPolicy*>(this)->segmentSize(context) / sizeof(T_Value);
+            if(segmentElements == 0 || nElements < 2 * segmentElements){
+                return 0;
+            }
+            return segmentElements;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        void Base<T_CommunicationPolicy>::groupAllGather(Group const & group, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data){
+            size_t const total = std::accumulate(counts.begin(), counts.end(), static_cast<size_t>(0));
+            if(total * sizeof(T_Value) >= ringSize){
+                ringAllGather(group, context, counts, data);
+            }
+            else {
+                treeGather(group, 0, context, counts, data);
+                data.resize(total);
+                treeBroadcast(group, 0, context, data);
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        void Base<T_CommunicationPolicy>::ringAllGather(Group const & group, const Context context, std::vector<size_t> const & counts, std::vector<T_Value>& data){
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            size_t const nPeers = group.size();
+            size_t const index  = indexOf(group, context.getVAddr());
+            VAddr const right   = group[(index + 1) % nPeers];
+            VAddr const left    = group[(index + nPeers - 1) % nPeers];
+
+            std::vector<size_t> offsets(nPeers + 1, 0);
+            std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+            std::vector<T_Value> &allData = scratch<T_Value, allDataSlot>();
+            allData.resize(offsets.back());
+            std::copy(data.begin(), data.end(), allData.begin() + offsets[index]);
+            auto const blockOf = [&](size_t const i){
+                return Slice<T_Value>{allData.data() + offsets[i], counts[i]};
+            };
+
+            for(size_t step = 0; step + 1 < nPeers; ++step){
+                Event e = static_cast<CommunicationPolicy*>(this)->asyncSend(right, 0, context, blockOf((index + nPeers - step) % nPeers));
+                Slice<T_Value> recvBlock = blockOf((index + 2 * nPeers - step - 1) % nPeers);
+                static_cast<CommunicationPolicy*>(this)->recv(left, 0, context, recvBlock);
+                e.wait();
+            }
+
+            data.swap(allData);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_CountOf>
+        void Base<T_CommunicationPolicy>::gatherNodes(const VAddr rootVAddr, const Context context, std::vector<Node> const & nodes, T_CountOf countOf, std::vector<T_Value>& data){
+            Node const &node   = nodeOf(nodes, context.getVAddr());
+            VAddr const leader = leaderOf(node, rootVAddr);
+
+            treeGather(node, indexOf(node, leader), context, countsOf(node, countOf), data);
+            if(leader != context.getVAddr()){
+                return;
+            }
+
+            std::vector<size_t> nodeCounts;
+            for(Node const &otherNode : nodes){
+                std::vector<size_t> counts = countsOf(otherNode, countOf);
+                nodeCounts.push_back(std::accumulate(counts.begin(), counts.end(), static_cast<size_t>(0)));
+            }
+            treeGather(leadersOf(nodes, rootVAddr), nodeIndexOf(nodes, rootVAddr), context, nodeCounts, data);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_CountOf>
+        void Base<T_CommunicationPolicy>::allGatherNodes(const Context context, std::vector<Node> const & nodes, T_CountOf countOf, std::vector<T_Value>& data){
+            Node const &node   = nodeOf(nodes, context.getVAddr());
+            VAddr const leader = node.front();
+
+            treeGather(node, 0, context, countsOf(node, countOf), data);
+
+            std::vector<size_t> nodeCounts;
+            for(Node const &otherNode : nodes){
+                std::vector<size_t> counts = countsOf(otherNode, countOf);
+                nodeCounts.push_back(std::accumulate(counts.begin(), counts.end(), static_cast<size_t>(0)));
+            }
+            if(leader == context.getVAddr()){
+                groupAllGather(leadersOf(nodes, leader), context, nodeCounts, data);
+            }
+
+            data.resize(std::accumulate(nodeCounts.begin(), nodeCounts.end(), static_cast<size_t>(0)));
+            treeBroadcast(node, 0, context, data);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_CountOf>
+        auto Base<T_CommunicationPolicy>::countsOf(Group const & group, T_CountOf countOf)
+            -> std::vector<size_t> {
+            std::vector<size_t> counts;
+            counts.reserve(group.size());
+            for(VAddr const vAddr : group){
+                counts.push_back(countOf(vAddr));
+            }
+            return counts;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, size_t T_Slot>
+        auto Base<T_CommunicationPolicy>::scratch()
+            -> std::vector<T_Value>& {
+            static thread_local std::vector<T_Value> buffer;
+            return buffer;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_CountOf, typename T_OffsetOf, typename T_Recv>
+        void Base<T_CommunicationPolicy>::unpackNodes(std::vector<Node> const & nodes, T_CountOf countOf, T_OffsetOf offsetOf, std::vector<T_Value> const & data, T_Recv& recvData){
+            auto block = data.begin();
+            for(Node const &node : nodes){
+                for(VAddr const vAddr : node){
+                    std::copy(block, block + countOf(vAddr), recvData.begin() + offsetOf(vAddr));
+                    block += countOf(vAddr);
+                }
+
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>        
+        void Base<T_CommunicationPolicy>::synchronize(const Context context){
+            static_cast<T_CommunicationPolicy*>(this)->asyncSynchronize(context).wait();
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::asyncSynchronize(const Context context)
+            -> Event {
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Node const &node    = nodeOf(nodes, context.getVAddr());
+            VAddr const leader  = node.front();
+
+            // Every pending receive needs a byte of its own, the sends
+            // share the first one
+            auto tokens = std::make_shared<std::vector<char> >(1 + node.size() + 8 * sizeof(size_t), 0);
+            Slice<char> const sendToken{tokens->data(), 1};
+            size_t nTokens = 1;
+            auto const recvToken = [&tokens, &nTokens](){
+                return Slice<char>{tokens->data() + nTokens++, 1};
+            };
+
+            std::vector<Phase> phases;
+            if(leader != context.getVAddr()){
+                phases.push_back(Phase{{{leader, sendToken}}, {{leader, recvToken()}}, {}});
+            }
+            else {
+                Phase arrive;
+                Phase release;
+                for(VAddr const vAddr : node){
+                    if(vAddr != context.getVAddr()){
+                        arrive.recvs.push_back({vAddr, recvToken()});
+                        release.sends.push_back({vAddr, sendToken});
+                    }
+
+                }
+                phases.push_back(arrive);
+
+                // Dissemination among the leaders, in round k every leader
+                // notifies the leader 2^k after it, thus after log2(L)
+                // rounds each leader transitively heard from all others
+                Group const leaders   = leadersOf(nodes, nodes.front().front());
+                size_t const nLeaders = leaders.size();
+                size_t const index    = indexOf(leaders, leader);
+                for(size_t distance = 1; distance < nLeaders; distance *= 2){
+                    phases.push_back(Phase{{{leaders[(index + distance) % nLeaders], sendToken}},
+                                           {{leaders[(index + nLeaders - distance) % nLeaders], recvToken()}},
+                                           {}});
+                }
+
+                phases.push_back(release);
+            }
+
+            return asyncPhases(context, std::move(phases), tokens);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv>
+        auto Base<T_CommunicationPolicy>::asyncGather(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData)
+            -> Event {
+            size_t const nElements = sendData.size();
+            std::vector<Phase> phases(1);
+
+            // The blocks go directly to the root, which receives them in place
+            if(rootVAddr == context.getVAddr()){
+                std::copy(sendData.begin(), sendData.end(), recvData.begin() + context.getVAddr() * nElements);
+                for(auto const &vAddr : context){
+                    if(vAddr != rootVAddr){
+                        phases[0].recvs.push_back({vAddr, bytesOf(recvData.data() + vAddr * nElements, nElements)});
+                    }
+
+                }
+
+            }
+            else {
+                phases[0].sends.push_back({rootVAddr, bytesOf(sendData.data(), nElements)});
+            }
+
+            return asyncPhases(context, std::move(phases), nullptr);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv>
+        auto Base<T_CommunicationPolicy>::asyncAllGather(const Context context, const T_Send& sendData, T_Recv& recvData)
+            -> Event {
+            size_t const nElements = sendData.size();
+            size_t const nPeers    = context.size();
+            size_t const index     = context.getVAddr();
+            auto const blockOf = [&recvData, nElements](size_t const block_i){
+                return bytesOf(recvData.data() + block_i * nElements, nElements);
+            };
+
+            std::copy(sendData.begin(), sendData.end(), recvData.begin() + index * nElements);
+
+            // Ring, each block is passed on to the next peer in place
+            std::vector<Phase> phases;
+            for(size_t step = 0; step + 1 < nPeers; ++step){
+                phases.push_back(Phase{{{(index + 1) % nPeers, blockOf((index + nPeers - step) % nPeers)}},
+                                       {{(index + nPeers - 1) % nPeers, blockOf((index + 2 * nPeers - step - 1) % nPeers)}},
+                                       {}});
+            }
+
+            return asyncPhases(context, std::move(phases), nullptr);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv>
+        auto Base<T_CommunicationPolicy>::asyncScatter(const VAddr rootVAddr, const Context context, const T_Send& sendData, T_Recv& recvData)
+            -> Event {
+            size_t const nElements = recvData.size();
+            std::vector<Phase> phases(1);
+
+            if(rootVAddr == context.getVAddr()){
+                auto const ownBlock = sendData.begin() + context.getVAddr() * nElements;
+                std::copy(ownBlock, ownBlock + nElements, recvData.begin());
+                for(auto const &vAddr : context){
+                    if(vAddr != rootVAddr){
+                        phases[0].sends.push_back({vAddr, bytesOf(sendData.data() + vAddr * nElements, nElements)});
+                    }
+
+                }
+
+            }
+            else {
+                phases[0].recvs.push_back({rootVAddr, bytesOf(recvData.data(), nElements)});
+            }
+
+            return asyncPhases(context, std::move(phases), nullptr);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv, typename T_Op>
+        auto Base<T_CommunicationPolicy>::asyncReduce(const VAddr rootVAddr, const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData)
+            -> Event {
+            using CommunicationPolicy = T_CommunicationPolicy;
+            using Value               = typename std::remove_const<typename T_Recv::value_type>::type;
+
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Group const group   = chainOf(nodes, rootVAddr);
+            auto buffers        = std::make_shared<std::vector<std::vector<Value> > >(1, std::vector<Value>(sendData.begin(), sendData.end()));
+
+            std::vector<Phase> phases;
+            reducePhases(group, indexOf(group, context.getVAddr()), op, buffers, recvData.data(), phases);
+
+            return asyncPhases(context, std::move(phases), buffers);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Send, typename T_Recv, typename T_Op>
+        auto Base<T_CommunicationPolicy>::asyncAllReduce(const Context context, const T_Op op, const T_Send& sendData, T_Recv& recvData)
+            -> Event {
+            using CommunicationPolicy = T_CommunicationPolicy;
+            using Value               = typename std::remove_const<typename T_Recv::value_type>::type;
+
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Group const group   = chainOf(nodes, nodes.front().front());
+            size_t const index  = indexOf(group, context.getVAddr());
+            auto buffers        = std::make_shared<std::vector<std::vector<Value> > >(1, std::vector<Value>(sendData.begin(), sendData.end()));
+
+            // Reduce to the first peer of the group and broadcast the result,
+            // the other peers receive it apart from the data they sent up
+            std::vector<Phase> phases;
+            reducePhases(group, index, op, buffers, static_cast<Value*>(nullptr), phases);
+            if(index != 0){
+                buffers->emplace_back(buffers->front().size());
+            }
+            Value * const reduced = (index == 0 ? buffers->front() : buffers->back()).data();
+            broadcastPhases(group, index, bytesOf(reduced, buffers->front().size()), phases);
+
+            // Fold into the received data like the blocking allReduce
+            Value * const result = recvData.data();
+            size_t const nElements = recvData.size();
+            phases.push_back(Phase{{}, {}, [op, reduced, result, nElements](){
+                        utils::reduceElements(op, result, reduced, result, nElements);
+                    }});
+
+            return asyncPhases(context, std::move(phases), buffers);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_SendRecv>
+        auto Base<T_CommunicationPolicy>::asyncBroadcast(const VAddr rootVAddr, const Context context, T_SendRecv& data)
+            -> Event {
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            auto const &nodes   = static_cast<CommunicationPolicy*>(this)->nodesOf(context);
+            Group const group   = chainOf(nodes, rootVAddr);
+
+            std::vector<Phase> phases;
+            broadcastPhases(group, indexOf(group, context.getVAddr()), bytesOf(data.data(), data.size()), phases);
+
+            return asyncPhases(context, std::move(phases), nullptr);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::asyncPhases(const Context context, std::vector<Phase> phases, std::shared_ptr<void> buffers)
+            -> Event {
+            using CommunicationPolicy = T_CommunicationPolicy;
+
+            struct State {
+                std::vector<Phase> phases;
+                std::shared_ptr<void> buffers;
+                size_t             phase  = 0;
+                bool               posted = false;
+                std::vector<Event> sends;
+                std::vector<Event> recvs;
+            };
+
+            CommunicationPolicy &cp = *static_cast<CommunicationPolicy*>(this);
+            auto state = std::make_shared<State>();
+            state->phases  = std::move(phases);
+            state->buffers = std::move(buffers);
+
+            // Keeps the pending events only, since events of some
+            // policies can not be tested again once they finished
+            auto const finished = [](std::vector<Event> &events, bool const block){
+                size_t nPending = 0;
+                for(Event &event : events){
+                    if(block){
+                        event.wait();
+                    }
+                    else if(!event.ready()){
+                        events[nPending++] = event;
+                    }
+
+                }
+                events.erase(events.begin() + nPending, events.end());
+                return nPending == 0;
+            };
+
+            return Event(std::make_shared<Operation>([&cp, context, state, finished](bool const block){
+                while(state->phase < state->phases.size()){
+                    Phase &phase = state->phases[state->phase];
+                    if(!state->posted){
+                        for(auto const &send : phase.sends){
+                            state->sends.push_back(cp.asyncSend(send.first, 0, context, send.second));
+                        }
+                        for(auto &recv : phase.recvs){
+                            state->recvs.push_back(cp.asyncRecv(recv.first, 0, context, recv.second));
+                        }
+                        state->posted = true;
+                    }
+
+                    if(!finished(state->recvs, block)){
+                        return false;
+                    }
+                    if(phase.then){
+                        phase.then();
+                    }
+                    state->recvs.clear();
+                    state->posted = false;
+                    ++state->phase;
+                }
+                return finished(state->sends, block);
+
+            }));
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        auto Base<T_CommunicationPolicy>::bytesOf(T_Value const * data, const size_t nElements)
+            -> Slice<char> {
+            return Slice<char>{const_cast<char*>(reinterpret_cast<char const*>(data)), nElements * sizeof(T_Value)};
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::childrenOf(Group const & group, const size_t index)
+            -> Group {
+            // The subtree of a peer spans the indices up to its lowest set bit
+            size_t const nPeers = group.size();
+            size_t limit = index & (~index + 1);
+            if(index == 0){
+                for(limit = 1; limit < nPeers; limit *= 2);
+            }
+
+            Group children;
+            for(size_t mask = limit / 2; mask > 0; mask /= 2){
+                if(index + mask < nPeers){
+                    children.push_back(group[index + mask]);
+                }
+
+            }
+            return children;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::parentOf(Group const & group, const size_t index)
+            -> VAddr {
+            return group[index & (index - 1)];
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        void Base<T_CommunicationPolicy>::broadcastPhases(Group const & group, const size_t index, const Slice<char> data, std::vector<Phase>& phases){
+            if(index != 0){
+                phases.push_back(Phase{{}, {{parentOf(group, index), data}}, {}});
+            }
+
+            Phase down;
+            for(VAddr const child : childrenOf(group, index)){
+                down.sends.push_back({child, data});
+            }
+            phases.push_back(down);
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value, typename T_Op>
+        void Base<T_CommunicationPolicy>::reducePhases(Group const & group, const size_t index, const T_Op op, std::shared_ptr<std::vector<std::vector<T_Value> > > buffers, T_Value * result, std::vector<Phase>& phases){
+            // The first buffer accumulates, the others receive from the children
+            Group const children = childrenOf(group, index);
+            buffers->resize(1 + children.size(), std::vector<T_Value>(buffers->front().size()));
+            std::vector<T_Value> &data = buffers->front();
+
+            Phase up;
+            for(size_t child_i = 0; child_i < children.size(); ++child_i){
+                std::vector<T_Value> &childData = (*buffers)[1 + child_i];
+                up.recvs.push_back({children[child_i], bytesOf(childData.data(), childData.size())});
+            }
+            std::vector<std::vector<T_Value> > *raw = buffers.get();
+            up.then = [raw, op](){
+                std::vector<T_Value> &data = raw->front();
+                for(size_t buffer_i = 1; buffer_i < raw->size(); ++buffer_i){
+                    utils::reduceElements(op, data.data(), (*raw)[buffer_i].data(), data.data(), data.size());
+                }
+            };
+            phases.push_back(up);
+
+            if(index != 0){
+                phases.push_back(Phase{{{parentOf(group, index), bytesOf(data.data(), data.size())}}, {}, {}});
+            }
+            else if(result != nullptr){
+                phases.push_back(Phase{{}, {}, [raw, op, result](){
+                            utils::reduceElements(op, result, raw->front().data(), result, raw->front().size());
+                        }});
+            }
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::nodesOf(const Context context)
+            -> std::vector<std::vector<VAddr> > {
+            std::vector<std::vector<VAddr> > nodes;
+            for(auto const &vAddr : context){
+                nodes.push_back(std::vector<VAddr>(1, vAddr));
+            }
+            return nodes;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::segmentSize(const Context)
+            -> size_t {
+            return defaultSegmentSize;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::indexOf(Group const & group, const VAddr vAddr)
+            -> size_t {
+            auto const it = std::find(group.begin(), group.end(), vAddr);
+            if(it == group.end()){
+                throw std::runtime_error("Peer " + std::to_string(vAddr) + " is not part of the group.");
+            }
+            return it - group.begin();
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::nodeIndexOf(std::vector<Node> const & nodes, const VAddr vAddr)
+            -> size_t {
+            for(size_t node_i = 0; node_i < nodes.size(); ++node_i){
+                if(std::find(nodes[node_i].begin(), nodes[node_i].end(), vAddr) != nodes[node_i].end()){
+                    return node_i;
+                }
+            }
+            throw std::runtime_error("Peer " + std::to_string(vAddr) + " is not part of the context.");
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::nodeOf(std::vector<Node> const & nodes, const VAddr vAddr)
+            -> Node const & {
+            return nodes[nodeIndexOf(nodes, vAddr)];
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::leaderOf(Node const & node, const VAddr rootVAddr)
+            -> VAddr {
+            if(std::find(node.begin(), node.end(), rootVAddr) != node.end()){
+                return rootVAddr;
+            }
+            return node.front();
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::leadersOf(std::vector<Node> const & nodes, const VAddr rootVAddr)
+            -> Group {
+            Group leaders;
+            leaders.reserve(nodes.size());
+            for(Node const &node : nodes){
+                leaders.push_back(leaderOf(node, rootVAddr));
+            }
+            return leaders;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        auto Base<T_CommunicationPolicy>::chainOf(std::vector<Node> const & nodes, const VAddr rootVAddr)
+            -> Group {
+            Group chain(1, rootVAddr);
+            Node const &rootNode = nodeOf(nodes, rootVAddr);
+            for(VAddr const vAddr : rootNode){
+                if(vAddr != rootVAddr){
+                    chain.push_back(vAddr);
+                }
+            }
+
+            for(Node const &node : nodes){
+                if(&node != &rootNode){
+                    chain.insert(chain.end(), node.begin(), node.end());
+                }
+            }
+            return chain;
+
+        }
+
+        template <typename T_CommunicationPolicy>
+        template <typename T_Value>
+        void Base<T_CommunicationPolicy>::pairwiseExchange(const Context context, T_Value const * sendData, std::vector<unsigned> const & sendCount, T_Value * recvData, std::vector<unsigned> const & recvCount){
+            using CommunicationPolicy = T_CommunicationPolicy;
+            using Value               = typename std::remove_const<T_Value>::type;
+
+            size_t const nPeers = context.size();
+            size_t const vAddr  = context.getVAddr();
+
+            std::vector<size_t> sendOffsets(nPeers, 0);
+            std::vector<size_t> recvOffsets(nPeers, 0);
+            std::partial_sum(sendCount.begin(), sendCount.end() - 1, sendOffsets.begin() + 1);
+            std::partial_sum(recvCount.begin(), recvCount.end() - 1, recvOffsets.begin() + 1);
+
+            std::copy(sendData + sendOffsets[vAddr], sendData + sendOffsets[vAddr] + sendCount[vAddr], recvData + recvOffsets[vAddr]);
+
+            // Each step waits for the transfers of the step the window
+            // size before it, thus the number of pending transfers and
+            // their buffers in the policy stay bounded
+            std::vector<std::vector<Event> > events(nPeers);
+            for(size_t step = 1; step < nPeers; ++step){
+                if(step > exchangeWindow){
+                    for(Event &event : events[step - exchangeWindow]){
+                        event.wait();
+                    }
+                }
+
+                VAddr const destVAddr = (vAddr + step) % nPeers;
+                VAddr const srcVAddr  = (vAddr + nPeers - step) % nPeers;
+
+                if(sendCount[destVAddr]){
+                    Slice<Value> const block{const_cast<Value*>(sendData) + sendOffsets[destVAddr], sendCount[destVAddr]};
+                    events[step].push_back(static_cast<CommunicationPolicy*>(this)->asyncSend(destVAddr, 0, context, block));
+                }
+                if(recvCount[srcVAddr]){
+                    Slice<Value> block{recvData + recvOffsets[srcVAddr], recvCount[srcVAddr]};
+                    events[step].push_back(static_cast<CommunicationPolicy*>(this)->asyncRecv(srcVAddr, 0, context, block));
+                }
+
+            }
+
+            for(size_t step = nPeers > exchangeWindow ? nPeers - exchangeWindow : 1; step < nPeers; ++step){
+                for(Event &event : events[step]){
+                    event.wait();
+                }
             }
 
         }
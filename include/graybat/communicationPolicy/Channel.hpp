@@ -0,0 +1,151 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <vector> /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        /**
+         * @brief Persistent send of a buffer to one peer.
+         *
+         * The peer, tag and context are bound once, each start() sends
+         * the current content of the buffer with asyncSend. The buffer
+         * needs to keep its address and size while the channel is used
+         * and must not be changed from start() until wait() returned.
+         *
+         */
+        template <typename T_CommunicationPolicy, typename T_Buffer>
+        struct SendChannel {
+
+            using CommunicationPolicy = T_CommunicationPolicy;
+            using VAddr               = typename graybat::communicationPolicy::VAddr<CommunicationPolicy>;
+            using Tag                 = typename graybat::communicationPolicy::Tag<CommunicationPolicy>;
+            using Context             = typename graybat::communicationPolicy::Context<CommunicationPolicy>;
+            using Event               = typename graybat::communicationPolicy::Event<CommunicationPolicy>;
+
+            SendChannel(CommunicationPolicy & comm, VAddr const destVAddr, Tag const tag, Context const context, T_Buffer const & buffer) :
+                comm(&comm),
+                destVAddr(destVAddr),
+                tag(tag),
+                context(context),
+                buffer(&buffer){
+
+            }
+
+            void start(){
+                events.clear();
+                events.push_back(comm->asyncSend(destVAddr, tag, context, *buffer));
+            }
+
+            void wait(){
+                for(Event &event : events){
+                    event.wait();
+                }
+                events.clear();
+            }
+
+            bool ready(){
+                for(Event &event : events){
+                    if(!event.ready()){
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            CommunicationPolicy * comm;
+            VAddr destVAddr;
+            Tag tag;
+            Context context;
+            T_Buffer const * buffer;
+
+            // The started send, keeps its memory from start to start
+            std::vector<Event> events;
+
+        };
+
+        /**
+         * @brief Persistent receive into a buffer from one peer, the
+         *        counterpart of SendChannel.
+         *
+         */
+        template <typename T_CommunicationPolicy, typename T_Buffer>
+        struct RecvChannel {
+
+            using CommunicationPolicy = T_CommunicationPolicy;
+            using VAddr               = typename graybat::communicationPolicy::VAddr<CommunicationPolicy>;
+            using Tag                 = typename graybat::communicationPolicy::Tag<CommunicationPolicy>;
+            using Context             = typename graybat::communicationPolicy::Context<CommunicationPolicy>;
+            using Event               = typename graybat::communicationPolicy::Event<CommunicationPolicy>;
+
+            RecvChannel(CommunicationPolicy & comm, VAddr const srcVAddr, Tag const tag, Context const context, T_Buffer & buffer) :
+                comm(&comm),
+                srcVAddr(srcVAddr),
+                tag(tag),
+                context(context),
+                buffer(&buffer){
+
+            }
+
+            void start(){
+                events.clear();
+                events.push_back(comm->asyncRecv(srcVAddr, tag, context, *buffer));
+            }
+
+            void wait(){
+                for(Event &event : events){
+                    event.wait();
+                }
+                events.clear();
+            }
+
+            bool ready(){
+                for(Event &event : events){
+                    if(!event.ready()){
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            CommunicationPolicy * comm;
+            VAddr srcVAddr;
+            Tag tag;
+            Context context;
+            T_Buffer * buffer;
+
+            // The started receive, keeps its memory from start to start
+            std::vector<Event> events;
+
+        };
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,474 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// CLIB
+#include <unistd.h> /* gethostname */
+
+// STL
+#include <algorithm> /* std::max, std::min, std::find, std::count */
+#include <array>     /* std::array */
+#include <chrono>    /* std::chrono::microseconds */
+#include <cstddef>   /* std::size_t */
+#include <memory>    /* std::unique_ptr */
+#include <numeric>   /* std::iota */
+#include <string>    /* std::string */
+#include <thread>    /* std::this_thread::yield, std::this_thread::sleep_for */
+#include <utility>   /* std::move */
+#include <vector>    /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Base.hpp>           /* Base */
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/RecvView.hpp>       /* RecvView */
+#include <graybat/communicationPolicy/SHM.hpp>            /* SHM */
+#include <graybat/communicationPolicy/hybrid/Context.hpp> /* Context */
+#include <graybat/communicationPolicy/hybrid/Event.hpp>   /* Event, RecvStorage */
+#include <graybat/communicationPolicy/hybrid/Config.hpp>  /* Config */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+	/************************************************************************//**
+	 * @class Hybrid
+	 *
+	 * @brief Implementation of the Cage communicationPolicy interface
+	 *        for peers on several nodes.
+	 *
+	 * Peers on the same node communicate over shared memory (SHM),
+	 * peers on different nodes over the policy *T_Remote* (e.g. ZMQ
+	 * or BMPI). The peers of a node are found by their node name on
+	 * construction. Contexts and vAddrs are the ones of *T_Remote*,
+	 * every context knows the nodes of its peers, thus the
+	 * collectives of Base send one message per node between nodes.
+	 *
+	 * Like SHM, the policy must only be used by one thread.
+	 *
+	 ***************************************************************************/
+        template <typename T_Remote>
+        struct Hybrid;
+
+        namespace traits {
+
+            template <typename T_Remote>
+            struct ContextType<Hybrid<T_Remote> > {
+                using type = graybat::communicationPolicy::hybrid::Context<T_Remote>;
+            };
+
+            template <typename T_Remote>
+            struct ContextIDType<Hybrid<T_Remote> > {
+                using type = unsigned;
+            };
+
+            template <typename T_Remote>
+            struct EventType<Hybrid<T_Remote> > {
+                using type = graybat::communicationPolicy::hybrid::Event<T_Remote>;
+            };
+
+            template <typename T_Remote>
+            struct ConfigType<Hybrid<T_Remote> > {
+                using type = graybat::communicationPolicy::hybrid::Config<T_Remote>;
+            };
+
+        }
+
+        template <typename T_Remote>
+	struct Hybrid : Base<Hybrid<T_Remote> > {
+
+	    // Type defs
+            using Tag           = graybat::communicationPolicy::Tag<Hybrid>;
+            using ContextID     = graybat::communicationPolicy::ContextID<Hybrid>;
+            using VAddr         = graybat::communicationPolicy::VAddr<Hybrid>;
+            using Context       = graybat::communicationPolicy::Context<Hybrid>;
+            using Event         = graybat::communicationPolicy::Event<Hybrid>;
+            using Config        = graybat::communicationPolicy::Config<Hybrid>;
+            using RemoteContext = graybat::communicationPolicy::Context<T_Remote>;
+            using RemoteEvent   = graybat::communicationPolicy::Event<T_Remote>;
+            using LocalContext  = graybat::communicationPolicy::Context<SHM>;
+
+            template <typename T>
+            using RecvView  = graybat::communicationPolicy::RecvView<T, hybrid::RecvStorage<T, T_Remote> >;
+
+	    Hybrid(Config const config) :
+                remote(config.remote),
+                contextCount(0),
+                spinCount(config.local.spinCount),
+                maxPollInterval(config.maxPollInterval){
+
+                RemoteContext const remoteContext = remote.getGlobalContext();
+                globalVAddr = remoteContext.getVAddr();
+
+                // Peers with the same node name are numbered by their
+                // first appearance
+                std::array<char, nodeNameSize> nodeName {{ 0 }};
+                std::string const name = config.nodeName.empty() ? hostName() : config.nodeName;
+                name.copy(nodeName.data(), nodeNameSize - 1);
+
+                std::vector<char> nodeNames(remoteContext.size() * nodeNameSize);
+                remote.allGather(remoteContext, nodeName, nodeNames);
+
+                std::vector<std::string> nodeNameOf;
+                for(std::size_t vAddr = 0; vAddr < remoteContext.size(); ++vAddr){
+                    std::string const otherName(nodeNames.data() + vAddr * nodeNameSize);
+                    auto const it = std::find(nodeNameOf.begin(), nodeNameOf.end(), otherName);
+                    nodeOfGlobal.push_back(it - nodeNameOf.begin());
+                    if(it == nodeNameOf.end()){
+                        nodeNameOf.push_back(otherName);
+                    }
+                }
+                myNode = nodeOfGlobal[globalVAddr];
+
+                // Shared memory of the node
+                shm::Config localConfig = config.local;
+                localConfig.contextSize = std::count(nodeOfGlobal.begin(), nodeOfGlobal.end(), myNode);
+                localConfig.contextName += "_" + name;
+                local.reset(new SHM(localConfig));
+
+                std::array<VAddr, 1> localVAddr {{ local->getGlobalContext().getVAddr() }};
+                localOfGlobal.resize(remoteContext.size());
+                remote.allGather(remoteContext, localVAddr, localOfGlobal);
+
+                std::vector<VAddr> globalOf(remoteContext.size());
+                std::iota(globalOf.begin(), globalOf.end(), 0);
+                initialContext = makeContext(0, remoteContext, globalOf);
+
+            }
+
+            // Copy constructor
+            Hybrid(Hybrid &) = delete;
+            // Copy assignment constructor
+            Hybrid& operator=(Hybrid &) = delete;
+            // Move constructor
+            Hybrid(Hybrid &&) = delete;
+            // Move assignment constructor
+            Hybrid& operator=(Hybrid &&) = delete;
+            // Destructor
+            ~Hybrid(){}
+
+	    /***********************************************************************//**
+             *
+	     * @name Point to Point Communication Interface
+	     *
+	     * @{
+	     *
+	     ***************************************************************************/
+	    /**
+	     * @brief Blocking transmission of a message sendData to peer with virtual address destVAddr.
+	     *
+	     * @param[in] destVAddr  VAddr of peer that will receive the message
+	     * @param[in] tag        Description of the message to better distinguish messages types
+	     * @param[in] context    Context in which both sender and receiver are included
+	     * @param[in] sendData   Data reference of template type T will be send to receiver peer.
+	     *                       T need to provide the function data(), that returns the pointer
+	     *                       to the data memory address. And the function size(), that
+	     *                       return the amount of data elements to send. Notice, that
+	     *                       std::vector and std::array implement this interface.
+	     */
+            template <typename T_Send>
+            void send(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+                if(isLocal(context, destVAddr)){
+                    local->send(localOf(context, destVAddr), tag, context.getLocal(), sendData);
+                }
+                else {
+                    remote.send(destVAddr, tag, context.getRemote(), sendData);
+                }
+
+            }
+
+            /**
+	     * @brief Non blocking transmission of a message sendData to peer with virtual address destVAddr.
+	     *
+	     * @param[in] destVAddr  VAddr of peer that will receive the message
+	     * @param[in] tag        Description of the message to better distinguish messages types
+	     * @param[in] context    Context in which both sender and receiver are included
+	     * @param[in] sendData   Data reference of template type T will be.
+	     *                       T need to provide the function data(), that returns the pointer
+	     *                       to the data memory address. And the function size(), that
+	     *                       return the amount of data elements to send. Notice, that
+	     *                       std::vector and std::array implement this interface.
+	     *
+	     * @return Event
+	     */
+            template <typename T_Send>
+            Event asyncSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+                if(isLocal(context, destVAddr)){
+                    return Event(local->asyncSend(localOf(context, destVAddr), tag, context.getLocal(), sendData), destVAddr, tag);
+                }
+                return Event(remote.asyncSend(destVAddr, tag, context.getRemote(), sendData), destVAddr, tag);
+
+            }
+
+	    /**
+	     * @brief Blocking receive of a message recvData from peer with virtual address srcVAddr.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     * @param[out] recvData   Data reference of template type T will be received from sender peer.
+	     *                        T need to provide the function data(), that returns the pointer
+	     *                        to the data memory address. And the function size(), that
+	     *                        return the amount of data elements to send. Notice, that
+	     *                        std::vector and std::array implement this interface.
+	     */
+            template <typename T_Recv>
+            void recv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+                if(isLocal(context, srcVAddr)){
+                    local->recv(localOf(context, srcVAddr), tag, context.getLocal(), recvData);
+                }
+                else {
+                    remote.recv(srcVAddr, tag, context.getRemote(), recvData);
+                }
+
+            }
+
+	    /**
+	     * @brief Blocking receive of a message from peer with virtual address srcVAddr,
+	     *        whose payload is accessed in place.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     *
+	     * @return View on the payload, that owns the received message
+	     */
+            template <typename T>
+            RecvView<T> recv(const VAddr srcVAddr, const Tag tag, const Context context){
+                using Storage = hybrid::RecvStorage<T, T_Remote>;
+                if(isLocal(context, srcVAddr)){
+                    return RecvView<T>(Storage(local->template recv<T>(localOf(context, srcVAddr), tag, context.getLocal())));
+                }
+                return RecvView<T>(Storage(remote.template recv<T>(srcVAddr, tag, context.getRemote())));
+
+            }
+
+	    /**
+	     * @brief Blocking receive of a message of any peer with any tag of the *context*.
+	     *
+	     * Messages of peers on other nodes are polled alternately with
+	     * the shared memory, unless all peers of the context are on
+	     * this node. After spinCount empty polls, the sleep between
+	     * two polls doubles up to maxPollInterval.
+	     *
+	     * @return Event, that knows the source and the tag of the message
+	     */
+            template <typename T_Recv>
+            Event recv(const Context context, T_Recv& recvData){
+                if(context.getNodes().size() == 1){
+                    auto event = local->recv(context.getLocal(), recvData);
+                    return Event(context.contextOf(event.source()), event.getTag());
+                }
+
+                VAddr srcVAddr = 0;
+                Tag tag = 0;
+                std::chrono::microseconds interval(1);
+                for(std::size_t poll_i = 0; ; ++poll_i){
+                    if(local->tryRecv(context.getLocal(), recvData, srcVAddr, tag)){
+                        return Event(context.contextOf(srcVAddr), tag);
+                    }
+                    if(remote.tryRecv(context.getRemote(), recvData, srcVAddr, tag)){
+                        return Event(srcVAddr, tag);
+                    }
+
+                    // Neither policy can wait for both, thus back off
+                    if(poll_i < spinCount){
+                        std::this_thread::yield();
+                    }
+                    else {
+                        std::this_thread::sleep_for(interval);
+                        interval = std::min(2 * interval, maxPollInterval);
+                    }
+                }
+
+            }
+
+	    /**
+	     * @brief Non blocking receive of a message recvData from peer with virtual address srcVAddr.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     * @param[out] recvData   Data reference of template type T will be received from sender peer.
+	     *                        T need to provide the function data(), that returns the pointer
+	     *                        to the data memory address. And the function size(), that
+	     *                        return the amount of data elements to send. Notice, that
+	     *                        std::vector and std::array implement this interface.
+	     *
+	     * @return Event
+	     *
+	     */
+            template <typename T_Recv>
+            Event asyncRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+                if(isLocal(context, srcVAddr)){
+                    return Event(local->asyncRecv(localOf(context, srcVAddr), tag, context.getLocal(), recvData), srcVAddr, tag);
+                }
+                return Event(remote.asyncRecv(srcVAddr, tag, context.getRemote(), recvData), srcVAddr, tag);
+
+            }
+	    /** @} */
+
+	    /***********************************************************************//**
+             *
+	     * @name Context Interface
+	     *
+	     * @{
+	     *
+	     ***************************************************************************/
+	    /**
+	     * @brief Returns a subcontext of *oldContext* with all peers that want to participate.
+             *        Peers which do not want to participate retrieve an invalid context.
+             *
+             * The members exchange their global vAddrs and the number of
+             * contexts they are part of. The new context id is larger than
+             * the ids of all contexts of its members, thus the shared
+             * memory messages of contexts with common peers never match.
+	     */
+            Context splitContext(const bool isMember, const Context oldContext){
+                RemoteContext const remoteContext = remote.splitContext(isMember, oldContext.getRemote());
+
+                if(!isMember){
+                    // Invalid context for "not members"
+                    return Context();
+                }
+
+                std::array<unsigned, 2> mine {{ globalVAddr, contextCount }};
+                std::vector<RemoteEvent> events;
+                for(auto const &vAddr : remoteContext){
+                    if(vAddr != remoteContext.getVAddr()){
+                        events.push_back(remote.asyncSend(vAddr, 0, remoteContext, mine));
+                    }
+                }
+
+                std::vector<VAddr> globalOf(nodeOfGlobal.size(), 0);
+                ContextID maxContextID = contextCount;
+                for(auto const &vAddr : remoteContext){
+                    if(vAddr == remoteContext.getVAddr()){
+                        globalOf[vAddr] = globalVAddr;
+                        continue;
+                    }
+                    std::array<unsigned, 2> other {{ 0, 0 }};
+                    remote.recv(vAddr, 0, remoteContext, other);
+                    globalOf[vAddr] = other[0];
+                    maxContextID = std::max(maxContextID, other[1]);
+                }
+
+                for(auto &event : events){
+                    event.wait();
+                }
+
+                contextCount = maxContextID + 1;
+                return makeContext(contextCount, remoteContext, globalOf);
+
+            }
+
+	    /**
+	     * @brief Returns the context that contains all peers
+	     */
+            Context getGlobalContext(){
+                return initialContext;
+            }
+	    /** @} */
+
+	    /**
+	     * @brief Returns the vAddrs of the *context* grouped by node, the
+	     *        collectives of Base exchange one message per node
+	     *        between nodes.
+	     */
+            std::vector<std::vector<VAddr> > const & nodesOf(const Context context){
+                return context.getNodes();
+            }
+
+	    /**
+	     * @brief Returns the segment size of the remote policy, since
+	     *        pipelining pays off between nodes.
+	     */
+            size_t segmentSize(const Context context){
+                return remote.segmentSize(context.getRemote());
+            }
+
+        private:
+            static constexpr std::size_t nodeNameSize = 64;
+
+            T_Remote             remote;
+            std::unique_ptr<SHM> local;
+            VAddr                globalVAddr;
+            unsigned             myNode;
+            ContextID            contextCount;
+            std::size_t const    spinCount;
+            std::chrono::microseconds const maxPollInterval;
+            // Node and shared memory vAddr of each global vAddr
+            std::vector<unsigned> nodeOfGlobal;
+            std::vector<VAddr>    localOfGlobal;
+            Context               initialContext;
+
+            bool isLocal(Context const & context, VAddr const vAddr) const {
+                return nodeOfGlobal[context.globalOf(vAddr)] == myNode;
+            }
+
+            VAddr localOf(Context const & context, VAddr const vAddr) const {
+                return context.localOf(vAddr);
+            }
+
+            Context makeContext(ContextID const contextID, RemoteContext const & remoteContext, std::vector<VAddr> const & globalOf){
+                std::vector<std::vector<VAddr> > nodes;
+                std::vector<unsigned> nodeIndices;
+                std::vector<VAddr> localPeers;
+                std::vector<VAddr> contextOfLocal;
+                std::vector<VAddr> localOfContext(remoteContext.size(), 0);
+                VAddr ownLocalVAddr = 0;
+
+                for(auto const &vAddr : remoteContext){
+                    unsigned const node = nodeOfGlobal[globalOf[vAddr]];
+                    std::size_t const node_i = std::find(nodeIndices.begin(), nodeIndices.end(), node) - nodeIndices.begin();
+                    if(node_i == nodeIndices.size()){
+                        nodeIndices.push_back(node);
+                        nodes.push_back(std::vector<VAddr>());
+                    }
+                    nodes[node_i].push_back(vAddr);
+
+                    // The peers of the node are numbered in the local
+                    // context in the order of their vAddrs
+                    if(node == myNode){
+                        if(vAddr == remoteContext.getVAddr()){
+                            ownLocalVAddr = localPeers.size();
+                        }
+                        localOfContext[vAddr] = localPeers.size();
+                        localPeers.push_back(localOfGlobal[globalOf[vAddr]]);
+                        contextOfLocal.push_back(vAddr);
+                    }
+                }
+
+                LocalContext const localContext(contextID, ownLocalVAddr, localPeers);
+                return Context(contextID, remoteContext, localContext, globalOf, std::move(localOfContext), std::move(contextOfLocal), std::move(nodes));
+
+            }
+
+            static std::string hostName(){
+                std::array<char, nodeNameSize> name {{ 0 }};
+                gethostname(name.data(), nodeNameSize - 1);
+                return std::string(name.data());
+            }
+
+        };
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <functional> /* std::function */
+#include <utility>    /* std::move */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        /**
+         * @brief Non-blocking operation, that consists of several
+         *        steps of point to point communication.
+         *
+         * The operation has no thread of its own, it is advanced
+         * whenever the event that refers to it is asked whether it
+         * is ready or waited for. Events of all policies can refer to
+         * an operation, thus collectives return the event type of
+         * their policy.
+         *
+         */
+        struct Operation {
+
+            // Takes as many steps as possible without waiting, or all
+            // remaining steps if *block* is set. Returns whether the
+            // operation has finished, always true if *block* is set
+            using Step = std::function<bool(bool const block)>;
+
+            Operation(Step step) :
+                step(std::move(step)),
+                done(false){
+
+            }
+
+            void wait(){
+                if(!done){
+                    done = step(true);
+                }
+
+            }
+
+            bool ready(){
+                if(!done){
+                    done = step(false);
+                }
+                return done;
+
+            }
+
+        private:
+            Step step;
+            bool done;
+
+        };
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
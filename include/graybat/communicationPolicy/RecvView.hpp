@@ -0,0 +1,131 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+// STL
+#include <cstddef>     /* std::size_t */
+#include <cstdint>     /* std::int8_t, std::uintptr_t */
+#include <cstring>     /* std::memcpy */
+#include <utility>     /* std::move */
+#include <vector>      /* std::vector */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        /**
+         * @brief Read-only view on the payload of a received message,
+         *        which owns the storage the message was received into.
+         *
+         * The payload is consumed in place, thus there is no copy into
+         * a user buffer. *T_Storage* needs to provide getData(), that
+         * returns a pointer to the payload, and getDataSize(), that
+         * returns the size of the payload in bytes. The payload is
+         * accessed through the storage on each call, since moving the
+         * storage may move small payloads.
+         *
+         * Transports do not guarantee, that the payload is aligned for
+         * T_Value, e.g. frames of ZMQ. A misaligned payload is copied
+         * into aligned storage of the view on first access.
+         *
+         */
+        template <typename T_Value, typename T_Storage>
+        class RecvView {
+        public:
+            using value_type     = T_Value;
+            using size_type      = std::size_t;
+            using const_iterator = T_Value const *;
+
+            RecvView(T_Storage &&storage) :
+                storage(std::move(storage)){
+
+            }
+
+            T_Value const * data() const {
+                std::int8_t const * const payload = storage.getData();
+                if(reinterpret_cast<std::uintptr_t>(payload) % alignof(T_Value) == 0){
+                    return reinterpret_cast<T_Value const *>(payload);
+                }
+
+                if(aligned.size() != size()){
+                    aligned.resize(size());
+                    std::memcpy(aligned.data(), payload, size() * sizeof(T_Value));
+                }
+                return aligned.data();
+            }
+
+            std::size_t size() const {
+                return storage.getDataSize() / sizeof(T_Value);
+            }
+
+            bool empty() const {
+                return size() == 0;
+            }
+
+            T_Value const & operator[](std::size_t const i) const {
+                return data()[i];
+            }
+
+            const_iterator begin() const {
+                return data();
+            }
+
+            const_iterator end() const {
+                return data() + size();
+            }
+
+        private:
+            T_Storage storage;
+
+            // Copy of a misaligned payload
+            mutable std::vector<T_Value> aligned;
+
+        };
+
+        /**
+         * @brief Storage of a RecvView, for policies that receive into
+         *        a buffer of the final size.
+         *
+         */
+        template <typename T_Value>
+        struct VectorStorage {
+
+            VectorStorage(std::vector<T_Value> &&values) :
+                values(std::move(values)){
+
+            }
+
+            std::int8_t const * getData() const {
+                return reinterpret_cast<std::int8_t const *>(values.data());
+            }
+
+            std::size_t getDataSize() const {
+                return values.size() * sizeof(T_Value);
+            }
+
+            std::vector<T_Value> values;
+
+        };
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,855 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// CLIB
+#include <fcntl.h>    /* O_CREAT, O_RDWR, O_RDONLY, O_TRUNC */
+#include <string.h>   /* memcpy */
+#include <sys/mman.h> /* shm_open, shm_unlink, mmap, munmap */
+#include <unistd.h>   /* ftruncate, close */
+
+// STL
+#include <algorithm>     /* std::min, std::find */
+#include <array>         /* std::array */
+#include <atomic>        /* std::atomic_thread_fence */
+#include <chrono>        /* std::chrono::microseconds */
+#include <cstddef>       /* std::size_t */
+#include <cstdint>       /* std::uint64_t */
+#include <deque>         /* std::deque */
+#include <limits>        /* std::numeric_limits */
+#include <stdexcept>     /* std::runtime_error */
+#include <string>        /* std::string, std::to_string */
+#include <unordered_map> /* std::unordered_map */
+#include <utility>       /* std::move */
+#include <vector>        /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Base.hpp>         /* Base */
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/RecvView.hpp>     /* RecvView */
+#include <graybat/communicationPolicy/shm/Message.hpp> /* Message */
+#include <graybat/communicationPolicy/shm/Segment.hpp> /* Segment, Ring, RecordHeader */
+#include <graybat/communicationPolicy/shm/Context.hpp> /* Context */
+#include <graybat/communicationPolicy/shm/Event.hpp>   /* Event */
+#include <graybat/communicationPolicy/shm/Config.hpp>  /* Config */
+#include <graybat/utils/StripedMessageBox.hpp>          /* utils::PackedKey, utils::PackedKeyHash */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+	/************************************************************************//**
+	 * @class SHM
+	 *
+	 * @brief Implementation of the Cage communicationPolicy interface
+	 *        for peers that are processes on the same node.
+	 *
+	 * The peers meet in a POSIX shared memory segment, that contains a
+	 * ring for every ordered pair of peers. Small payloads are copied
+	 * through the ring, large payloads are read by the receiver
+	 * directly from the memory of the sender (cross memory attach) or,
+	 * if this is not permitted, passed in a shared memory file of
+	 * their own. Waiting peers sleep on a futex in the segment.
+	 *
+	 * The policy must only be used by one thread. Sends of large
+	 * payloads are finished when the receiver has read them, thus
+	 * their events need to be waited for before the send data is
+	 * modified or the peer exits.
+	 *
+	 ***************************************************************************/
+        struct SHM;
+
+        namespace traits {
+
+            template<>
+            struct ContextType<SHM> {
+                using type = graybat::communicationPolicy::shm::Context<SHM>;
+            };
+
+            template<>
+            struct ContextIDType<SHM> {
+                using type = unsigned;
+            };
+
+            template<>
+            struct EventType<SHM> {
+                using type = graybat::communicationPolicy::shm::Event<SHM>;
+            };
+
+            template<>
+            struct ConfigType<SHM> {
+                using type = graybat::communicationPolicy::shm::Config;
+            };
+
+        }
+
+	struct SHM : Base<SHM> {
+
+	    // Type defs
+            using Tag       = graybat::communicationPolicy::Tag<SHM>;
+            using ContextID = graybat::communicationPolicy::ContextID<SHM>;
+            using MsgType   = graybat::communicationPolicy::MsgType<SHM>;
+            using VAddr     = graybat::communicationPolicy::VAddr<SHM>;
+            using Context   = graybat::communicationPolicy::Context<SHM>;
+            using Event     = graybat::communicationPolicy::Event<SHM>;
+            using Config    = graybat::communicationPolicy::Config<SHM>;
+            using Message   = graybat::communicationPolicy::shm::Message<SHM>;
+
+            template <typename T>
+            using RecvView  = graybat::communicationPolicy::RecvView<T, Message>;
+
+	    SHM(Config const config) :
+                segment(config.contextName, config.contextSize, config.ringSize),
+                inlineSize(std::min(config.singleCopySize, segment.ringSize / 4)),
+                spinCount(config.spinCount),
+                drainTimeout(config.drainTimeout),
+                initialContext(0, segment.vAddr, config.contextSize),
+                pullsIssued(config.contextSize, 0),
+                filesIssued(config.contextSize, 0){
+
+            }
+
+            // Copy constructor
+            SHM(SHM &) = delete;
+            // Copy assignment constructor
+            SHM& operator=(SHM &) = delete;
+            // Move constructor
+            SHM(SHM &&) = delete;
+            // Move assignment constructor
+            SHM& operator=(SHM &&) = delete;
+            // Destructor
+            ~SHM(){}
+
+	    /***********************************************************************//**
+             *
+	     * @name Point to Point Communication Interface
+	     *
+	     * @{
+	     *
+	     ***************************************************************************/
+	    /**
+	     * @brief Blocking transmission of a message sendData to peer with virtual address destVAddr.
+	     *
+	     * @param[in] destVAddr  VAddr of peer that will receive the message
+	     * @param[in] tag        Description of the message to better distinguish messages types
+	     * @param[in] context    Context in which both sender and receiver are included
+	     * @param[in] sendData   Data reference of template type T will be send to receiver peer.
+	     *                       T need to provide the function data(), that returns the pointer
+	     *                       to the data memory address. And the function size(), that
+	     *                       return the amount of data elements to send. Notice, that
+	     *                       std::vector and std::array implement this interface.
+	     */
+            template <typename T_Send>
+            void send(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+                waitPulled(context, destVAddr, sendImpl(MsgType::PEER, context, destVAddr, tag, sendData));
+            }
+
+            /**
+	     * @brief Non blocking transmission of a message sendData to peer with virtual address destVAddr.
+	     *        Large payloads are read by the receiver from sendData, thus sendData must
+	     *        not be modified until the event is finished.
+	     *
+	     * @param[in] destVAddr  VAddr of peer that will receive the message
+	     * @param[in] tag        Description of the message to better distinguish messages types
+	     * @param[in] context    Context in which both sender and receiver are included
+	     * @param[in] sendData   Data reference of template type T will be.
+	     *                       T need to provide the function data(), that returns the pointer
+	     *                       to the data memory address. And the function size(), that
+	     *                       return the amount of data elements to send. Notice, that
+	     *                       std::vector and std::array implement this interface.
+	     *
+	     * @return Event
+	     */
+            template <typename T_Send>
+            Event asyncSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+                std::uint64_t const pullSeq = sendImpl(MsgType::PEER, context, destVAddr, tag, sendData);
+                return Event(context, destVAddr, tag, pullSeq, *this);
+            }
+
+	    /**
+	     * @brief Blocking receive of a message recvData from peer with virtual address srcVAddr.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     * @param[out] recvData   Data reference of template type T will be received from sender peer.
+	     *                        T need to provide the function data(), that returns the pointer
+	     *                        to the data memory address. And the function size(), that
+	     *                        return the amount of data elements to send. Notice, that
+	     *                        std::vector and std::array implement this interface.
+	     */
+            template <typename T_Recv>
+            void recv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+                recvImpl(MsgType::PEER, context, srcVAddr, tag, recvData);
+            }
+
+	    /**
+	     * @brief Blocking receive of a message from peer with virtual address srcVAddr,
+	     *        whose payload is handed over without a further copy.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     *
+	     * @return Read-only view of the received elements of type T, that owns the message
+	     */
+            template <typename T>
+            RecvView<T> recv(const VAddr srcVAddr, const Tag tag, const Context context){
+                return RecvView<T>(recvImpl(MsgType::PEER, context, srcVAddr, tag));
+            }
+
+	    /**
+	     * @brief Blocking receive of a message of any peer with any tag of the *context*.
+	     *
+	     * @return Event, that knows the source and the tag of the message
+	     */
+            template <typename T_Recv>
+            Event recv(const Context context, T_Recv& recvData){
+                Message message;
+                waitUntil([&]{ return tryTakeAny(MsgType::PEER, context, message); });
+                copy(message, reinterpret_cast<std::int8_t*>(recvData.data()), sizeof(typename T_Recv::value_type) * recvData.size());
+                return Event(context, message.srcVAddr, message.tag, 0, *this);
+            }
+
+	    /**
+	     * @brief Non blocking receive of a message of any peer with any tag of the *context*.
+	     *
+	     * @return False, if no message has arrived. Otherwise the message is received into
+	     *         *recvData* and its source and tag are returned in *srcVAddr* and *tag*.
+	     */
+            template <typename T_Recv>
+            bool tryRecv(const Context context, T_Recv& recvData, VAddr& srcVAddr, Tag& tag){
+                Message message;
+                if(!tryTakeAny(MsgType::PEER, context, message)){
+                    return false;
+                }
+                copy(message, reinterpret_cast<std::int8_t*>(recvData.data()), sizeof(typename T_Recv::value_type) * recvData.size());
+                srcVAddr = message.srcVAddr;
+                tag = message.tag;
+                return true;
+
+            }
+
+	    /**
+	     * @brief Non blocking receive of a message recvData from peer with virtual address srcVAddr.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     * @param[out] recvData   Data reference of template type T will be received from sender peer.
+	     *                        T need to provide the function data(), that returns the pointer
+	     *                        to the data memory address. And the function size(), that
+	     *                        return the amount of data elements to send. Notice, that
+	     *                        std::vector and std::array implement this interface.
+	     *
+	     * @return Event
+	     *
+	     */
+            template <typename T_Recv>
+            Event asyncRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+                bool const done = asyncRecvImpl(MsgType::PEER, context, srcVAddr, tag,
+                                                reinterpret_cast<std::int8_t*>(recvData.data()),
+                                                sizeof(typename T_Recv::value_type) * recvData.size());
+                return Event(context, srcVAddr, tag, recvData, done, *this);
+            }
+	    /** @} */
+
+	    /***********************************************************************//**
+             *
+	     * @name Context Interface
+	     *
+	     * @{
+	     *
+	     ***************************************************************************/
+	    /**
+	     * @brief Returns a subcontext of *oldContext* with all peers that want to participate.
+             *        Peers which do not want to participate retrieve an invalid context.
+             *
+             * The members are numbered in the order of their vAddrs in
+             * *oldContext*. The new context maps their vAddrs back to the
+             * segment, which selects the rings.
+	     */
+            Context splitContext(const bool isMember, const Context oldContext){
+                VAddr const masterVAddr = 0;
+
+                // Request old master for new context
+                std::array<unsigned, 1> member {{ isMember }};
+                waitPulled(oldContext, masterVAddr, sendImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, member));
+
+                // Peer with VAddr 0 collects new members
+                if(oldContext.getVAddr() == masterVAddr){
+                    std::vector<VAddr> newContextWhiteList;
+                    for(auto const &vAddr : oldContext){
+                        std::array<unsigned, 1> remoteIsMember {{ 0 }};
+                        recvImpl(MsgType::SPLIT, oldContext, vAddr, 0, remoteIsMember);
+                        if(remoteIsMember[0]){
+                            newContextWhiteList.push_back(vAddr);
+                        }
+                    }
+
+                    std::vector<VAddr> segmentVAddrs;
+                    for(VAddr vAddr : newContextWhiteList){
+                        segmentVAddrs.push_back(oldContext.getSegmentVAddr(vAddr));
+                    }
+
+                    std::array<ContextID, 1> newContextID {{ ++segment.header().maxContextID }};
+                    std::array<unsigned, 1> newContextSize {{ static_cast<unsigned>(newContextWhiteList.size()) }};
+                    for(VAddr vAddr : newContextWhiteList){
+                        sendImpl(MsgType::SPLIT, oldContext, vAddr, 0, newContextID);
+                        sendImpl(MsgType::SPLIT, oldContext, vAddr, 0, newContextSize);
+                        waitPulled(oldContext, vAddr, sendImpl(MsgType::SPLIT, oldContext, vAddr, 0, segmentVAddrs));
+                    }
+
+                }
+
+                if(!isMember){
+                    // Invalid context for "not members"
+                    return Context();
+                }
+
+                std::array<ContextID, 1> newContextID {{ 0 }};
+                std::array<unsigned, 1> newContextSize {{ 0 }};
+                recvImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, newContextID);
+                recvImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, newContextSize);
+                std::vector<VAddr> segmentVAddrs(newContextSize[0], 0);
+                recvImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, segmentVAddrs);
+
+                VAddr const newVAddr = std::find(segmentVAddrs.begin(), segmentVAddrs.end(), me()) - segmentVAddrs.begin();
+                return Context(newContextID[0], newVAddr, segmentVAddrs);
+
+            }
+
+	    /**
+	     * @brief Returns the context that contains all peers
+	     */
+            Context getGlobalContext(){
+                return initialContext;
+            }
+	    /** @} */
+
+            // Auxilary
+            /**
+             * @brief Writes the message to the ring of *destVAddr*. Returns
+             *        the number of the pull, the receiver reads the payload
+             *        with, or 0 if the send is already finished.
+             *
+             */
+            template <typename T_Send>
+            std::uint64_t sendImpl(MsgType const msgType, Context const context, VAddr const destVAddr, Tag const tag, T_Send const & sendData){
+                std::size_t const size = sizeof(typename T_Send::value_type) * sendData.size();
+                void const * data = sendData.data();
+
+                VAddr const ringVAddr = context.getSegmentVAddr(destVAddr);
+
+                shm::RecordHeader header {size, 0, context.getID(), context.getVAddr(), tag, static_cast<std::int8_t>(msgType), shm::RecordKind::INLINE, 0};
+
+                if(size < inlineSize || size == 0){
+                    writeRecord(ringVAddr, header, data);
+                    return 0;
+                }
+
+                if(segment.canRead(ringVAddr, me())){
+                    header.kind = shm::RecordKind::PULL;
+                    header.address = reinterpret_cast<std::uint64_t>(data);
+                    writeRecord(ringVAddr, header, nullptr);
+                    return ++pullsIssued[ringVAddr];
+                }
+
+                header.kind = shm::RecordKind::FILE;
+                header.address = ++filesIssued[ringVAddr];
+                writeFile(fileName(me(), ringVAddr, header.address), data, size);
+                writeRecord(ringVAddr, header, nullptr);
+                return 0;
+
+            }
+
+            Message recvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag){
+                Message message;
+                waitUntil([&]{ return tryTake(msgType, context, srcVAddr, tag, message); }, context.getSegmentVAddr(srcVAddr));
+                return message;
+
+            }
+
+            template <typename T_Recv>
+            void recvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag, T_Recv & recvData){
+                recvImpl(msgType, context, srcVAddr, tag, reinterpret_cast<std::int8_t*>(recvData.data()), sizeof(typename T_Recv::value_type) * recvData.size());
+            }
+
+            void recvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag, std::int8_t * recvData, std::size_t const size){
+                waitUntil([&]{ return tryTake(msgType, context, srcVAddr, tag, recvData, size); }, context.getSegmentVAddr(srcVAddr));
+            }
+
+            bool asyncRecvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag, std::int8_t * recvData, std::size_t const size){
+                return tryTake(msgType, context, srcVAddr, tag, recvData, size);
+            }
+
+            bool pulled(Context const context, VAddr const destVAddr, std::uint64_t const pullSeq){
+                return segment.ring(me(), context.getSegmentVAddr(destVAddr)).control.pulled.load() >= pullSeq;
+            }
+
+            void waitPulled(Context const context, VAddr const destVAddr, std::uint64_t const pullSeq){
+                if(pullSeq){
+                    waitUntil([&]{ return pulled(context, destVAddr, pullSeq); }, context.getSegmentVAddr(destVAddr), shm::WaitKind::PULLED, pullSeq);
+                }
+
+            }
+
+        private:
+            using Key = utils::PackedKey<MsgType, ContextID, VAddr, Tag>;
+
+            static constexpr VAddr noVAddr = std::numeric_limits<VAddr>::max();
+
+            shm::Segment segment;
+            std::size_t const inlineSize;
+            std::size_t const spinCount;
+            std::chrono::microseconds const drainTimeout;
+            Context initialContext;
+            std::vector<std::uint64_t> pullsIssued;
+            std::vector<std::uint64_t> filesIssued;
+
+            // Messages that were taken from the rings before they
+            // were asked for
+            std::unordered_map<Key, std::deque<Message>, utils::PackedKeyHash<Key> > early;
+
+            // Payloads of early messages, that were copied out, keep
+            // their memory for the next early messages. All of them
+            // hold the largest early message, thus every spare fits
+            std::vector<std::vector<std::int8_t> > sparePayloads;
+            std::size_t sparePayloadSize = 0;
+            static constexpr std::size_t maxSparePayloads = 4;
+
+            VAddr me() const {
+                return segment.vAddr;
+            }
+
+            static std::size_t recordSize(shm::RecordHeader const & header){
+                std::size_t const payloadSize = header.kind == shm::RecordKind::INLINE ? (header.size + 7) / 8 * 8 : 0;
+                return sizeof(shm::RecordHeader) + payloadSize;
+            }
+
+            static void copy(Message const & message, std::int8_t * recvData, std::size_t const size){
+                memcpy(recvData, message.getData(), std::min(size, message.getDataSize()));
+            }
+
+            /**
+             * @brief Publishes a state change to *vAddr*, that is only
+             *        woken if it sleeps.
+             *
+             */
+            void notify(VAddr const vAddr){
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                shm::PeerSlot &slot = segment.peer(vAddr);
+                if(slot.sleeping.load()){
+                    ++slot.doorbell;
+                    shm::futexWake(slot.doorbell);
+                }
+
+            }
+
+            /**
+             * @brief Polls *done* and sleeps on the doorbell of this
+             *        peer, when polling did not succeed. The wait for
+             *        *awaitedVAddr* is published in the slot of the peer,
+             *        thus progress() of other peers can tell whether
+             *        the waits form a circle. Without *awaitedVAddr* the
+             *        peer waits for a message of any peer. After sleeping
+             *        for the drain timeout without a wake up, all rings
+             *        are drained.
+             *
+             */
+            template <typename T_Done>
+            void waitUntil(T_Done done, VAddr const awaitedVAddr = noVAddr, shm::WaitKind const kind = shm::WaitKind::MESSAGE, std::uint64_t const until = 0){
+                for(std::size_t spin = 0; spin < spinCount; ++spin){
+                    if(done()){
+                        return;
+                    }
+                }
+
+                shm::PeerSlot &slot = segment.peer(me());
+                if(awaitedVAddr != noVAddr){
+                    slot.waitKind.store(static_cast<std::uint32_t>(kind));
+                    slot.waitsUntil.store(until);
+                    slot.waitsFor.store(awaitedVAddr + 1);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    // The peer, that closes a circle of waits, wakes the
+                    // others, thus the one that can break it notices
+                    if(circles(awaitedVAddr)){
+                        shm::WaitKind otherKind = shm::WaitKind::MESSAGE;
+                        VAddr vAddr = awaitedVAddr;
+                        for(std::size_t step = 0; step < initialContext.size() && vAddr != noVAddr && vAddr != me(); ++step){
+                            notify(vAddr);
+                            vAddr = waitOf(vAddr, otherKind);
+                        }
+                    }
+                }
+
+                bool timedOut = false;
+                while(true){
+                    slot.sleeping.store(1);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    std::uint32_t const seen = slot.doorbell.load();
+                    // Rings are only drained when the wake up did not
+                    // already finish the wait, every drained message is
+                    // copied twice
+                    bool finished = done();
+                    if(!finished){
+                        progress(awaitedVAddr, kind, timedOut);
+                        finished = done();
+                    }
+                    if(finished){
+                        slot.sleeping.store(0);
+                        slot.waitsFor.store(0);
+                        return;
+                    }
+                    timedOut = !shm::futexWait(slot.doorbell, seen, drainTimeout);
+                }
+
+            }
+
+            /**
+             * @brief Returns the peer, that *vAddr* waits for, or noVAddr
+             *        if it waits for none or the wait is already over.
+             *        A peer that waits for a message is still going on,
+             *        while there are records in the ring to it.
+             *
+             */
+            VAddr waitOf(VAddr const vAddr, shm::WaitKind & kind){
+                shm::PeerSlot &slot = segment.peer(vAddr);
+                std::uint32_t const waitsFor = slot.waitsFor.load();
+                if(!waitsFor){
+                    return noVAddr;
+                }
+                VAddr const other = waitsFor - 1;
+                kind = static_cast<shm::WaitKind>(slot.waitKind.load());
+                std::uint64_t const until = slot.waitsUntil.load();
+
+                bool over = false;
+                switch(kind){
+                case shm::WaitKind::MESSAGE: {
+                    shm::Ring ring = segment.ring(other, vAddr);
+                    over = ring.control.head.load() != ring.control.tail.load();
+                    break;
+                }
+                case shm::WaitKind::PULLED:
+                    over = segment.ring(vAddr, other).control.pulled.load() >= until;
+                    break;
+                case shm::WaitKind::TAIL:
+                    over = segment.ring(vAddr, other).control.tail.load() >= until;
+                    break;
+                }
+                return over ? noVAddr : other;
+
+            }
+
+            /**
+             * @brief True, if following the waits of the peers from
+             *        *vAddr* leads back to this peer.
+             *
+             */
+            bool circles(VAddr vAddr){
+                shm::WaitKind kind = shm::WaitKind::MESSAGE;
+                for(std::size_t step = 0; step < initialContext.size() && vAddr != noVAddr; ++step){
+                    if(vAddr == me()){
+                        return true;
+                    }
+                    vAddr = waitOf(vAddr, kind);
+                }
+                return false;
+
+            }
+
+            void writeRecord(VAddr const destVAddr, shm::RecordHeader const & header, void const * payload){
+                shm::Ring ring = segment.ring(me(), destVAddr);
+                std::uint64_t const head = ring.control.head.load(std::memory_order_relaxed);
+                std::size_t const length = recordSize(header);
+
+                auto const fits = [&]{ return head + length - ring.control.tail.load() <= ring.size; };
+                if(!fits()){
+                    waitUntil(fits, destVAddr, shm::WaitKind::TAIL, head + length - ring.size);
+                }
+
+                ring.write(head, &header, sizeof(header));
+                if(header.kind == shm::RecordKind::INLINE && header.size){
+                    ring.write(head + sizeof(header), payload, header.size);
+                }
+                ring.control.head.store(head + length);
+                notify(destVAddr);
+
+            }
+
+            bool peek(VAddr const srcVAddr, shm::RecordHeader & header){
+                shm::Ring ring = segment.ring(srcVAddr, me());
+                std::uint64_t const tail = ring.control.tail.load(std::memory_order_relaxed);
+                if(ring.control.head.load() == tail){
+                    return false;
+                }
+                ring.read(tail, &header, sizeof(header));
+                return true;
+
+            }
+
+            /**
+             * @brief Copies *size* bytes of the payload of the first
+             *        record of the ring of *srcVAddr* and removes it.
+             *
+             */
+            void consume(VAddr const srcVAddr, shm::RecordHeader const & header, std::int8_t * recvData, std::size_t const size){
+                shm::Ring ring = segment.ring(srcVAddr, me());
+                std::uint64_t const tail = ring.control.tail.load(std::memory_order_relaxed);
+
+                switch(header.kind){
+                case shm::RecordKind::INLINE:
+                    if(size){
+                        ring.read(tail + sizeof(header), recvData, size);
+                    }
+                    break;
+
+                case shm::RecordKind::PULL:
+                    if(srcVAddr == me()){
+                        memcpy(recvData, reinterpret_cast<void const*>(header.address), size);
+                    }
+                    else if(!shm::readRemote(segment.peer(srcVAddr).pid, header.address, recvData, size)){
+                        throw std::runtime_error("Could not read payload from peer " + std::to_string(srcVAddr) + ".");
+                    }
+                    break;
+
+                case shm::RecordKind::FILE:
+                    readFile(fileName(srcVAddr, me(), header.address), recvData, size);
+                    break;
+                }
+
+                ring.control.tail.store(tail + recordSize(header));
+                if(header.kind == shm::RecordKind::PULL){
+                    ++ring.control.pulled;
+                }
+                notify(srcVAddr);
+
+            }
+
+            Message take(VAddr const srcVAddr, shm::RecordHeader const & header){
+                Message message(static_cast<MsgType>(header.msgType), header.contextID, header.srcVAddr, header.tag, 0);
+                message.payload = payloadOf(header.size);
+                consume(srcVAddr, header, message.getData(), header.size);
+                return message;
+
+            }
+
+            std::vector<std::int8_t> payloadOf(std::size_t const size){
+                std::vector<std::int8_t> payload;
+                if(size > sparePayloadSize){
+                    sparePayloadSize = size;
+                    sparePayloads.clear();
+                }
+                else if(!sparePayloads.empty()){
+                    payload = std::move(sparePayloads.back());
+                    sparePayloads.pop_back();
+                }
+                payload.reserve(sparePayloadSize);
+                payload.resize(size);
+                return payload;
+
+            }
+
+            void recycle(Message & message){
+                if(message.payload.capacity() >= sparePayloadSize && sparePayloads.size() < maxSparePayloads){
+                    sparePayloads.push_back(std::move(message.payload));
+                }
+
+            }
+
+            void keep(VAddr const srcVAddr, shm::RecordHeader const & header){
+                Key key(static_cast<MsgType>(header.msgType), header.contextID, header.srcVAddr, header.tag);
+                early[key].push_back(take(srcVAddr, header));
+            }
+
+            /**
+             * @brief Copies the records of peers, that wait for this peer
+             *        to consume them, out of their rings. This is only
+             *        needed, when the wait for *awaitedVAddr* leads back
+             *        to this peer or it waits for any peer. Otherwise the
+             *        peers go on without it and the records stay in the
+             *        rings until they are received, thus they are copied
+             *        only once and no buffer is kept for them. With *all*
+             *        every ring is drained.
+             *
+             */
+            void progress(VAddr const awaitedVAddr, shm::WaitKind const kind, bool const all){
+                if(!all && awaitedVAddr != noVAddr && !circles(awaitedVAddr)){
+                    return;
+                }
+
+                shm::RecordHeader header;
+                for(VAddr vAddr = 0; vAddr < initialContext.size(); ++vAddr){
+                    // The awaited message is left to the wait
+                    if(kind == shm::WaitKind::MESSAGE && vAddr == awaitedVAddr){
+                        continue;
+                    }
+                    shm::WaitKind otherKind = shm::WaitKind::MESSAGE;
+                    if(!all && (waitOf(vAddr, otherKind) != me() || otherKind == shm::WaitKind::MESSAGE)){
+                        continue;
+                    }
+                    while(peek(vAddr, header)){
+                        keep(vAddr, header);
+                    }
+                }
+
+            }
+
+            bool takeEarly(Key const & key, Message & message){
+                if(early.empty()){
+                    return false;
+                }
+                auto it = early.find(key);
+                if(it == early.end()){
+                    return false;
+                }
+                message = std::move(it->second.front());
+                it->second.pop_front();
+                if(it->second.empty()){
+                    early.erase(it);
+                }
+                return true;
+
+            }
+
+            /**
+             * @brief Messages from *srcVAddr* only arrive on its ring,
+             *        thus only this ring is drained until the message
+             *        is found. Passed messages are kept for later receives.
+             *
+             */
+            bool peekMatching(MsgType const msgType, ContextID const contextID, VAddr const srcVAddr, Tag const tag, shm::RecordHeader & header){
+                while(peek(srcVAddr, header)){
+                    if(header.msgType == static_cast<std::int8_t>(msgType) && header.contextID == contextID && header.tag == tag){
+                        return true;
+                    }
+                    keep(srcVAddr, header);
+                }
+                return false;
+
+            }
+
+            bool tryTake(MsgType const msgType, Context const & context, VAddr const srcVAddr, Tag const tag, Message & message){
+                if(takeEarly(Key(msgType, context.getID(), srcVAddr, tag), message)){
+                    return true;
+                }
+                VAddr const ringVAddr = context.getSegmentVAddr(srcVAddr);
+                shm::RecordHeader header;
+                if(peekMatching(msgType, context.getID(), ringVAddr, tag, header)){
+                    message = take(ringVAddr, header);
+                    return true;
+                }
+                return false;
+
+            }
+
+            /**
+             * @brief Matching messages, that were not taken from the
+             *        ring before, are copied directly into *recvData*.
+             *
+             */
+            bool tryTake(MsgType const msgType, Context const & context, VAddr const srcVAddr, Tag const tag, std::int8_t * recvData, std::size_t const size){
+                Message message;
+                if(takeEarly(Key(msgType, context.getID(), srcVAddr, tag), message)){
+                    copy(message, recvData, size);
+                    recycle(message);
+                    return true;
+                }
+                VAddr const ringVAddr = context.getSegmentVAddr(srcVAddr);
+                shm::RecordHeader header;
+                if(peekMatching(msgType, context.getID(), ringVAddr, tag, header)){
+                    consume(ringVAddr, header, recvData, std::min(size, static_cast<std::size_t>(header.size)));
+                    return true;
+                }
+                return false;
+
+            }
+
+            bool tryTakeAny(MsgType const msgType, Context const context, Message & message){
+                for(auto it = early.begin(); it != early.end(); ++it){
+                    if(it->first.startsWith(msgType, context.getID())){
+                        message = std::move(it->second.front());
+                        it->second.pop_front();
+                        if(it->second.empty()){
+                            early.erase(it);
+                        }
+                        return true;
+                    }
+                }
+
+                shm::RecordHeader header;
+                for(auto const &vAddr : context){
+                    VAddr const ringVAddr = context.getSegmentVAddr(vAddr);
+                    while(peek(ringVAddr, header)){
+                        if(header.msgType == static_cast<std::int8_t>(msgType) && header.contextID == context.getID()){
+                            message = take(ringVAddr, header);
+                            return true;
+                        }
+                        keep(ringVAddr, header);
+                    }
+                }
+                return false;
+
+            }
+
+            std::string fileName(VAddr const srcVAddr, VAddr const destVAddr, std::uint64_t const fileSeq){
+                return segment.name + "_" + std::to_string(segment.peer(srcVAddr).pid) + "_" + std::to_string(destVAddr) + "_" + std::to_string(fileSeq);
+            }
+
+            static void writeFile(std::string const & name, void const * data, std::size_t const size){
+                int const fd = shm_open(name.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0600);
+                if(fd < 0 || ftruncate(fd, size) != 0){
+                    throw std::runtime_error("Could not create shared memory file /dev/shm" + name + ".");
+                }
+                void * address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                close(fd);
+                if(address == MAP_FAILED){
+                    throw std::runtime_error("Could not map shared memory file /dev/shm" + name + ".");
+                }
+                memcpy(address, data, size);
+                munmap(address, size);
+
+            }
+
+            static void readFile(std::string const & name, std::int8_t * recvData, std::size_t const size){
+                int const fd = shm_open(name.c_str(), O_RDONLY, 0600);
+                shm_unlink(name.c_str());
+                if(fd < 0){
+                    throw std::runtime_error("Could not open shared memory file /dev/shm" + name + ".");
+                }
+                if(size){
+                    void * address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+                    if(address == MAP_FAILED){
+                        close(fd);
+                        throw std::runtime_error("Could not map shared memory file /dev/shm" + name + ".");
+                    }
+                    memcpy(recvData, address, size);
+                    munmap(address, size);
+                }
+                close(fd);
+
+            }
+
+        };
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
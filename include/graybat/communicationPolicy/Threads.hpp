@@ -0,0 +1,434 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// CLIB
+#include <string.h>   /* memcpy */
+
+// STL
+#include <algorithm>     /* std::min, std::find */
+#include <array>         /* std::array */
+#include <cstddef>       /* std::size_t */
+#include <deque>         /* std::deque */
+#include <memory>        /* std::shared_ptr */
+#include <unordered_map> /* std::unordered_map */
+#include <utility>       /* std::move */
+#include <vector>        /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Base.hpp>             /* Base */
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/RecvView.hpp>         /* RecvView */
+#include <graybat/communicationPolicy/threads/Message.hpp> /* Message */
+#include <graybat/communicationPolicy/threads/Network.hpp> /* Network */
+#include <graybat/communicationPolicy/threads/Context.hpp> /* Context */
+#include <graybat/communicationPolicy/threads/Event.hpp>   /* Event */
+#include <graybat/communicationPolicy/threads/Config.hpp>  /* Config */
+#include <graybat/utils/StripedMessageBox.hpp>              /* utils::PackedKey, utils::PackedKeyHash */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+	/************************************************************************//**
+	 * @class Threads
+	 *
+	 * @brief Implementation of the Cage communicationPolicy interface
+	 *        for peers that are threads of the same process.
+	 *
+	 * Every peer thread constructs its own policy from a config that
+	 * refers to the shared Network, and must be the only thread that
+	 * uses it. There is neither MPI nor a network involved.
+	 *
+	 ***************************************************************************/
+        struct Threads;
+
+        namespace traits {
+
+            template<>
+            struct ContextType<Threads> {
+                using type = graybat::communicationPolicy::threads::Context<Threads>;
+            };
+
+            template<>
+            struct ContextIDType<Threads> {
+                using type = unsigned;
+            };
+
+            template<>
+            struct EventType<Threads> {
+                using type = graybat::communicationPolicy::threads::Event<Threads>;
+            };
+
+            template<>
+            struct ConfigType<Threads> {
+                using type = graybat::communicationPolicy::threads::Config<Threads>;
+            };
+
+        }
+
+	struct Threads : Base<Threads> {
+
+	    // Type defs
+            using Tag       = graybat::communicationPolicy::Tag<Threads>;
+            using ContextID = graybat::communicationPolicy::ContextID<Threads>;
+            using MsgType   = graybat::communicationPolicy::MsgType<Threads>;
+            using VAddr     = graybat::communicationPolicy::VAddr<Threads>;
+            using Context   = graybat::communicationPolicy::Context<Threads>;
+            using Event     = graybat::communicationPolicy::Event<Threads>;
+            using Config    = graybat::communicationPolicy::Config<Threads>;
+            using Message   = graybat::communicationPolicy::threads::Message<Threads>;
+            using Network   = graybat::communicationPolicy::threads::Network<Threads>;
+
+            template <typename T>
+            using RecvView  = graybat::communicationPolicy::RecvView<T, Message>;
+
+	    Threads(Config const config) :
+                network(config.network),
+                spinCount(config.spinCount),
+                initialContext(0, network->join(), network->nPeers){
+
+            }
+
+            // Copy constructor
+            Threads(Threads &) = delete;
+            // Copy assignment constructor
+            Threads& operator=(Threads &) = delete;
+            // Move constructor
+            Threads(Threads &&) = delete;
+            // Move assignment constructor
+            Threads& operator=(Threads &&) = delete;
+            // Destructor
+            ~Threads(){}
+
+	    /***********************************************************************//**
+             *
+	     * @name Point to Point Communication Interface
+	     *
+	     * @{
+	     *
+	     ***************************************************************************/
+	    /**
+	     * @brief Blocking transmission of a message sendData to peer with virtual address destVAddr.
+	     *
+	     * @param[in] destVAddr  VAddr of peer that will receive the message
+	     * @param[in] tag        Description of the message to better distinguish messages types
+	     * @param[in] context    Context in which both sender and receiver are included
+	     * @param[in] sendData   Data reference of template type T will be send to receiver peer.
+	     *                       T need to provide the function data(), that returns the pointer
+	     *                       to the data memory address. And the function size(), that
+	     *                       return the amount of data elements to send. Notice, that
+	     *                       std::vector and std::array implement this interface.
+	     */
+            template <typename T_Send>
+            void send(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+                sendImpl(MsgType::PEER, context, destVAddr, tag, sendData);
+            }
+
+            /**
+	     * @brief Non blocking transmission of a message sendData to peer with virtual address destVAddr.
+	     *        The event is finished on return, since the message owns a copy of sendData.
+	     *
+	     * @param[in] destVAddr  VAddr of peer that will receive the message
+	     * @param[in] tag        Description of the message to better distinguish messages types
+	     * @param[in] context    Context in which both sender and receiver are included
+	     * @param[in] sendData   Data reference of template type T will be.
+	     *                       T need to provide the function data(), that returns the pointer
+	     *                       to the data memory address. And the function size(), that
+	     *                       return the amount of data elements to send. Notice, that
+	     *                       std::vector and std::array implement this interface.
+	     *
+	     * @return Event
+	     */
+            template <typename T_Send>
+            Event asyncSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData){
+                sendImpl(MsgType::PEER, context, destVAddr, tag, sendData);
+                return Event(context, destVAddr, tag, *this);
+            }
+
+	    /**
+	     * @brief Blocking receive of a message recvData from peer with virtual address srcVAddr.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     * @param[out] recvData   Data reference of template type T will be received from sender peer.
+	     *                        T need to provide the function data(), that returns the pointer
+	     *                        to the data memory address. And the function size(), that
+	     *                        return the amount of data elements to send. Notice, that
+	     *                        std::vector and std::array implement this interface.
+	     */
+            template <typename T_Recv>
+            void recv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+                recvImpl(MsgType::PEER, context, srcVAddr, tag, recvData);
+            }
+
+	    /**
+	     * @brief Blocking receive of a message from peer with virtual address srcVAddr,
+	     *        whose payload is handed over without a copy.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     *
+	     * @return Read-only view of the received elements of type T, that owns the message
+	     */
+            template <typename T>
+            RecvView<T> recv(const VAddr srcVAddr, const Tag tag, const Context context){
+                return RecvView<T>(recvImpl(MsgType::PEER, context, srcVAddr, tag));
+            }
+
+	    /**
+	     * @brief Blocking receive of a message of any peer with any tag of the *context*.
+	     *
+	     * @return Event, that knows the source and the tag of the message
+	     */
+            template <typename T_Recv>
+            Event recv(const Context context, T_Recv& recvData){
+                Message message;
+                while(true){
+                    std::size_t const seen = network->arrivals(initialContext.getVAddr());
+                    if(tryTakeAny(MsgType::PEER, context, message)){
+                        break;
+                    }
+                    network->waitArrival(initialContext.getVAddr(), seen, spinCount);
+                }
+                copy(message, reinterpret_cast<std::int8_t*>(recvData.data()), sizeof(typename T_Recv::value_type) * recvData.size());
+                return Event(context, message.srcVAddr, message.tag, *this);
+            }
+
+	    /**
+	     * @brief Non blocking receive of a message recvData from peer with virtual address srcVAddr.
+	     *
+	     * @param[in]  srcVAddr   VAddr of peer that sended the message
+	     * @param[in]  tag        Description of the message to better distinguish messages types
+	     * @param[in]  context    Context in which both sender and receiver are included
+	     * @param[out] recvData   Data reference of template type T will be received from sender peer.
+	     *                        T need to provide the function data(), that returns the pointer
+	     *                        to the data memory address. And the function size(), that
+	     *                        return the amount of data elements to send. Notice, that
+	     *                        std::vector and std::array implement this interface.
+	     *
+	     * @return Event
+	     *
+	     */
+            template <typename T_Recv>
+            Event asyncRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData){
+                bool const done = asyncRecvImpl(MsgType::PEER, context, srcVAddr, tag,
+                                                reinterpret_cast<std::int8_t*>(recvData.data()),
+                                                sizeof(typename T_Recv::value_type) * recvData.size());
+                return Event(context, srcVAddr, tag, recvData, done, *this);
+            }
+	    /** @} */
+
+	    /***********************************************************************//**
+             *
+	     * @name Context Interface
+	     *
+	     * @{
+	     *
+	     ***************************************************************************/
+	    /**
+	     * @brief Returns a subcontext of *oldContext* with all peers that want to participate.
+             *        Peers which do not want to participate retrieve an invalid context.
+             *
+             * The members are numbered in the order of their vAddrs in
+             * *oldContext*. The new context maps their vAddrs back to the
+             * network, which selects the channels.
+	     */
+            Context splitContext(const bool isMember, const Context oldContext){
+                VAddr const masterVAddr = 0;
+
+                // Request old master for new context
+                std::array<unsigned, 1> member {{ isMember }};
+                sendImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, member);
+
+                // Peer with VAddr 0 collects new members
+                if(oldContext.getVAddr() == masterVAddr){
+                    std::vector<VAddr> newContextWhiteList;
+                    for(auto const &vAddr : oldContext){
+                        std::array<unsigned, 1> remoteIsMember {{ 0 }};
+                        recvImpl(MsgType::SPLIT, oldContext, vAddr, 0, remoteIsMember);
+                        if(remoteIsMember[0]){
+                            newContextWhiteList.push_back(vAddr);
+                        }
+                    }
+
+                    std::vector<VAddr> networkVAddrs;
+                    for(VAddr vAddr : newContextWhiteList){
+                        networkVAddrs.push_back(oldContext.getNetworkVAddr(vAddr));
+                    }
+
+                    std::array<ContextID, 1> newContextID {{ network->newContextID() }};
+                    std::array<unsigned, 1> newContextSize {{ static_cast<unsigned>(newContextWhiteList.size()) }};
+                    for(VAddr vAddr : newContextWhiteList){
+                        sendImpl(MsgType::SPLIT, oldContext, vAddr, 0, newContextID);
+                        sendImpl(MsgType::SPLIT, oldContext, vAddr, 0, newContextSize);
+                        sendImpl(MsgType::SPLIT, oldContext, vAddr, 0, networkVAddrs);
+                    }
+
+                }
+
+                if(!isMember){
+                    // Invalid context for "not members"
+                    return Context();
+                }
+
+                std::array<ContextID, 1> newContextID {{ 0 }};
+                std::array<unsigned, 1> newContextSize {{ 0 }};
+                recvImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, newContextID);
+                recvImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, newContextSize);
+                std::vector<VAddr> networkVAddrs(newContextSize[0], 0);
+                recvImpl(MsgType::SPLIT, oldContext, masterVAddr, 0, networkVAddrs);
+
+                VAddr const newVAddr = std::find(networkVAddrs.begin(), networkVAddrs.end(), initialContext.getVAddr()) - networkVAddrs.begin();
+                return Context(newContextID[0], newVAddr, networkVAddrs);
+
+            }
+
+	    /**
+	     * @brief Returns the context that contains all peers
+	     */
+            Context getGlobalContext(){
+                return initialContext;
+            }
+	    /** @} */
+
+            // Auxilary
+            template <typename T_Send>
+            void sendImpl(MsgType const msgType, Context const context, VAddr const destVAddr, Tag const tag, T_Send const & sendData){
+                network->post(initialContext.getVAddr(), context.getNetworkVAddr(destVAddr),
+                              Message(msgType, context.getID(), context.getVAddr(), tag,
+                                      sendData.data(), sizeof(typename T_Send::value_type) * sendData.size()));
+            }
+
+            Message recvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag){
+                Message message;
+                while(true){
+                    std::size_t const seen = network->arrivals(initialContext.getVAddr());
+                    if(tryTake(msgType, context, srcVAddr, tag, message)){
+                        return message;
+                    }
+                    network->waitArrival(initialContext.getVAddr(), seen, spinCount);
+                }
+
+            }
+
+            template <typename T_Recv>
+            void recvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag, T_Recv & recvData){
+                recvImpl(msgType, context, srcVAddr, tag, reinterpret_cast<std::int8_t*>(recvData.data()), sizeof(typename T_Recv::value_type) * recvData.size());
+            }
+
+            void recvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag, std::int8_t * recvData, std::size_t const size){
+                Message message = recvImpl(msgType, context, srcVAddr, tag);
+                copy(message, recvData, size);
+            }
+
+            bool asyncRecvImpl(MsgType const msgType, Context const context, VAddr const srcVAddr, Tag const tag, std::int8_t * recvData, std::size_t const size){
+                Message message;
+                if(tryTake(msgType, context, srcVAddr, tag, message)){
+                    copy(message, recvData, size);
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            using Key = utils::PackedKey<MsgType, ContextID, VAddr, Tag>;
+
+            std::shared_ptr<Network> network;
+            std::size_t const spinCount;
+            Context initialContext;
+
+            // Messages that arrived before they were asked for, only
+            // accessed by the thread of this peer
+            std::unordered_map<Key, std::deque<Message>, utils::PackedKeyHash<Key> > early;
+
+            static void copy(Message const & message, std::int8_t * recvData, std::size_t const size){
+                memcpy(recvData, message.getData(), std::min(size, message.getDataSize()));
+            }
+
+            void keep(Message && message){
+                Key key(message.msgType, message.contextID, message.srcVAddr, message.tag);
+                early[key].push_back(std::move(message));
+            }
+
+            /**
+             * @brief Messages from *srcVAddr* only arrive on its channel,
+             *        thus only this channel is drained until the message
+             *        is found. Passed messages are kept for later receives.
+             *
+             */
+            bool tryTake(MsgType const msgType, Context const & context, VAddr const srcVAddr, Tag const tag, Message & message){
+                ContextID const contextID = context.getID();
+                if(!early.empty()){
+                    auto it = early.find(Key(msgType, contextID, srcVAddr, tag));
+                    if(it != early.end()){
+                        message = std::move(it->second.front());
+                        it->second.pop_front();
+                        if(it->second.empty()){
+                            early.erase(it);
+                        }
+                        return true;
+                    }
+                }
+
+                auto &channel = network->channel(context.getNetworkVAddr(srcVAddr), initialContext.getVAddr());
+                while(channel.tryPop(message)){
+                    if(message.msgType == msgType && message.contextID == contextID && message.tag == tag){
+                        return true;
+                    }
+                    keep(std::move(message));
+                }
+                return false;
+
+            }
+
+            bool tryTakeAny(MsgType const msgType, Context const context, Message & message){
+                for(auto it = early.begin(); it != early.end(); ++it){
+                    if(it->first.startsWith(msgType, context.getID())){
+                        message = std::move(it->second.front());
+                        it->second.pop_front();
+                        if(it->second.empty()){
+                            early.erase(it);
+                        }
+                        return true;
+                    }
+                }
+
+                for(auto const &vAddr : context){
+                    auto &channel = network->channel(context.getNetworkVAddr(vAddr), initialContext.getVAddr());
+                    while(channel.tryPop(message)){
+                        if(message.msgType == msgType && message.contextID == context.getID()){
+                            return true;
+                        }
+                        keep(std::move(message));
+                    }
+                }
+                return false;
+
+            }
+
+        };
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -20,6 +20,9 @@
 
 #pragma once
 
+// STL
+#include <cstdint> /* std::int8_t */
+
 namespace graybat {
     
     namespace communicationPolicy {
@@ -56,7 +59,9 @@ namespace graybat {
                 CONTEXT_REQUEST = 6,
                 PEER = 7,
                 CONFIRM = 8,
-                SPLIT = 9};
+                SPLIT = 9,
+                BATCH = 10,
+                PHONEBOOK_LOOKUP = 11};
         
         template <typename T_CommunicationPolicy>
         using MsgType = MsgTypeType;
@@ -38,6 +38,7 @@
 
 // GrayBat
 #include <graybat/communicationPolicy/socket/Base.hpp> /* Base */
+#include <graybat/communicationPolicy/socket/SignalingMessage.hpp> /* SignalingMessage */
 #include <graybat/communicationPolicy/Traits.hpp>
 #include <graybat/communicationPolicy/zmq/Message.hpp> /* Message */
 #include <graybat/communicationPolicy/zmq/Context.hpp> /* Context */
@@ -121,6 +122,7 @@ namespace graybat {
             using Socket     = graybat::communicationPolicy::socket::Socket<ZMQ>;            
             using Message    = graybat::communicationPolicy::socket::Message<ZMQ>;
             using SocketBase = graybat::communicationPolicy::socket::Base<ZMQ>;
+            using SignalingMessage = graybat::communicationPolicy::socket::SignalingMessage;
             
 	    // ZMQ Sockets
             ::zmq::context_t zmqContext;
@@ -188,22 +190,40 @@ namespace graybat {
             }
 
             template <typename T_Socket>            
-	    void recvFromSocket(T_Socket& socket, std::stringstream& ss) {
+	    void recvFromSocket(T_Socket& socket, SignalingMessage & signalingMessage) {
 		::zmq::message_t message;                
 		socket.recv(&message);
-                ss << static_cast<char*>(message.data());
+                signalingMessage = SignalingMessage(message.data(), message.size());
 	    }
 
             template <typename T_Socket>            
 	    void recvFromSocket(T_Socket& socket, Message & message) {
                 socket.recv(&message.getMessage());                
+                recvPayload(socket, message);
 	    }
 
             template <typename T_Socket>
-	    void sendToSocket(T_Socket& socket, std::stringstream const & ss) {
-                std::string string = ss.str();
-		::zmq::message_t message(sizeof(char) * string.size());
-		memcpy (static_cast<char*>(message.data()), string.data(), sizeof(char) * string.size());
+	    bool tryRecvFromSocket(T_Socket& socket, Message & message) {
+                if(!socket.recv(&message.getMessage(), ZMQ_DONTWAIT)){
+                    return false;
+                }
+                recvPayload(socket, message);
+                return true;
+	    }
+
+            template <typename T_Socket>
+	    void recvPayload(T_Socket& socket, Message & message) {
+                // Further frames of a message are already complete
+                if(message.getMessage().more()){
+                    socket.recv(&message.getPayload());
+                    message.multipart = true;
+                }
+	    }
+
+            template <typename T_Socket>
+	    void sendToSocket(T_Socket& socket, SignalingMessage const & signalingMessage) {
+		::zmq::message_t message(signalingMessage.size());
+		memcpy (static_cast<char*>(message.data()), signalingMessage.data(), signalingMessage.size());
 		socket.send(message);
 	    }
 
@@ -212,6 +232,17 @@ namespace graybat {
                 socket.send(data);
             }
 
+            template <typename T_Socket>
+	    void sendToSocket(T_Socket& socket, Message & message) {
+                if(message.multipart){
+                    socket.send(message.getMessage(), ZMQ_SNDMORE);
+                    socket.send(message.getPayload());
+                }
+                else {
+                    socket.send(message.getMessage());
+                }
+            }
+
 	    Uri bindToNextFreePort(Socket &socket, const std::string peerUri){
 		std::string peerBaseUri = peerUri.substr(0, peerUri.rfind(":"));
 		unsigned peerBasePort   = std::stoi(peerUri.substr(peerUri.rfind(":") + 1));		
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <utility> /* std::swap */
+
+// MPI
+#include <mpi.h>   /* MPI_* */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace bmpi {
+
+            /**
+             * @brief Persistent send or receive, created by
+             *        MPI_Send_init or MPI_Recv_init. Each start()
+             *        restarts the request without resolving the peer
+             *        or the datatype again.
+             *
+             */
+            class Channel {
+            public:
+                explicit Channel(MPI_Request request) :
+                    request(request),
+                    active(false){
+
+                }
+
+                Channel(Channel const &) = delete;
+                Channel& operator=(Channel const &) = delete;
+
+                Channel(Channel && other) noexcept :
+                    request(other.request),
+                    active(other.active){
+                    other.request = MPI_REQUEST_NULL;
+                    other.active = false;
+                }
+
+                Channel& operator=(Channel && other) noexcept {
+                    std::swap(request, other.request);
+                    std::swap(active, other.active);
+                    return *this;
+                }
+
+                ~Channel(){
+                    int finalized = 0;
+                    MPI_Finalized(&finalized);
+                    if(request != MPI_REQUEST_NULL && !finalized){
+                        wait();
+                        MPI_Request_free(&request);
+                    }
+
+                }
+
+                void start(){
+                    MPI_Start(&request);
+                    active = true;
+                }
+
+                void wait(){
+                    if(active){
+                        MPI_Wait(&request, MPI_STATUS_IGNORE);
+                        active = false;
+                    }
+
+                }
+
+                bool ready(){
+                    if(active){
+                        int flag = 0;
+                        MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+                        active = !flag;
+                    }
+                    return !active;
+
+                }
+
+            private:
+                MPI_Request request;
+                bool active;
+
+            };
+
+        } // namespace bmpi
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -20,8 +20,14 @@
 
 #pragma once
 
+// STL
+#include <memory> /* std::shared_ptr */
+
 #include <boost/mpi/environment.hpp>
 
+// GrayBat
+#include <graybat/communicationPolicy/Operation.hpp> /* Operation */
+
 namespace graybat {
 
     namespace communicationPolicy {
@@ -50,6 +56,10 @@ namespace graybat {
 
                 }
 
+                Event(std::shared_ptr<Operation> operation) : async(false), operation(operation){
+
+                }
+
                 Event& operator=(const Event&) = default;
 
                 ~Event(){
@@ -57,6 +67,9 @@ namespace graybat {
                 }
 
                 void wait(){
+                    if(operation){
+                        operation->wait();
+                    }
                     if(async){
                         request.wait();
                     }
@@ -64,6 +77,9 @@ namespace graybat {
                 }
 
                 bool ready(){
+                    if(operation){
+                        return operation->ready();
+                    }
                     if(async){
                         boost::optional<boost::mpi::status> status = request.test();
 
@@ -97,6 +113,7 @@ namespace graybat {
                 boost::mpi::request request;
                 boost::mpi::status  status;
                 bool async;
+                std::shared_ptr<Operation> operation;
 
 
 
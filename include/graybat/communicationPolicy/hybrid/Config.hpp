@@ -0,0 +1,58 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <string>  /* std::string */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/shm/Config.hpp> /* shm::Config */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace hybrid {
+
+            template <typename T_Remote>
+            struct Config {
+                // Configuration of the policy between nodes
+                graybat::communicationPolicy::Config<T_Remote> remote;
+                // Configuration of the shared memory inside a node, the
+                // context size is set to the number of peers of the node
+                // and the node name is appended to the context name
+                shm::Config local;
+                // Peers with the same node name communicate over shared
+                // memory, the host name is used if it is empty
+                std::string nodeName = "";
+                // Longest sleep in microseconds between two polls of a
+                // receive from any peer, once it polled for the spin
+                // count of the shared memory
+                size_t maxPollInterval = 1000;
+            };
+
+        } // namespace hybrid
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <memory>  /* std::shared_ptr, std::make_shared */
+#include <utility> /* std::move */
+#include <vector>  /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/SHM.hpp> /* SHM */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace hybrid {
+
+            /**
+             * @brief A context represents a set of peers which are
+             *        able to communicate with each other.
+             *
+             * It consists of the context of the remote policy, which
+             * contains all peers and defines their vAddrs, and the
+             * shared memory context of the peers on the node of this
+             * peer. Copies share the translation tables between both.
+             *
+             */
+            template<typename T_Remote>
+            class Context {
+
+                using ContextID     = unsigned;
+                using VAddr         = graybat::communicationPolicy::VAddr<T_Remote>;
+                using RemoteContext = graybat::communicationPolicy::Context<T_Remote>;
+                using LocalContext  = graybat::communicationPolicy::Context<SHM>;
+                using Nodes         = std::vector<std::vector<VAddr> >;
+
+            public:
+                Context() :
+                    contextID(0),
+                    isValid(false),
+                    state(std::make_shared<State>()){
+
+                }
+
+                /**
+                 * @param[in] globalOf        Global vAddr of each vAddr of the remote context
+                 * @param[in] localOfContext  VAddr of the local context of each peer of the remote
+                 *                            context, that is on the node of this peer
+                 * @param[in] contextOfLocal  VAddr of the remote context of each peer of the local context
+                 * @param[in] nodes           VAddrs of the remote context grouped by node
+                 */
+                Context(ContextID contextID, RemoteContext remote, LocalContext local,
+                        std::vector<VAddr> globalOf, std::vector<VAddr> localOfContext,
+                        std::vector<VAddr> contextOfLocal, Nodes nodes) :
+                    contextID(contextID),
+                    isValid(true),
+                    state(std::make_shared<State>(State{remote, local, std::move(globalOf), std::move(localOfContext),
+                                                        std::move(contextOfLocal), std::move(nodes)})){
+
+                }
+
+                size_t size() const{
+                    return state->remote.size();
+                }
+
+                VAddr getVAddr() const {
+                    return state->remote.getVAddr();
+                }
+
+                ContextID getID() const {
+                    return contextID;
+                }
+
+                bool valid() const{
+                    return isValid;
+                }
+
+                auto begin() const {
+                    return state->remote.begin();
+                }
+
+                auto end() const {
+                    return state->remote.end();
+                }
+
+                RemoteContext const & getRemote() const {
+                    return state->remote;
+                }
+
+                LocalContext const & getLocal() const {
+                    return state->local;
+                }
+
+                VAddr globalOf(VAddr const vAddr) const {
+                    return state->globalOf[vAddr];
+                }
+
+                VAddr localOf(VAddr const vAddr) const {
+                    return state->localOfContext[vAddr];
+                }
+
+                VAddr contextOf(VAddr const localVAddr) const {
+                    return state->contextOfLocal[localVAddr];
+                }
+
+                Nodes const & getNodes() const {
+                    return state->nodes;
+                }
+
+            private:
+                struct State {
+                    RemoteContext      remote;
+                    LocalContext       local;
+                    std::vector<VAddr> globalOf;
+                    std::vector<VAddr> localOfContext;
+                    std::vector<VAddr> contextOfLocal;
+                    Nodes              nodes;
+                };
+
+                ContextID contextID;
+                bool      isValid;
+                std::shared_ptr<State const> state;
+            };
+
+        } // namespace hybrid
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
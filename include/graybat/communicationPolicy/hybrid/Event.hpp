@@ -0,0 +1,175 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <cstdint> /* std::int8_t */
+#include <memory>  /* std::shared_ptr */
+#include <utility> /* std::move */
+
+// BOOST
+#include <boost/optional.hpp>
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/Operation.hpp> /* Operation */
+#include <graybat/communicationPolicy/SHM.hpp> /* SHM */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace hybrid {
+
+            /**
+             * @brief An event is returned by non-blocking
+             *        communication operations and can be
+             *        asked whether an operation has finished
+             *        or it can be waited for this operation to
+             *        be finished.
+             *
+             * Wraps the event of the policy that carried the message,
+             * the source is the vAddr of the hybrid context.
+             *
+             */
+            template <typename T_Remote>
+            class Event {
+            public:
+
+                using VAddr       = graybat::communicationPolicy::VAddr<T_Remote>;
+                using Tag         = graybat::communicationPolicy::Tag<T_Remote>;
+                using LocalEvent  = graybat::communicationPolicy::Event<SHM>;
+                using RemoteEvent = graybat::communicationPolicy::Event<T_Remote>;
+
+                Event(VAddr vAddr, Tag tag) :
+                    vAddr(vAddr),
+                    tag(tag){
+
+                }
+
+                Event(LocalEvent local, VAddr vAddr, Tag tag) :
+                    local(local),
+                    vAddr(vAddr),
+                    tag(tag){
+
+                }
+
+                Event(RemoteEvent remote, VAddr vAddr, Tag tag) :
+                    remote(remote),
+                    vAddr(vAddr),
+                    tag(tag){
+
+                }
+
+                Event(std::shared_ptr<Operation> operation) :
+                    vAddr(0),
+                    tag(0),
+                    operation(operation){
+
+                }
+
+                Event& operator=(const Event&) = default;
+
+                void wait(){
+                    if(operation){
+                        operation->wait();
+                    }
+                    if(local){
+                        local->wait();
+                    }
+                    if(remote){
+                        remote->wait();
+                    }
+
+                }
+
+                bool ready(){
+                    if(operation){
+                        return operation->ready();
+                    }
+                    if(local){
+                        return local->ready();
+                    }
+                    if(remote){
+                        return remote->ready();
+                    }
+                    return true;
+
+                }
+
+                VAddr source(){
+                    return vAddr;
+                }
+
+                Tag getTag(){
+                    return tag;
+
+                }
+
+            private:
+                boost::optional<LocalEvent>  local;
+                boost::optional<RemoteEvent> remote;
+                VAddr vAddr;
+                Tag   tag;
+                std::shared_ptr<Operation> operation;
+
+            };
+
+            /**
+             * @brief Storage of a RecvView, that owns the view of the
+             *        policy that received the message.
+             *
+             */
+            template <typename T_Value, typename T_Remote>
+            struct RecvStorage {
+
+                using LocalView  = typename SHM::template RecvView<T_Value>;
+                using RemoteView = typename T_Remote::template RecvView<T_Value>;
+
+                RecvStorage(LocalView &&local) :
+                    local(std::move(local)){
+
+                }
+
+                RecvStorage(RemoteView &&remote) :
+                    remote(std::move(remote)){
+
+                }
+
+                std::int8_t const * getData() const {
+                    return reinterpret_cast<std::int8_t const *>(local ? local->data() : remote->data());
+                }
+
+                std::size_t getDataSize() const {
+                    return (local ? local->size() : remote->size()) * sizeof(T_Value);
+                }
+
+                boost::optional<LocalView>  local;
+                boost::optional<RemoteView> remote;
+
+            };
+
+        } // namespace hybrid
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <string>  /* std::string */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace shm {
+
+            struct Config {
+                size_t contextSize;
+                // Peers with the same context name meet in the shared
+                // memory segment /dev/shm/graybat_<contextName>
+                std::string contextName = "context";
+                // Bytes of the ring of each pair of peers
+                size_t ringSize = 1024 * 1024;
+                // Payloads from this size on are not copied through the
+                // ring, but read by the receiver directly from the memory
+                // of the sender, whose send finishes when they were read
+                size_t singleCopySize = 64 * 1024;
+                // Number of polls of a waiting peer, before it sleeps
+                // on a futex until another peer wakes it
+                size_t spinCount = 1000;
+                // Microseconds a waiting peer sleeps, before it copies out
+                // the messages of all peers. Peers that poll their events
+                // instead of waiting do not announce what they wait for,
+                // thus they rely on it.
+                size_t drainTimeout = 10000;
+            };
+
+        } // namespace shm
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
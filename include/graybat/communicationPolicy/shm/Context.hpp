@@ -0,0 +1,144 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <numeric>
+
+// GRAYBAT
+#include <graybat/communicationPolicy/Traits.hpp>
+
+namespace graybat {
+    
+    namespace communicationPolicy {
+    
+        namespace shm {
+
+            /**
+             * @brief A context represents a set of peers which are
+             *        able to communicate with each other.
+             *
+             * The peers of a context have the vAddrs 0 to size - 1 in
+             * it. The context knows the vAddr of each of them in the
+             * segment, which selects the rings.
+             *
+             */
+            template<typename T_CP>
+            class Context {
+
+                using ContextID = typename graybat::communicationPolicy::ContextID<T_CP>;
+                using VAddr     = typename graybat::communicationPolicy::VAddr<T_CP>;
+                using Tag       = typename graybat::communicationPolicy::Tag<T_CP>;                
+                using MsgType   = typename graybat::communicationPolicy::MsgType<T_CP>;
+                using MsgID     = typename graybat::communicationPolicy::MsgID<T_CP>;
+	    
+            public:
+                Context() :
+                    contextID(0),
+                    vAddr(0),
+                    nPeers(1),
+                    isValid(false),
+                    peers(0),
+                    segmentVAddrs(0){
+
+                }
+
+                Context(ContextID contextID, VAddr vAddr, unsigned nPeers) :
+                    contextID(contextID),
+                    vAddr(vAddr),
+                    nPeers(nPeers),
+                    isValid(true),
+                    peers(0),
+                    segmentVAddrs(0){
+
+
+                    peers.resize(nPeers);
+                    std::iota(peers.begin(), peers.end(), 0);
+                    segmentVAddrs = peers;
+                }
+
+                /**
+                 * @brief The peer with vAddr i in this context has the
+                 *        vAddr segmentVAddrs[i] in the segment.
+                 *
+                 */
+                Context(ContextID contextID, VAddr vAddr, std::vector<VAddr> segmentVAddrs) :
+                    contextID(contextID),
+                    vAddr(vAddr),
+                    nPeers(segmentVAddrs.size()),
+                    isValid(true),
+                    peers(segmentVAddrs.size()),
+                    segmentVAddrs(segmentVAddrs) {
+
+                    std::iota(peers.begin(), peers.end(), 0);
+                }
+
+                size_t size() const{
+                    return nPeers;
+                }
+
+                VAddr getVAddr() const {
+                    return vAddr;
+                }
+
+                ContextID getID() const {
+                    return contextID;
+                }
+
+                bool valid() const{
+                    return isValid;
+                }
+
+                VAddr getSegmentVAddr(VAddr const vAddr) const {
+                    return segmentVAddrs[vAddr];
+                }
+
+                std::vector<VAddr>::iterator begin(){
+                    return peers.begin();
+                }
+
+                std::vector<VAddr>::const_iterator begin() const {
+                    return peers.cbegin();
+                }
+
+                std::vector<VAddr>::iterator end(){
+                    return peers.end();
+                }
+
+                std::vector<VAddr>::const_iterator end() const {
+                    return peers.cend();
+                }
+                
+            private:	
+                ContextID contextID;
+                VAddr     vAddr;
+                unsigned  nPeers;
+                bool      isValid;
+                std::vector<VAddr> peers;
+                std::vector<VAddr> segmentVAddrs;
+            };
+
+
+        } // namespace shm
+        
+    } // namespace communicationPolicy
+	
+} // namespace graybat
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <cstdint> /* std::int8_t, std::uint64_t */
+#include <memory>  /* std::shared_ptr */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/Operation.hpp> /* Operation */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace shm {
+
+            /**
+             * @brief An event is returned by non-blocking
+             *        communication operations and can be
+             *        asked whether an operation has finished
+             *        or it can be waited for this operation to
+             *        be finished.
+             *
+             * Sends of payloads that the receiver reads from the memory
+             * of the sender are finished when the receiver has read
+             * them, all other sends are finished on return.
+             *
+             */
+            template <typename T_CP>
+            class Event {
+            public:
+
+                using VAddr     = typename graybat::communicationPolicy::VAddr<T_CP>;
+                using Tag       = typename graybat::communicationPolicy::Tag<T_CP>;
+                using MsgType   = typename graybat::communicationPolicy::MsgType<T_CP>;
+                using Context   = typename graybat::communicationPolicy::Context<T_CP>;
+
+                Event(Context context, VAddr vAddr, Tag tag, std::uint64_t pullSeq, T_CP& comm) :
+                    context(context),
+                    vAddr(vAddr),
+                    tag(tag),
+                    buf(nullptr),
+                    size(0),
+                    pullSeq(pullSeq),
+                    done(pullSeq == 0),
+                    comm(&comm) {
+
+                }
+
+                template<typename T_Buf>
+                Event(Context context, VAddr vAddr, Tag tag, T_Buf & buf, bool done, T_CP& comm) :
+                    context(context),
+                    vAddr(vAddr),
+                    tag(tag),
+                    buf(reinterpret_cast<std::int8_t*>(buf.data())),
+                    size(sizeof(typename T_Buf::value_type) * buf.size()),
+                    pullSeq(0),
+                    done(done),
+                    comm(&comm) {
+
+                }
+
+                Event(std::shared_ptr<Operation> operation) :
+                    vAddr(0),
+                    tag(0),
+                    buf(nullptr),
+                    size(0),
+                    pullSeq(0),
+                    done(false),
+                    comm(nullptr),
+                    operation(operation) {
+
+                }
+
+                Event& operator=(const Event&) = default;
+
+                void wait(){
+                    if(operation){
+                        operation->wait();
+                        return;
+                    }
+                    if(!done){
+                        if(pullSeq){
+                            comm->waitPulled(context, vAddr, pullSeq);
+                        }
+                        else {
+                            comm->recvImpl(MsgType::PEER, context, vAddr, tag, buf, size);
+                        }
+                        done = true;
+                    }
+
+                }
+
+                bool ready(){
+                    if(operation){
+                        return operation->ready();
+                    }
+                    if(!done){
+                        if(pullSeq){
+                            done = comm->pulled(context, vAddr, pullSeq);
+                        }
+                        else {
+                            done = comm->asyncRecvImpl(MsgType::PEER, context, vAddr, tag, buf, size);
+                        }
+                    }
+                    return done;
+
+                }
+
+                VAddr source(){
+                    return vAddr;
+                }
+
+                Tag getTag(){
+                    return tag;
+
+                }
+
+            private:
+                Context       context;
+                VAddr         vAddr;
+                Tag           tag;
+                std::int8_t * buf;
+                std::size_t   size;
+                std::uint64_t pullSeq;
+                bool          done;
+                T_CP *        comm;
+                std::shared_ptr<Operation> operation;
+
+            };
+
+        } // namespace shm
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
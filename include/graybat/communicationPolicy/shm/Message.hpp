@@ -0,0 +1,92 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <cstdint> /* std::int8_t */
+#include <vector>  /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace shm {
+
+            /**
+             * @brief Message that was taken from a ring before it was
+             *        asked for, or that is received as a RecvView.
+             *        Messages in the rings themselves are raw records.
+             *
+             */
+            template <typename T_CP>
+            struct Message {
+
+                using ContextID = typename graybat::communicationPolicy::ContextID<T_CP>;
+                using VAddr     = typename graybat::communicationPolicy::VAddr<T_CP>;
+                using Tag       = typename graybat::communicationPolicy::Tag<T_CP>;
+                using MsgType   = typename graybat::communicationPolicy::MsgType<T_CP>;
+
+                Message() :
+                    msgType(MsgType::PEER),
+                    contextID(0),
+                    srcVAddr(0),
+                    tag(0){
+
+                }
+
+                Message(MsgType const msgType, ContextID const contextID, VAddr const srcVAddr, Tag const tag, std::size_t const size) :
+                    msgType(msgType),
+                    contextID(contextID),
+                    srcVAddr(srcVAddr),
+                    tag(tag),
+                    payload(size){
+
+                }
+
+                std::int8_t * getData() {
+                    return payload.data();
+                }
+
+                std::int8_t const * getData() const {
+                    return payload.data();
+                }
+
+                std::size_t getDataSize() const {
+                    return payload.size();
+                }
+
+                MsgType   msgType;
+                ContextID contextID;
+                VAddr     srcVAddr;
+                Tag       tag;
+                std::vector<std::int8_t> payload;
+
+            };
+
+        } // namespace shm
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,376 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// CLIB
+#include <fcntl.h>       /* O_CREAT, O_EXCL, O_RDWR */
+#include <linux/futex.h> /* FUTEX_WAIT, FUTEX_WAKE */
+#include <string.h>      /* memcpy */
+#include <sys/mman.h>    /* shm_open, shm_unlink, mmap, munmap */
+#include <sys/stat.h>    /* fstat */
+#include <sys/syscall.h> /* SYS_futex */
+#include <sys/uio.h>     /* process_vm_readv */
+#include <time.h>        /* timespec */
+#include <unistd.h>      /* ftruncate, close, getpid, syscall */
+
+// STL
+#include <algorithm>     /* std::min */
+#include <atomic>        /* std::atomic */
+#include <cerrno>        /* errno */
+#include <chrono>        /* std::chrono::milliseconds, std::chrono::microseconds */
+#include <climits>       /* INT_MAX */
+#include <cstddef>       /* std::size_t */
+#include <cstdint>       /* std::uint32_t, std::uint64_t, std::int8_t */
+#include <stdexcept>     /* std::runtime_error */
+#include <string>        /* std::string */
+#include <thread>        /* std::this_thread::sleep_for */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace shm {
+
+            // The futex words are part of a shared mapping,
+            // thus they are no private futexes
+            inline void futexWait(std::atomic<std::uint32_t> &word, std::uint32_t const expected){
+                syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+            }
+
+            // Returns false, if nobody woke the waiter within *timeout*
+            inline bool futexWait(std::atomic<std::uint32_t> &word, std::uint32_t const expected, std::chrono::microseconds const timeout){
+                timespec const time {static_cast<time_t>(timeout.count() / 1000000), static_cast<long>(timeout.count() % 1000000 * 1000)};
+                return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &time, nullptr, 0) == 0 || errno != ETIMEDOUT;
+            }
+
+            inline void futexWake(std::atomic<std::uint32_t> &word){
+                syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+            }
+
+            /**
+             * @brief Reads *size* bytes at *address* of process *pid*
+             *        into *dest* by cross memory attach.
+             *
+             */
+            inline bool readRemote(int const pid, std::uint64_t const address, void * dest, std::size_t const size){
+                iovec local {dest, size};
+                iovec remote {reinterpret_cast<void*>(address), size};
+                return process_vm_readv(pid, &local, 1, &remote, 1, 0) == static_cast<ssize_t>(size);
+            }
+
+            enum class RecordKind : std::uint8_t {
+                // The payload follows the header in the ring
+                INLINE = 0,
+                // The receiver reads the payload from the memory of the sender
+                PULL = 1,
+                // The payload is in a shared memory file of its own
+                FILE = 2
+            };
+
+            enum class WaitKind : std::uint32_t {
+                // A message of the other peer
+                MESSAGE = 0,
+                // The other peer pulled the payload of a message
+                PULLED = 1,
+                // The other peer freed space in the ring
+                TAIL = 2
+            };
+
+            /**
+             * @brief Header of a message in a ring, the payload of inline
+             *        messages follows it padded to 8 bytes.
+             *
+             */
+            struct RecordHeader {
+                std::uint64_t size;
+                // Address of the payload in the sender (PULL)
+                // or number of the file (FILE)
+                std::uint64_t address;
+                std::uint32_t contextID;
+                std::uint32_t srcVAddr;
+                std::uint32_t tag;
+                std::int8_t   msgType;
+                RecordKind    kind;
+                std::uint16_t reserved;
+            };
+
+            /**
+             * @brief Shared state of a peer. Other peers ring its doorbell,
+             *        when they changed something it may wait for and it
+             *        sleeps.
+             *
+             */
+            struct PeerSlot {
+                std::atomic<std::uint32_t> doorbell;
+                std::atomic<std::uint32_t> sleeping;
+                // Wait of the sleeping peer: one more than the peer it
+                // waits for or zero, what it waits for and until which
+                // position of their ring
+                std::atomic<std::uint32_t> waitsFor;
+                std::atomic<std::uint32_t> waitKind;
+                std::atomic<std::uint64_t> waitsUntil;
+                std::int32_t  pid;
+                std::uint64_t probeAddress;
+                std::uint64_t probeValue;
+            };
+
+            /**
+             * @brief Positions of a ring, counted in bytes since its
+             *        creation. The head is written by the sender, tail and
+             *        pulled by the receiver.
+             *
+             */
+            struct RingControl {
+                std::atomic<std::uint64_t> head;
+                char headPadding[64 - sizeof(std::uint64_t)];
+                std::atomic<std::uint64_t> tail;
+                // Number of PULL messages the receiver has read
+                std::atomic<std::uint64_t> pulled;
+                char tailPadding[64 - 2 * sizeof(std::uint64_t)];
+            };
+
+            struct SegmentHeader {
+                std::atomic<std::uint64_t> magic;
+                std::uint64_t contextSize;
+                std::uint64_t ringSize;
+                std::atomic<std::uint32_t> nJoined;
+                std::atomic<std::uint32_t> nMapped;
+                std::atomic<std::uint32_t> nProbed;
+                std::atomic<std::uint32_t> maxContextID;
+            };
+
+            /**
+             * @brief Byte ring of a pair of peers in the segment.
+             *
+             */
+            struct Ring {
+                RingControl & control;
+                std::int8_t * data;
+                std::size_t   size;
+
+                void write(std::uint64_t const pos, void const * src, std::size_t const n){
+                    std::size_t const offset = pos % size;
+                    std::size_t const first  = std::min(n, size - offset);
+                    memcpy(data + offset, src, first);
+                    memcpy(data, static_cast<std::int8_t const *>(src) + first, n - first);
+                }
+
+                void read(std::uint64_t const pos, void * dest, std::size_t const n) const {
+                    std::size_t const offset = pos % size;
+                    std::size_t const first  = std::min(n, size - offset);
+                    memcpy(dest, data + offset, first);
+                    memcpy(static_cast<std::int8_t *>(dest) + first, data, n - first);
+                }
+            };
+
+            /**
+             * @brief Shared memory segment of all peers of a context on
+             *        one node, with a ring for each ordered pair of peers.
+             *
+             * The segment is the rendezvous of the peers: the first peer
+             * creates /dev/shm/graybat_<contextName>, the others open it
+             * and every peer draws its vAddr from a counter in it. When
+             * all peers have mapped the segment, the last one removes
+             * its name, thus the next run starts with a new segment. Ring
+             * memory is only committed when it is touched.
+             *
+             */
+            struct Segment {
+
+                static constexpr std::uint64_t magicValue = 0x67726179626174ULL;
+
+                Segment(std::string const & contextName, std::size_t const contextSize, std::size_t const ringSize) :
+                    name("/graybat_" + contextName),
+                    contextSize(contextSize),
+                    ringSize((ringSize + 63) / 64 * 64),
+                    peersOffset(align(sizeof(SegmentHeader))),
+                    canReadOffset(peersOffset + align(contextSize * sizeof(PeerSlot))),
+                    ringsOffset(canReadOffset + align(contextSize * contextSize)),
+                    ringStride(sizeof(RingControl) + this->ringSize),
+                    size(ringsOffset + contextSize * contextSize * ringStride),
+                    probe(0){
+
+                    open();
+
+                    vAddr = header().nJoined++;
+                    if(vAddr >= contextSize){
+                        throw std::runtime_error("Shared memory segment /dev/shm" + name + " is already complete, remove it if it is left over from an aborted run.");
+                    }
+
+                    probe = magicValue ^ static_cast<std::uint64_t>(getpid());
+                    peer(vAddr).pid = getpid();
+                    peer(vAddr).probeAddress = reinterpret_cast<std::uint64_t>(&probe);
+                    peer(vAddr).probeValue = probe;
+
+                    if(arrive(header().nMapped)){
+                        shm_unlink(name.c_str());
+                    }
+
+                    // Payloads of a peer can only be pulled by peers that may
+                    // read its memory, which depends on the ptrace policy
+                    for(std::size_t owner = 0; owner < contextSize; ++owner){
+                        std::uint64_t value = 0;
+                        canRead(vAddr, owner) = readRemote(peer(owner).pid, peer(owner).probeAddress, &value, sizeof(value))
+                                                && value == peer(owner).probeValue;
+                    }
+                    arrive(header().nProbed);
+
+                }
+
+                Segment(Segment const &) = delete;
+                Segment& operator=(Segment const &) = delete;
+
+                ~Segment(){
+                    munmap(base, size);
+                }
+
+                std::string const name;
+                std::size_t const contextSize;
+                std::size_t const ringSize;
+                std::uint32_t vAddr;
+
+                SegmentHeader& header(){
+                    return *reinterpret_cast<SegmentHeader*>(base);
+                }
+
+                PeerSlot& peer(std::size_t const peer_i){
+                    return reinterpret_cast<PeerSlot*>(base + peersOffset)[peer_i];
+                }
+
+                std::int8_t& canRead(std::size_t const reader, std::size_t const owner){
+                    return reinterpret_cast<std::int8_t*>(base + canReadOffset)[reader * contextSize + owner];
+                }
+
+                Ring ring(std::size_t const srcVAddr, std::size_t const destVAddr){
+                    std::int8_t * ringBase = base + ringsOffset + (srcVAddr * contextSize + destVAddr) * ringStride;
+                    return Ring{*reinterpret_cast<RingControl*>(ringBase), ringBase + sizeof(RingControl), ringSize};
+                }
+
+            private:
+                std::size_t const peersOffset;
+                std::size_t const canReadOffset;
+                std::size_t const ringsOffset;
+                std::size_t const ringStride;
+                std::size_t const size;
+                std::int8_t * base;
+                std::uint64_t probe;
+
+                static std::size_t align(std::size_t const n){
+                    return (n + 63) / 64 * 64;
+                }
+
+                void open(){
+                    while(true){
+                        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                        if(fd >= 0){
+                            create(fd);
+                            return;
+                        }
+                        if(errno != EEXIST){
+                            throw std::runtime_error("Could not create shared memory segment /dev/shm" + name + ".");
+                        }
+
+                        fd = shm_open(name.c_str(), O_RDWR, 0600);
+                        if(fd >= 0){
+                            attach(fd);
+                            return;
+                        }
+                        // Removed in between by the last peer of a previous
+                        // run, thus try to create it again
+                        if(errno != ENOENT){
+                            throw std::runtime_error("Could not open shared memory segment /dev/shm" + name + ".");
+                        }
+                    }
+
+                }
+
+                void map(int const fd){
+                    void * address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    close(fd);
+                    if(address == MAP_FAILED){
+                        throw std::runtime_error("Could not map shared memory segment /dev/shm" + name + ".");
+                    }
+                    base = static_cast<std::int8_t*>(address);
+                }
+
+                void create(int const fd){
+                    if(ftruncate(fd, size) != 0){
+                        close(fd);
+                        shm_unlink(name.c_str());
+                        throw std::runtime_error("Could not resize shared memory segment /dev/shm" + name + ".");
+                    }
+                    map(fd);
+
+                    // The file is zero filled, which is the initial state
+                    // of all counters, only the layout is published
+                    header().contextSize = contextSize;
+                    header().ringSize = ringSize;
+                    header().magic = magicValue;
+
+                }
+
+                void attach(int const fd){
+                    // The creator resizes the file at once
+                    struct stat status;
+                    while(fstat(fd, &status) == 0 && status.st_size == 0){
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    if(static_cast<std::size_t>(status.st_size) != size){
+                        close(fd);
+                        throw std::runtime_error("Shared memory segment /dev/shm" + name + " was created with another context size or ring size.");
+                    }
+                    map(fd);
+
+                    while(header().magic != magicValue){
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    if(header().contextSize != contextSize || header().ringSize != ringSize){
+                        throw std::runtime_error("Shared memory segment /dev/shm" + name + " was created with another context size or ring size.");
+                    }
+
+                }
+
+                /**
+                 * @brief Barrier of all peers on *counter*, returns true
+                 *        for the last peer that arrived.
+                 *
+                 */
+                bool arrive(std::atomic<std::uint32_t> &counter){
+                    std::uint32_t arrived = ++counter;
+                    if(arrived == contextSize){
+                        futexWake(counter);
+                        return true;
+                    }
+                    while(arrived < contextSize){
+                        futexWait(counter, arrived);
+                        arrived = counter;
+                    }
+                    return false;
+
+                }
+
+            };
+
+        } // namespace shm
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
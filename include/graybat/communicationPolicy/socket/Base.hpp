@@ -27,6 +27,11 @@
 #include <vector> /* std::vector */
 #include <thread> /* std::thread */
 #include <exception> /* std::runtime_error */
+#include <condition_variable> /* std::condition_variable */
+#include <algorithm> /* std::max, std::find */
+#include <memory> /* std::shared_ptr, std::make_shared */
+#include <atomic> /* std::atomic */
+#include <chrono> /* std::chrono::microseconds */
 
 // BOOST
 #include <boost/optional.hpp>
@@ -39,8 +44,13 @@ namespace hana = boost::hana;
 // GrayBat
 #include <graybat/communicationPolicy/Base.hpp>          /* graybat::communicationPolicy::Base */
 #include <graybat/communicationPolicy/Traits.hpp>        /* cp related types */
+#include <graybat/communicationPolicy/RecvView.hpp>      /* RecvView */
 #include <graybat/communicationPolicy/socket/Traits.hpp> /* socket related types */
-#include <graybat/utils/MultiKeyMap.hpp>                 /* utils::MessageBox */
+#include <graybat/communicationPolicy/socket/SendState.hpp> /* SendState */
+#include <graybat/communicationPolicy/socket/Channel.hpp> /* SendChannel */
+#include <graybat/communicationPolicy/socket/SendEngine.hpp> /* SendEngine */
+#include <graybat/communicationPolicy/socket/SignalingMessage.hpp> /* SignalingMessage */
+#include <graybat/utils/StripedMessageBox.hpp>           /* utils::StripedMessageBox */
 
 namespace graybat {
 
@@ -66,16 +76,46 @@ namespace graybat {
                 using Socket              = graybat::communicationPolicy::socket::Socket<CommunicationPolicy>;
                 using ContextName         = graybat::communicationPolicy::socket::ContextName<CommunicationPolicy>;
 
+                template <typename T>
+                using RecvView            = graybat::communicationPolicy::RecvView<T, Message>;
+
+                // Receives of a channel are served by the inbox like
+                // any other receive, thus only sends are replaced
+                template <typename T_Buffer>
+                using SendChannel         = graybat::communicationPolicy::socket::SendChannel<CommunicationPolicy, T_Buffer>;
+
                 // Members
                 const Uri masterUri;
                 const size_t contextSize;
                 const ContextName contextName;
-                unsigned maxMsgID;
-                std::mutex sendMtx;
+                std::atomic<unsigned> maxMsgID;
                 std::map<ContextID, std::map<VAddr, std::size_t> > sendSocketMappings;
-                utils::MessageBox<Message, MsgType, ContextID, VAddr, Tag> inBox;
-                utils::MessageBox<Message, MsgType, ContextID, VAddr, Tag> ctrlBox;
+                // Guards sendSocketMappings between splitContext and the recv handler
+                std::mutex sendSocketMappingsMtx;
+                utils::StripedMessageBox<Message, MsgType, ContextID, VAddr, Tag> inBox;
+
+                // Delivery confirmation, counted in peer messages per send socket
+                const bool confirmDelivery;
+                const std::size_t confirmBatchSize;
+                std::vector<std::size_t> confirmedPeerMsgs;
+                std::vector<std::size_t> recvPeerMsgs;
+                std::vector<std::size_t> ackedPeerMsgs;
+                std::mutex confirmMtx;
+                std::condition_variable confirmCondition;
+
+                // Peer messages reference the user buffer instead of a copy
+                const bool zeroCopySend;
+
+                // Messages are sent by I/O threads from a queue per send socket
+                const std::size_t sendThreads;
 
+                // Small peer messages to the same peer are sent as one batch
+                const std::size_t coalesceSize;
+                const std::size_t coalesceDelay;
+
+                // Broadcast and reduce pipeline large payloads in segments of this size
+                const std::size_t collectiveSegmentSize;
+                SendEngine<Message> sendEngine;
 
                 std::map<ContextID, Context> contexts;
 
@@ -111,17 +151,20 @@ namespace graybat {
                 void connectToSocket(T_Socket& socket, std::string const signalingUri) = delete;
 
                 template <typename T_Socket>
-                void sendToSocket(T_Socket& socket, std::stringstream const ss) = delete;
+                void sendToSocket(T_Socket& socket, SignalingMessage const & message) = delete;
 
                 template <typename T_Socket, typename T_Data>
                 void sendToSocket(T_Socket& socket, T_Data const data) = delete;
 
                 template <typename T_Socket>
-                void recvFromSocket(T_Socket& socket, std::stringstream ss) = delete;
+                void recvFromSocket(T_Socket& socket, SignalingMessage & message) = delete;
 
                 template <typename T_Socket>
                 void recvFromSocket (T_Socket& socket, Message & message) = delete;
 
+                template <typename T_Socket>
+                bool tryRecvFromSocket (T_Socket& socket, Message & message) = delete;
+
                 void createSocketsToPeers() = delete;
 
                 // P2P INTERFACE
@@ -176,16 +219,59 @@ namespace graybat {
                 template <typename T_Recv>
                 Event recv(const Context context, T_Recv& recvData);
 
+                /**
+                 * @brief Non blocking receive of a message of any peer with any tag of the *context*.
+                 *
+                 * @return False, if no message has arrived. Otherwise the message is received into
+                 *         *recvData* and its source and tag are returned in *srcVAddr* and *tag*.
+                 */
+                template <typename T_Recv>
+                bool tryRecv(const Context context, T_Recv& recvData, VAddr& srcVAddr, Tag& tag);
+
+                /**
+                 * @brief Blocking receive of a message from peer with virtual address srcVAddr,
+                 *        whose payload is handed over without a copy.
+                 *
+                 * @param[in]  srcVAddr   VAddr of peer that sended the message
+                 * @param[in]  tag        Description of the message to better distinguish messages types
+                 * @param[in]  context    Context in which both sender and receiver are included
+                 *
+                 * @return Read-only view of the received elements of type T, that owns the message
+                 */
+                template <typename T>
+                RecvView<T> recv(const VAddr srcVAddr, const Tag tag, const Context context);
+
                 template <typename T_Recv>
                 Event asyncRecv(const VAddr srcVAddr, const Tag tag, const Context context, T_Recv& recvData);
 
+                /**
+                 * @brief Binds *sendData* to repeated sends to the peer with
+                 *        virtual address destVAddr. The send socket and the
+                 *        message header are resolved once.
+                 *
+                 * @return Channel, that sends the current content of *sendData* on start()
+                 */
+                template <typename T_Send>
+                SendChannel<T_Send> bindSend(const VAddr destVAddr, const Tag tag, const Context context, const T_Send& sendData);
+
+                /**
+                 * @brief Sends the batches of coalesced messages without
+                 *        waiting for the size or time threshold.
+                 *
+                 */
+                void flush();
+
                 // EVENT INTERFACE
                 bool ready(const MsgID msgID, const Context context, const VAddr vAddr, const Tag tag);
+                void waitReady(const MsgID msgID, const Context context, const VAddr vAddr, const Tag tag);
 
                 // CONTEXT INTERFACE
                 Context getGlobalContext();
                 Context splitContext(const bool isMember, const Context oldContext);
 
+                // COLLECTIVE INTERFACE
+                std::size_t segmentSize(const Context context);
+
 
                 // SIGNALING METHODS
                 template <typename T_Socket>
@@ -198,12 +284,13 @@ namespace graybat {
                 VAddr getVAddr(T_Socket &socket, ContextID const contextID, Uri const uri, Uri const ctrlUri);
 
                 template <typename T_Socket>
-                std::pair<Uri,Uri> getUri(T_Socket& socket, ContextID const contextID, VAddr const vAddr);
+                std::map<VAddr, std::pair<Uri,Uri> > getPhoneBook(T_Socket& socket, ContextID const contextID, size_t const contextSize);
 
 
                 // Auxilary
                 template <typename T_Send>
-                void asyncSendImpl(MsgType const msgType, MsgID const msgID, Context const context,VAddr const destVAddr, Tag const tag, T_Send & sendData);
+                MsgID asyncSendImpl(MsgType const msgType, MsgID const msgID, Context const context,VAddr const destVAddr, Tag const tag, T_Send & sendData,
+                                    std::shared_ptr<SendState> const & sendState = nullptr);
 
                 template <typename T_Recv>
                 void recvImpl(MsgType const msgType, Context const context,VAddr const destVAddr, Tag const tag, T_Recv & recvData);
@@ -220,6 +307,8 @@ namespace graybat {
 
                 MsgID getMsgID();
 
+                void confirm(std::size_t const sendSocket_i);
+                void deliver(Message & message);
                 void handleRecv();
                 void handleCtrl();
 
@@ -233,7 +322,13 @@ namespace graybat {
                     contextName(config.contextName),
                     maxMsgID(0),
                     inBox(config.maxBufferSize),
-                    ctrlBox(config.maxBufferSize){
+                    confirmDelivery(config.confirmDelivery),
+                    confirmBatchSize(std::max(config.confirmBatchSize, static_cast<std::size_t>(1))),
+                    zeroCopySend(config.zeroCopySend),
+                    sendThreads(config.sendThreads),
+                    coalesceSize(config.coalesceSize),
+                    coalesceDelay(config.coalesceDelay),
+                    collectiveSegmentSize(config.segmentSize){
 
             }
 
@@ -259,11 +354,13 @@ namespace graybat {
                 initialContext = Context(contextID, vAddr, contextSize);
                 contexts[initialContext.getID()] = initialContext;
 
-                // Retrieve for uris of other peers from signaling process for the initial context
+                // Retrieve the uris of all peers of the initial context at once,
+                // the signaling process replies when all peers are registered
+                auto const uris = getPhoneBook(static_cast<CommunicationPolicy*>(this)->signalingSocket, initialContext.getID(), initialContext.size());
                 for(auto const &vAddr : initialContext){                    
                     Uri remoteUri;
                     Uri ctrlUri;
-                    std::tie(remoteUri, ctrlUri) = getUri(static_cast<CommunicationPolicy*>(this)->signalingSocket, initialContext.getID(), vAddr);
+                    std::tie(remoteUri, ctrlUri) = uris.at(vAddr);
                     phoneBook[initialContext.getID()][vAddr] = remoteUri;
                     ctrlPhoneBook[initialContext.getID()][vAddr] = ctrlUri;
                     inversePhoneBook[initialContext.getID()][remoteUri] = vAddr;
@@ -273,6 +370,9 @@ namespace graybat {
                 // Create socket connection to other peers
                 // Create socketmapping from initial context to sockets of VAddrs
                 static_cast<CommunicationPolicy*>(this)->createSocketsToPeers();
+                confirmedPeerMsgs.assign(initialContext.size(), 0);
+                recvPeerMsgs.assign(initialContext.size(), 0);
+                ackedPeerMsgs.assign(initialContext.size(), 0);
 
                 for(auto const &vAddr : initialContext){                    
                     sendSocketMappings[initialContext.getID()][vAddr] = vAddr;
@@ -283,6 +383,19 @@ namespace graybat {
 
                 }
 
+                if(coalesceSize){
+                    sendEngine.coalesce(coalesceSize, std::chrono::microseconds(coalesceDelay), [this](std::size_t const sendSocket_i, std::vector<Message> &messages){
+                            Message batch(MsgType::BATCH, initialContext.getID(), initialContext.getVAddr(), messages);
+                            static_cast<CommunicationPolicy*>(this)->sendToSocket(static_cast<CommunicationPolicy*>(this)->sendSockets.at(sendSocket_i), batch);
+                        });
+                }
+
+                // From now on the send sockets belong to the I/O threads
+                sendEngine.start(initialContext.size(), sendThreads, [this](std::size_t const sendSocket_i, bool const ctrl, Message &message){
+                        CommunicationPolicy *cp = static_cast<CommunicationPolicy*>(this);
+                        cp->sendToSocket(ctrl ? cp->ctrlSendSockets.at(sendSocket_i) : cp->sendSockets.at(sendSocket_i), message);
+                    });
+
                 // Create thread which recv all messages to this peer
                 recvHandler = std::thread(&Base<CommunicationPolicy>::handleRecv, this);
                 ctrlHandler = std::thread(&Base<CommunicationPolicy>::handleCtrl, this);
@@ -292,15 +405,18 @@ namespace graybat {
             template <typename T_CommunicationPolicy>
             auto Base<T_CommunicationPolicy>::deinit()
             -> void {
-                std::stringstream ss;
-                ss << static_cast<size_t>(MsgType::DESTRUCT) << " " << contextName;
-                static_cast<CommunicationPolicy*>(this)->sendToSocket(static_cast<CommunicationPolicy*>(this)->signalingSocket, ss);
+                SignalingMessage request;
+                request << MsgType::DESTRUCT << contextName;
+                static_cast<CommunicationPolicy*>(this)->sendToSocket(static_cast<CommunicationPolicy*>(this)->signalingSocket, request);
 
                 std::array<unsigned, 1>  null;
                 static_cast<CommunicationPolicy*>(this)->asyncSendImpl(MsgType::DESTRUCT, 0, initialContext, initialContext.getVAddr(), 0, null);
                 recvHandler.join();
                 ctrlHandler.join();
 
+                // Flushes the messages to other peers, before the sockets are closed
+                sendEngine.stop();
+
             }
 
             template <typename T_CommunicationPolicy>
@@ -332,10 +448,16 @@ namespace graybat {
                 using Event               = graybat::communicationPolicy::Event<CommunicationPolicy>;
 
                 //std::cout << "send method[" << context.getVAddr() << "]: " << context.getID() << " " << destVAddr << " " << tag << std::endl;
-                MsgID msgID = getMsgID();
-                asyncSendImpl(MsgType::PEER, msgID, context, destVAddr, tag, sendData);
+                // A copied message is completed on return, if
+                // the delivery does not need to be confirmed
+                std::shared_ptr<SendState> sendState;
+                if(zeroCopySend && sendData.size() > 0){
+                    sendState = std::make_shared<SendState>();
+                }
+                // The event is identified by the sequence number of the link
+                MsgID seq = asyncSendImpl(MsgType::PEER, 0, context, destVAddr, tag, sendData, sendState);
 
-                return Event(msgID, context, destVAddr, tag, *static_cast<CommunicationPolicy*>(this));
+                return Event(seq, context, destVAddr, tag, !confirmDelivery && !sendState, sendState, *static_cast<CommunicationPolicy*>(this));
 
             }
 
@@ -366,6 +488,42 @@ namespace graybat {
             }
 
 
+            template <typename T_CommunicationPolicy>
+            template <typename T_Recv>
+            auto Base<T_CommunicationPolicy>::tryRecv(const graybat::communicationPolicy::Context<T_CommunicationPolicy> context,
+                                                      T_Recv& recvData,
+                                                      graybat::communicationPolicy::VAddr<T_CommunicationPolicy>& srcVAddr,
+                                                      graybat::communicationPolicy::Tag<T_CommunicationPolicy>& tag)
+            -> bool
+            {
+                using Message = graybat::communicationPolicy::socket::Message<T_CommunicationPolicy>;
+
+                hana::tuple<MsgType, ContextID, VAddr, Tag> keys;
+                bool result = false;
+                Message message(std::move(inBox.tryDequeue(result, keys, MsgType::PEER, context.getID())));
+                if(result){
+                    srcVAddr = hana::at(keys, hana::size_c<2>);
+                    tag = hana::at(keys, hana::size_c<3>);
+                    memcpy (static_cast<void*>(recvData.data()),
+                            static_cast<std::int8_t*>(message.getData()),
+                            sizeof(typename T_Recv::value_type) * recvData.size());
+                }
+                return result;
+
+            }
+
+
+            template <typename T_CommunicationPolicy>
+            template <typename T>
+            auto Base<T_CommunicationPolicy>::recv(const graybat::communicationPolicy::VAddr<T_CommunicationPolicy> srcVAddr,
+                                                   const graybat::communicationPolicy::Tag<T_CommunicationPolicy> tag,
+                                                   const graybat::communicationPolicy::Context<T_CommunicationPolicy> context)
+            -> RecvView<T>
+            {
+                return RecvView<T>(inBox.waitDequeue(MsgType::PEER, context.getID(), srcVAddr, tag));
+            }
+
+
             template <typename T_CommunicationPolicy>
             template <typename T_Recv>
             auto Base<T_CommunicationPolicy>::asyncRecv(const graybat::communicationPolicy::VAddr<T_CommunicationPolicy> srcVAddr,
@@ -380,31 +538,61 @@ namespace graybat {
             }
 
             template <typename T_CommunicationPolicy>
-            auto Base<T_CommunicationPolicy>::ready(const graybat::communicationPolicy::MsgID<T_CommunicationPolicy> msgID,
-                                                    const graybat::communicationPolicy::Context<T_CommunicationPolicy> context,
-                                                    const graybat::communicationPolicy::VAddr<T_CommunicationPolicy> vAddr,
-                                                    const graybat::communicationPolicy::Tag<T_CommunicationPolicy> tag)
-            -> bool
+            template <typename T_Send>
+            auto Base<T_CommunicationPolicy>::bindSend(const graybat::communicationPolicy::VAddr<T_CommunicationPolicy> destVAddr,
+                                                       const graybat::communicationPolicy::Tag<T_CommunicationPolicy> tag,
+                                                       const graybat::communicationPolicy::Context<T_CommunicationPolicy> context,
+                                                       const T_Send& sendData)
+            -> SendChannel<T_Send>
             {
-                using CommunicationPolicy = T_CommunicationPolicy;
-                using Message             = graybat::communicationPolicy::socket::Message<CommunicationPolicy>;
-                using MsgType             = graybat::communicationPolicy::MsgType<CommunicationPolicy>;
+                using Message             = graybat::communicationPolicy::socket::Message<T_CommunicationPolicy>;
 
-                Message message(std::move(ctrlBox.waitDequeue(MsgType::CONFIRM, context.getID(), vAddr, tag)));
-
-                // size_t    msgOffset = 0;
-                // MsgType   remoteMsgType;
-                // MsgID     remoteMsgID;
+                std::size_t sendSocket_i = sendSocketMappings.at(context.getID()).at(destVAddr);
+                return SendChannel<T_Send>(*static_cast<CommunicationPolicy*>(this), sendSocket_i, destVAddr, tag, context, sendData,
+                                           Message::makeHeader(MsgType::PEER, getMsgID(), context.getID(), context.getVAddr(), tag));
+            }
 
+            template <typename T_CommunicationPolicy>
+            auto Base<T_CommunicationPolicy>::flush()
+            -> void
+            {
+                sendEngine.flush();
+            }
 
-                if(message.getMsgID() == msgID){
+            /**
+             * @brief A send is ready when the receiver confirmed at least
+             *        *seq* peer messages on the link to *vAddr*.
+             *
+             */
+            template <typename T_CommunicationPolicy>
+            auto Base<T_CommunicationPolicy>::ready(const graybat::communicationPolicy::MsgID<T_CommunicationPolicy> seq,
+                                                    const graybat::communicationPolicy::Context<T_CommunicationPolicy> context,
+                                                    const graybat::communicationPolicy::VAddr<T_CommunicationPolicy> vAddr,
+                                                    const graybat::communicationPolicy::Tag<T_CommunicationPolicy>)
+            -> bool
+            {
+                if(!confirmDelivery){
                     return true;
                 }
-                else {
-                    ctrlBox.enqueue(std::move(message), MsgType::CONFIRM, context.getID(), vAddr, tag);
-                }
+                std::size_t sendSocket_i = sendSocketMappings.at(context.getID()).at(vAddr);
+                std::lock_guard<std::mutex> confirmLock(confirmMtx);
+                return ackedPeerMsgs.at(sendSocket_i) >= seq;
 
-                return false;
+            }
+
+            template <typename T_CommunicationPolicy>
+            auto Base<T_CommunicationPolicy>::waitReady(const graybat::communicationPolicy::MsgID<T_CommunicationPolicy> seq,
+                                                        const graybat::communicationPolicy::Context<T_CommunicationPolicy> context,
+                                                        const graybat::communicationPolicy::VAddr<T_CommunicationPolicy> vAddr,
+                                                        const graybat::communicationPolicy::Tag<T_CommunicationPolicy>)
+            -> void
+            {
+                if(!confirmDelivery){
+                    return;
+                }
+                std::size_t sendSocket_i = sendSocketMappings.at(context.getID()).at(vAddr);
+                std::unique_lock<std::mutex> confirmLock(confirmMtx);
+                confirmCondition.wait(confirmLock, [&]{ return ackedPeerMsgs.at(sendSocket_i) >= seq; });
 
             }
 
@@ -418,6 +606,13 @@ namespace graybat {
             }
 
 
+            template <typename T_CommunicationPolicy>
+            auto Base<T_CommunicationPolicy>::segmentSize(const graybat::communicationPolicy::Context<T_CommunicationPolicy>)
+            -> std::size_t {
+                return collectiveSegmentSize;
+            }
+
+
             template <typename T_CommunicationPolicy>
             auto Base<T_CommunicationPolicy>::splitContext(const bool isMember,
                                                            const graybat::communicationPolicy::Context<T_CommunicationPolicy> oldContext)
@@ -480,26 +675,30 @@ namespace graybat {
 
                     static_cast<CommunicationPolicy*>(this)->recvImpl(MsgType::SPLIT, oldContext, 0, 0, newContextWhiteList);
 
-                    newContext = Context(newContextID[0], oldContext.getVAddr(), newContextWhiteList);
+                    // Peers are numbered by their position in the whitelist,
+                    // thus the vAddrs of every context are 0..size-1
+                    VAddr newVAddr = std::find(newContextWhiteList.begin(), newContextWhiteList.end(), oldContext.getVAddr()) - newContextWhiteList.begin();
+                    newContext = Context(newContextID[0], newVAddr, newContextWhiteList.size());
                     contexts[newContext.getID()] = newContext;
 
                     //std::cout  << oldContext.getVAddr() << " check 1" << std::endl;
                     // Update phonebook for new context
-                    for(auto const &vAddr : newContext){                        
-                        Uri remoteUri = phoneBook[oldContext.getID()][vAddr];
-                        Uri ctrlUri   = ctrlPhoneBook[oldContext.getID()][vAddr];
+                    for(auto const &vAddr : newContext){
+                        VAddr oldVAddr = newContextWhiteList.at(vAddr);
+                        Uri remoteUri = phoneBook.at(oldContext.getID()).at(oldVAddr);
+                        Uri ctrlUri   = ctrlPhoneBook.at(oldContext.getID()).at(oldVAddr);
                         phoneBook[newContext.getID()][vAddr] = remoteUri;
                         ctrlPhoneBook[newContext.getID()][vAddr] = ctrlUri;
-                        inversePhoneBook[newContext.getID()][remoteUri]   = inversePhoneBook[oldContext.getID()][remoteUri];
-                        inverseCtrlPhoneBook[newContext.getID()][ctrlUri] = inverseCtrlPhoneBook[oldContext.getID()][ctrlUri];
+                        inversePhoneBook[newContext.getID()][remoteUri]   = vAddr;
+                        inverseCtrlPhoneBook[newContext.getID()][ctrlUri] = vAddr;
 
                     }
 
                     //std::cout  << oldContext.getVAddr() << " check 2" << std::endl;
                     // Create mappings to sockets for new context
-                    for(auto const &vAddr : newContext){                        
-                        Uri uri = phoneBook.at(oldContext.getID()).at(vAddr);
-                        VAddr oldVAddr = inversePhoneBook.at(oldContext.getID()).at(uri);
+                    std::lock_guard<std::mutex> mappingsLock(sendSocketMappingsMtx);
+                    for(auto const &vAddr : newContext){
+                        VAddr oldVAddr = newContextWhiteList.at(vAddr);
                         sendSocketMappings[newContext.getID()][vAddr] = sendSocketMappings.at(oldContext.getID()).at(oldVAddr);
 
                     }
@@ -534,14 +733,14 @@ namespace graybat {
             -> graybat::communicationPolicy::ContextID<T_CommunicationPolicy> {
                 ContextID contextID = 0;
                 // Send vAddr request
-                std::stringstream ss;
-                ss << static_cast<size_t>(MsgType::CONTEXT_INIT) << " " << contextSize;
-                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, ss);
+                SignalingMessage request;
+                request << MsgType::CONTEXT_INIT << static_cast<std::uint64_t>(contextSize);
+                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, request);
 
                 // Recv vAddr
-                std::stringstream sss;
-                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, sss);
-                sss >> contextID;
+                SignalingMessage reply;
+                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, reply);
+                reply >> contextID;
                 return contextID;
 
             }
@@ -556,15 +755,14 @@ namespace graybat {
                 ContextID contextID = 0;
 
                 // Send vAddr request
-                std::stringstream ss;
-                ss << static_cast<size_t>(MsgType::CONTEXT_REQUEST) << " " << contextName << " ";
-
-                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, ss);
+                SignalingMessage request;
+                request << MsgType::CONTEXT_REQUEST << contextName;
+                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, request);
 
                 // Recv vAddr
-                std::stringstream sss;
-                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, sss);
-                sss >> contextID;
+                SignalingMessage reply;
+                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, reply);
+                reply >> contextID;
                 return contextID;
 
             }
@@ -579,54 +777,56 @@ namespace graybat {
 
                 VAddr vAddr(0);
                 // Send vAddr request
-                std::stringstream ss;
-                ss << static_cast<size_t>(MsgType::VADDR_REQUEST) << " " << contextID << " " << uri << " " << ctrlUri << " ";
-                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, ss);
+                SignalingMessage request;
+                request << MsgType::VADDR_REQUEST << contextID << uri << ctrlUri;
+                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, request);
 
                 // Recv vAddr
-                std::stringstream sss;
-                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, sss);
-                sss >> vAddr;
+                SignalingMessage reply;
+                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, reply);
+                reply >> vAddr;
 
                 return vAddr;
 
             }
 
 
+            /**
+             * @brief Looks up the uris of all *contextSize* peers of a
+             *        context with a single request. The signaling process
+             *        delays its reply until all peers have registered.
+             *
+             */
             template <typename T_CommunicationPolicy>
             template <typename T_Socket>
-            auto Base<T_CommunicationPolicy>::getUri(T_Socket& socket,
-                                                     graybat::communicationPolicy::ContextID<T_CommunicationPolicy> const contextID,
-                                                     graybat::communicationPolicy::VAddr<T_CommunicationPolicy> const vAddr)
-            -> std::pair<graybat::communicationPolicy::socket::Uri<T_CommunicationPolicy>,
-                    graybat::communicationPolicy::socket::Uri<T_CommunicationPolicy>
-            > {
-
-                MsgType type = MsgType::RETRY;
-
-                while(type == MsgType::RETRY){
-                    // Send vAddr lookup
-                    std::stringstream ss;
-                    ss << static_cast<size_t>(MsgType::VADDR_LOOKUP) << " " << contextID << " " << vAddr;
-                    static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, ss);
-
-                    // Recv uri
-                    std::string msgTypeStr;
-                    std::string remoteUri;
-                    std::string ctrlUri;
-                    std::stringstream sss;
-                    static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, sss);
-                    sss >> msgTypeStr;
-                    type = static_cast<MsgType>(std::stoi(msgTypeStr));
-                    if(type == MsgType::ACK){
-                        sss >> remoteUri;
-                        sss >> ctrlUri;
-                        return std::make_pair(remoteUri, ctrlUri);
-
-                    }
+            auto Base<T_CommunicationPolicy>::getPhoneBook(T_Socket& socket, ContextID const contextID, size_t const contextSize)
+            -> std::map<VAddr, std::pair<Uri, Uri> > {
+
+                // Send phone book lookup
+                SignalingMessage request;
+                request << MsgType::PHONEBOOK_LOOKUP << contextID << static_cast<std::uint64_t>(contextSize);
+                static_cast<CommunicationPolicy*>(this)->sendToSocket(socket, request);
+
+                // Recv uris of all peers
+                SignalingMessage reply;
+                static_cast<CommunicationPolicy*>(this)->recvFromSocket(socket, reply);
+
+                MsgType type;
+                std::uint64_t nEntries = 0;
+                reply >> type >> nEntries;
+                if(type != MsgType::ACK){
+                    throw std::runtime_error("Signaling process refused the phone book lookup.");
+                }
 
+                std::map<VAddr, std::pair<Uri, Uri> > uris;
+                for(std::uint64_t entry_i = 0; entry_i < nEntries; ++entry_i){
+                    VAddr vAddr;
+                    Uri remoteUri;
+                    Uri ctrlUri;
+                    reply >> vAddr >> remoteUri >> ctrlUri;
+                    uris[vAddr] = std::make_pair(remoteUri, ctrlUri);
                 }
-                return std::make_pair(std::string(""), std::string(""));
+                return uris;
 
             }
 
@@ -638,38 +838,43 @@ namespace graybat {
                                                             graybat::communicationPolicy::Context<T_CommunicationPolicy> const context,
                                                             graybat::communicationPolicy::VAddr<T_CommunicationPolicy> const destVAddr,
                                                             graybat::communicationPolicy::Tag<T_CommunicationPolicy> const tag,
-                                                            T_Send & sendData)
-            -> void {
+                                                            T_Send & sendData,
+                                                            std::shared_ptr<SendState> const & sendState)
+            -> graybat::communicationPolicy::MsgID<T_CommunicationPolicy> {
 
                 using Message   = graybat::communicationPolicy::socket::Message<T_CommunicationPolicy>;
 
                 //std::cout << "send msg: " << static_cast<int>(msgType) << " " << msgID << " " << context.getID() << " " << destVAddr << "(socket_i " <<  sendSocketMappings.at(context.getID()).at(destVAddr)<< ") " << tag << std::endl;
 
                 // Create message
-                Message message(msgType, msgID, context.getID(), context.getVAddr(), tag, sendData);
+                Message message(sendState ? Message(msgType, msgID, context.getID(), context.getVAddr(), tag, sendData, sendState)
+                                          : Message(msgType, msgID, context.getID(), context.getVAddr(), tag, sendData));
 
                 std::size_t sendSocket_i  = sendSocketMappings.at(context.getID()).at(destVAddr);
-                Socket &sendSocket = static_cast<CommunicationPolicy*>(this)->sendSockets.at(sendSocket_i);
-                Socket &ctrlSendSocket = static_cast<CommunicationPolicy*>(this)->ctrlSendSockets.at(sendSocket_i);
 
+                // Peer messages are numbered per link for the delivery confirmation
+                MsgID seq = 0;
+                if(msgType == MsgType::PEER){
+                    seq = sendEngine.nextSeq(sendSocket_i);
+                }
 
-                sendMtx.lock();
                 if(msgType == MsgType::CONFIRM){
-                    static_cast<CommunicationPolicy*>(this)->sendToSocket(ctrlSendSocket, message.getMessage());
+                    sendEngine.enqueue(sendSocket_i, seq, true, std::move(message));
                 }
                 else {
 
                     if(msgType == MsgType::DESTRUCT){
                         Message message2(msgType, msgID, context.getID(), context.getVAddr(), tag, sendData);
-                        static_cast<CommunicationPolicy*>(this)->sendToSocket(sendSocket, message.getMessage());
-                        static_cast<CommunicationPolicy*>(this)->sendToSocket(ctrlSendSocket, message2.getMessage());
+                        sendEngine.enqueue(sendSocket_i, seq, false, std::move(message));
+                        sendEngine.enqueue(sendSocket_i, seq, true, std::move(message2));
 
                     }
                     else {
-                        static_cast<CommunicationPolicy*>(this)->sendToSocket(sendSocket, message.getMessage());
+                        sendEngine.enqueue(sendSocket_i, seq, false, std::move(message));
                     }
                 }
-                sendMtx.unlock();
+
+                return seq;
 
             }
 
@@ -714,7 +919,7 @@ namespace graybat {
                         static_cast<std::int8_t*>(message.getData()),
                         sizeof(typename T_Recv::value_type) * recvData.size());
 
-                return Event(getMsgID(), context, destVAddr, tag, *(static_cast<CommunicationPolicy*>(this)));
+                return Event(getMsgID(), context, destVAddr, tag, true, *(static_cast<CommunicationPolicy*>(this)));
 
             }
 
@@ -774,6 +979,28 @@ namespace graybat {
             }
 
 
+            /**
+             * @brief Confirms all peer messages received so far on the
+             *        link of *sendSocket_i* with a single cumulative ack.
+             *
+             */
+            template <typename T_CommunicationPolicy>
+            auto Base<T_CommunicationPolicy>::confirm(std::size_t const sendSocket_i)
+            -> void {
+
+                if(confirmedPeerMsgs[sendSocket_i] == recvPeerMsgs[sendSocket_i]){
+                    return;
+                }
+
+                std::array<std::size_t, 1> nConfirmed {{ recvPeerMsgs[sendSocket_i] }};
+                confirmedPeerMsgs[sendSocket_i] = nConfirmed[0];
+
+                // Send sockets are indexed by the vAddrs of the initial context
+                static_cast<CommunicationPolicy*>(this)->asyncSendImpl(MsgType::CONFIRM, 0, initialContext, static_cast<VAddr>(sendSocket_i), 0, nConfirmed);
+
+            }
+
+
             template <typename T_CommunicationPolicy>
             auto Base<T_CommunicationPolicy>::handleRecv()
             -> void {
@@ -784,22 +1011,63 @@ namespace graybat {
                 while(true){
 
                     Message message;
-                    static_cast<CommunicationPolicy*>(this)->recvFromSocket(static_cast<CommunicationPolicy*>(this)->recvSocket, message);
+                    if(confirmDelivery){
+                        // Pending confirmations are sent, when the socket
+                        // runs dry or the batch of a link is full
+                        if(!static_cast<CommunicationPolicy*>(this)->tryRecvFromSocket(static_cast<CommunicationPolicy*>(this)->recvSocket, message)){
+                            for(std::size_t sendSocket_i = 0; sendSocket_i < recvPeerMsgs.size(); ++sendSocket_i){
+                                confirm(sendSocket_i);
+                            }
+                            static_cast<CommunicationPolicy*>(this)->recvFromSocket(static_cast<CommunicationPolicy*>(this)->recvSocket, message);
+                        }
+                    }
+                    else {
+                        static_cast<CommunicationPolicy*>(this)->recvFromSocket(static_cast<CommunicationPolicy*>(this)->recvSocket, message);
+                    }
 
                     //std::cout << "recv handler: " << static_cast<int>(message.getMsgType()) << " " << message.getMsgID() << " " << message.getContextID() << " " << message.getVAddr() << " " << message.getTag() << std::endl;
 
-                    if(message.getMsgType() == MsgType::DESTRUCT){
+                    MsgType msgType = message.getMsgType();
+
+                    if(msgType == MsgType::DESTRUCT){
                         return;
                     }
 
-                    if(message.getMsgType() == MsgType::PEER){
-                        std::array<unsigned,0>  null;
-                        Context context = contexts.at(message.getContextID());
-                        static_cast<CommunicationPolicy*>(this)->asyncSendImpl(MsgType::CONFIRM, message.getMsgID(), context, message.getVAddr(), message.getTag(), null);
+                    if(msgType == MsgType::BATCH){
+                        message.unbatch([this](Message &batched){ deliver(batched); });
+                    }
+                    else {
+                        deliver(message);
                     }
 
-                    inBox.enqueue(std::move(message), message.getMsgType(), message.getContextID(), message.getVAddr(), message.getTag());
+                }
+
+            }
+
+            /**
+             * @brief Moves a received message into the inbox.
+             *
+             */
+            template <typename T_CommunicationPolicy>
+            auto Base<T_CommunicationPolicy>::deliver(Message & message)
+            -> void {
+
+                MsgType msgType = message.getMsgType();
+                ContextID contextID = message.getContextID();
+                VAddr vAddr = message.getVAddr();
+                Tag tag = message.getTag();
 
+                inBox.enqueue(std::move(message), msgType, contextID, vAddr, tag);
+
+                if(confirmDelivery && msgType == MsgType::PEER){
+                    std::size_t sendSocket_i = 0;
+                    {
+                        std::lock_guard<std::mutex> mappingsLock(sendSocketMappingsMtx);
+                        sendSocket_i = sendSocketMappings.at(contextID).at(vAddr);
+                    }
+                    if(++recvPeerMsgs[sendSocket_i] - confirmedPeerMsgs[sendSocket_i] >= confirmBatchSize){
+                        confirm(sendSocket_i);
+                    }
                 }
 
             }
@@ -823,7 +1091,16 @@ namespace graybat {
                     }
 
                     if(message.getMsgType() == MsgType::CONFIRM){
-                        ctrlBox.enqueue(std::move(message), message.getMsgType(), message.getContextID(), message.getVAddr(), message.getTag());
+                        std::size_t nConfirmed = 0;
+                        memcpy(&nConfirmed, message.getData(), sizeof(nConfirmed));
+                        // Confirmations are sent in the initial context,
+                        // whose vAddrs index the send sockets
+                        std::size_t sendSocket_i = message.getVAddr();
+                        {
+                            std::lock_guard<std::mutex> confirmLock(confirmMtx);
+                            ackedPeerMsgs.at(sendSocket_i) = std::max(ackedPeerMsgs.at(sendSocket_i), nConfirmed);
+                        }
+                        confirmCondition.notify_all();
                     }
                     else {
                         // Throw exception
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <memory>  /* std::shared_ptr, std::make_shared */
+#include <utility> /* std::move */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/socket/Traits.hpp>    /* Message */
+#include <graybat/communicationPolicy/socket/SendState.hpp> /* SendState */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace socket {
+
+            /**
+             * @brief Persistent send of a buffer to one peer.
+             *
+             * The send socket of the peer and the header of the messages
+             * are resolved on binding. Each start() only copies the
+             * prefilled header and the buffer into a message, or
+             * references the buffer if the policy sends zero copy, and
+             * enqueues it on the link to the peer.
+             *
+             */
+            template <typename T_CommunicationPolicy, typename T_Buffer>
+            struct SendChannel {
+
+                using CommunicationPolicy = T_CommunicationPolicy;
+                using VAddr               = typename graybat::communicationPolicy::VAddr<CommunicationPolicy>;
+                using Tag                 = typename graybat::communicationPolicy::Tag<CommunicationPolicy>;
+                using Context             = typename graybat::communicationPolicy::Context<CommunicationPolicy>;
+                using MsgID               = typename graybat::communicationPolicy::MsgID<CommunicationPolicy>;
+                using Message             = graybat::communicationPolicy::socket::Message<CommunicationPolicy>;
+                using Header              = typename Message::Header;
+
+                SendChannel(CommunicationPolicy & comm,
+                            std::size_t const sendSocket_i,
+                            VAddr const destVAddr,
+                            Tag const tag,
+                            Context const context,
+                            T_Buffer const & buffer,
+                            Header const & header) :
+                    comm(&comm),
+                    sendSocket_i(sendSocket_i),
+                    destVAddr(destVAddr),
+                    tag(tag),
+                    context(context),
+                    buffer(&buffer),
+                    header(header),
+                    seq(0),
+                    pending(false){
+
+                }
+
+                void start(){
+                    sendState.reset();
+                    if(comm->zeroCopySend && buffer->size() > 0){
+                        sendState = std::make_shared<SendState>();
+                    }
+                    Message message(sendState ? Message(header, *buffer, sendState)
+                                              : Message(header, *buffer));
+
+                    seq = comm->sendEngine.nextSeq(sendSocket_i);
+                    comm->sendEngine.enqueue(sendSocket_i, seq, false, std::move(message));
+                    pending = true;
+
+                }
+
+                void wait(){
+                    if(pending){
+                        if(sendState){
+                            sendState->wait();
+                        }
+                        comm->waitReady(seq, context, destVAddr, tag);
+                        pending = false;
+                    }
+
+                }
+
+                bool ready(){
+                    if(pending){
+                        pending = !((!sendState || sendState->ready()) && comm->ready(seq, context, destVAddr, tag));
+                    }
+                    return !pending;
+
+                }
+
+            private:
+                CommunicationPolicy * comm;
+                std::size_t sendSocket_i;
+                VAddr destVAddr;
+                Tag tag;
+                Context context;
+                T_Buffer const * buffer;
+                Header header;
+
+                // Number of the last message on the link, which the
+                // delivery confirmation refers to
+                MsgID seq;
+                std::shared_ptr<SendState> sendState;
+                bool pending;
+
+            };
+
+        } // namespace socket
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,364 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <algorithm>          /* std::max, std::min */
+#include <atomic>             /* std::atomic */
+#include <chrono>             /* std::chrono::steady_clock, std::chrono::microseconds */
+#include <condition_variable> /* std::condition_variable */
+#include <functional>         /* std::function */
+#include <map>                /* std::map */
+#include <memory>             /* std::unique_ptr */
+#include <mutex>              /* std::mutex, std::lock_guard, std::unique_lock */
+#include <thread>             /* std::thread, std::this_thread::yield */
+#include <utility>            /* std::move */
+#include <vector>             /* std::vector */
+
+// GrayBat
+#include <graybat/utils/MpscQueue.hpp> /* utils::MpscQueue */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace socket {
+
+            /**
+             * @brief Sends messages from a queue per link (send socket)
+             *        by dedicated I/O threads.
+             *
+             * Any thread enqueues messages without locking, the sockets
+             * of a link are only used by the I/O thread the link is
+             * assigned to. Thus sends to different links do not
+             * serialize and the receive handler never waits for a large
+             * send of the application.
+             *
+             * Peer messages are numbered per link by nextSeq and sent in
+             * this order, messages with seq 0 are sent as dequeued.
+             *
+             * With coalescing enabled, small peer messages of a link are
+             * collected and sent as one batch, when the batch reaches the
+             * size threshold, when its oldest message waited for the delay,
+             * or on flush.
+             *
+             */
+            template <typename T_Message>
+            struct SendEngine {
+
+                using Message = T_Message;
+
+                // Called by the I/O threads with the link, whether the
+                // ctrl socket of the link is meant and the message
+                using Send = std::function<void(std::size_t const, bool const, Message &)>;
+
+                // Called by the I/O threads with the link and at least
+                // two messages, that are sent as one
+                using SendBatch = std::function<void(std::size_t const, std::vector<Message> &)>;
+
+                using Clock = std::chrono::steady_clock;
+
+                SendEngine() :
+                    coalesceSize(0),
+                    coalesceDelay(0),
+                    stopping(false){
+
+                }
+
+                SendEngine(SendEngine const &) = delete;
+                SendEngine& operator=(SendEngine const &) = delete;
+
+                ~SendEngine(){
+                    stop();
+                }
+
+                /**
+                 * @brief Enables coalescing of peer messages smaller than
+                 *        *size* bytes, must be called before start.
+                 *
+                 */
+                void coalesce(std::size_t const size, std::chrono::microseconds const delay, SendBatch const sendBatch){
+                    this->coalesceSize = size;
+                    this->coalesceDelay = delay;
+                    this->sendBatch = sendBatch;
+                }
+
+                /**
+                 * @brief Starts *nThreads* I/O threads, that serve *nLinks* links.
+                 *        The sockets of the links must not be used by other
+                 *        threads from now on.
+                 *
+                 */
+                void start(std::size_t const nLinks, std::size_t const nThreads, Send const send){
+                    this->send = send;
+                    for(std::size_t link_i = 0; link_i < nLinks; ++link_i){
+                        links.emplace_back(new Link());
+                    }
+
+                    std::size_t const nWorkers = std::max(std::min(nThreads, nLinks), static_cast<std::size_t>(1));
+                    for(std::size_t worker_i = 0; worker_i < nWorkers; ++worker_i){
+                        workers.emplace_back(new Worker());
+                    }
+                    for(std::size_t link_i = 0; link_i < nLinks; ++link_i){
+                        workers[link_i % nWorkers]->links.push_back(link_i);
+                    }
+                    for(auto &worker : workers){
+                        worker->thread = std::thread(&SendEngine::run, this, std::ref(*worker));
+                    }
+
+                }
+
+                /**
+                 * @brief Sends all enqueued messages and joins the I/O
+                 *        threads. No message must be enqueued concurrently.
+                 *
+                 */
+                void stop(){
+                    if(workers.empty() || stopping){
+                        return;
+                    }
+                    stopping = true;
+                    for(auto &worker : workers){
+                        {
+                            std::lock_guard<std::mutex> wakeLock(worker->wakeMtx);
+                        }
+                        worker->wakeCondition.notify_one();
+                        worker->thread.join();
+                    }
+
+                }
+
+                /**
+                 * @brief Sends the collected batches of all links
+                 *        without waiting for the thresholds.
+                 *
+                 */
+                void flush(){
+                    for(auto &worker : workers){
+                        worker->flushRequested = true;
+                        wake(*worker);
+                    }
+
+                }
+
+                std::size_t nextSeq(std::size_t const link_i){
+                    return ++links[link_i]->issued;
+                }
+
+                void enqueue(std::size_t const link_i, std::size_t const seq, bool const ctrl, Message && message){
+                    links[link_i]->queue.push(Item(seq, ctrl, std::move(message)));
+
+                    Worker &worker = *workers[link_i % workers.size()];
+                    ++worker.pending;
+                    wake(worker);
+
+                }
+
+            private:
+                struct Item {
+                    Item() :
+                        seq(0),
+                        ctrl(false){
+
+                    }
+
+                    Item(std::size_t const seq, bool const ctrl, Message && message) :
+                        seq(seq),
+                        ctrl(ctrl),
+                        message(std::move(message)){
+
+                    }
+
+                    std::size_t seq;
+                    bool ctrl;
+                    Message message;
+                };
+
+                struct Link {
+                    utils::MpscQueue<Item> queue;
+                    std::atomic<std::size_t> issued{0};
+
+                    // Owned by the I/O thread of the link
+                    std::size_t sent = 0;
+                    std::map<std::size_t, Item> early;
+                    std::vector<Message> batch;
+                    std::size_t batchSize = 0;
+                    Clock::time_point batchBegin;
+                };
+
+                struct Worker {
+                    std::vector<std::size_t> links;
+                    std::atomic<std::size_t> pending{0};
+                    std::atomic<bool> sleeping{false};
+                    std::atomic<bool> flushRequested{false};
+                    std::mutex wakeMtx;
+                    std::condition_variable wakeCondition;
+                    std::thread thread;
+                };
+
+                Send send;
+                SendBatch sendBatch;
+                std::size_t coalesceSize;
+                std::chrono::microseconds coalesceDelay;
+                std::vector<std::unique_ptr<Link> > links;
+                std::vector<std::unique_ptr<Worker> > workers;
+                std::atomic<bool> stopping;
+
+                void wake(Worker &worker){
+                    if(worker.sleeping){
+                        {
+                            std::lock_guard<std::mutex> wakeLock(worker.wakeMtx);
+                        }
+                        worker.wakeCondition.notify_one();
+                    }
+
+                }
+
+                void run(Worker &worker){
+                    while(true){
+                        // Read before draining, thus messages enqueued
+                        // before the flush request are part of the flush
+                        bool const flushing = worker.flushRequested.exchange(false);
+
+                        std::size_t nDequeued = 0;
+                        for(std::size_t link_i : worker.links){
+                            nDequeued += drain(link_i);
+                        }
+                        if(nDequeued){
+                            worker.pending -= nDequeued;
+                        }
+
+                        // Batches are sent when their delay expired
+                        Clock::time_point const now = Clock::now();
+                        Clock::time_point deadline = Clock::time_point::max();
+                        for(std::size_t link_i : worker.links){
+                            Link &link = *links[link_i];
+                            if(link.batch.empty()){
+                                continue;
+                            }
+                            if(flushing || stopping || now >= link.batchBegin + coalesceDelay){
+                                flushBatch(link_i);
+                            }
+                            else {
+                                deadline = std::min(deadline, link.batchBegin + coalesceDelay);
+                            }
+                        }
+
+                        if(nDequeued){
+                            continue;
+                        }
+
+                        // A message is counted, but its predecessor in
+                        // the queue is not linked yet
+                        if(worker.pending){
+                            std::this_thread::yield();
+                            continue;
+                        }
+
+                        if(stopping){
+                            return;
+                        }
+
+                        std::unique_lock<std::mutex> wakeLock(worker.wakeMtx);
+                        worker.sleeping = true;
+                        auto const woken = [&]{ return worker.pending || stopping || worker.flushRequested; };
+                        if(deadline == Clock::time_point::max()){
+                            worker.wakeCondition.wait(wakeLock, woken);
+                        }
+                        else {
+                            worker.wakeCondition.wait_until(wakeLock, deadline, woken);
+                        }
+                        worker.sleeping = false;
+                    }
+
+                }
+
+                void post(std::size_t const link_i, Item &item){
+                    Link &link = *links[link_i];
+
+                    if(item.seq != 0 && !item.ctrl && item.message.size() < coalesceSize){
+                        if(link.batch.empty()){
+                            link.batchBegin = Clock::now();
+                        }
+                        link.batchSize += item.message.size();
+                        link.batch.push_back(std::move(item.message));
+                        if(link.batchSize >= coalesceSize){
+                            flushBatch(link_i);
+                        }
+                        return;
+                    }
+
+                    // Messages of the data socket keep their order
+                    if(!item.ctrl){
+                        flushBatch(link_i);
+                    }
+                    send(link_i, item.ctrl, item.message);
+
+                }
+
+                void flushBatch(std::size_t const link_i){
+                    Link &link = *links[link_i];
+                    if(link.batch.size() == 1){
+                        send(link_i, false, link.batch.front());
+                    }
+                    else if(link.batch.size() > 1){
+                        sendBatch(link_i, link.batch);
+                    }
+                    link.batch.clear();
+                    link.batchSize = 0;
+
+                }
+
+                std::size_t drain(std::size_t const link_i){
+                    Link &link = *links[link_i];
+                    std::size_t nDequeued = 0;
+                    Item item;
+
+                    while(link.queue.tryPop(item)){
+                        ++nDequeued;
+                        if(item.seq == 0){
+                            post(link_i, item);
+                        }
+                        else if(item.seq == link.sent + 1){
+                            post(link_i, item);
+                            ++link.sent;
+
+                            // Messages of concurrent senders, that overtook this one
+                            for(auto it = link.early.begin(); it != link.early.end() && it->first == link.sent + 1; it = link.early.erase(it)){
+                                post(link_i, it->second);
+                                ++link.sent;
+                            }
+                        }
+                        else {
+                            link.early.emplace(item.seq, std::move(item));
+                        }
+                    }
+                    return nDequeued;
+
+                }
+
+            };
+
+        } // namespace socket
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
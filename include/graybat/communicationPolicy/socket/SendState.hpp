@@ -0,0 +1,78 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <atomic>             /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <mutex>              /* std::mutex, std::lock_guard, std::unique_lock */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace socket {
+
+            /**
+             * @brief Completion state of a send whose message still
+             *        references the user buffer. It is completed by the
+             *        transport once the buffer is not needed anymore.
+             *
+             */
+            struct SendState {
+
+                SendState() :
+                    done(false){
+
+                }
+
+                void complete(){
+                    {
+                        std::lock_guard<std::mutex> doneLock(doneMtx);
+                        done = true;
+                    }
+                    doneCondition.notify_all();
+                }
+
+                bool ready() const {
+                    return done;
+                }
+
+                void wait(){
+                    if(done){
+                        return;
+                    }
+                    std::unique_lock<std::mutex> doneLock(doneMtx);
+                    doneCondition.wait(doneLock, [this]{ return done.load(); });
+                }
+
+            private:
+                std::atomic<bool> done;
+                std::mutex doneMtx;
+                std::condition_variable doneCondition;
+
+            };
+
+        } // namespace socket
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// CLIB
+#include <string.h>    /* memcpy */
+
+// STL
+#include <cstdint>     /* std::uint32_t */
+#include <stdexcept>   /* std::runtime_error */
+#include <string>      /* std::string */
+#include <type_traits> /* std::is_arithmetic, std::is_enum, std::enable_if */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace socket {
+
+            /**
+             * @brief Binary message exchanged with the signaling server.
+             *
+             * Values are appended with << and read in the same order
+             * with >>. Arithmetic and enum values are stored in their
+             * native representation, strings are prefixed by their
+             * length. Peers and the signaling server thus need to share
+             * the same architecture.
+             *
+             */
+            struct SignalingMessage {
+
+                std::string bytes;
+                std::size_t readOffset = 0;
+
+                SignalingMessage(){
+
+                }
+
+                SignalingMessage(void const * data, std::size_t const size) :
+                    bytes(static_cast<char const *>(data), size){
+
+                }
+
+                template <typename T_Value,
+                          typename = typename std::enable_if<std::is_arithmetic<T_Value>::value || std::is_enum<T_Value>::value>::type>
+                SignalingMessage& operator<<(T_Value const value){
+                    bytes.append(reinterpret_cast<char const *>(&value), sizeof(T_Value));
+                    return *this;
+                }
+
+                SignalingMessage& operator<<(std::string const & value){
+                    *this << static_cast<std::uint32_t>(value.size());
+                    bytes.append(value);
+                    return *this;
+                }
+
+                template <typename T_Value,
+                          typename = typename std::enable_if<std::is_arithmetic<T_Value>::value || std::is_enum<T_Value>::value>::type>
+                SignalingMessage& operator>>(T_Value & value){
+                    memcpy(&value, read(sizeof(T_Value)), sizeof(T_Value));
+                    return *this;
+                }
+
+                SignalingMessage& operator>>(std::string & value){
+                    std::uint32_t size = 0;
+                    *this >> size;
+                    value.assign(read(size), size);
+                    return *this;
+                }
+
+                void const * data() const {
+                    return bytes.data();
+                }
+
+                std::size_t size() const {
+                    return bytes.size();
+                }
+
+            private:
+                char const * read(std::size_t const size){
+                    if(readOffset + size > bytes.size()){
+                        throw std::runtime_error("Signaling message is shorter than expected.");
+                    }
+                    char const * value = bytes.data() + readOffset;
+                    readOffset += size;
+                    return value;
+                }
+
+            };
+
+        } // namespace socket
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <memory>  /* std::shared_ptr */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace threads {
+
+            template <typename T_CP>
+            struct Network;
+
+            template <typename T_CP>
+            struct Config {
+                // Peers of this process, that communicate with each other,
+                // each peer is a thread that constructs its own policy
+                std::shared_ptr<Network<T_CP> > network;
+                // Number of polls of a waiting receive, before the thread
+                // goes to sleep until a message arrives
+                std::size_t spinCount = 1000;
+            };
+
+        } // threads
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef> /* std::size_t */
+#include <cstdint> /* std::int8_t */
+#include <vector>  /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace threads {
+
+            /**
+             * @brief Message between two peers of the same process.
+             *
+             * The header is kept as plain members and the payload in
+             * a buffer of its own. Moving a message into the channel of
+             * the receiver hands over the buffer, thus the payload is
+             * copied once on send and not serialized at all.
+             *
+             */
+            template <typename T_CP>
+            struct Message {
+
+                using ContextID = typename graybat::communicationPolicy::ContextID<T_CP>;
+                using VAddr     = typename graybat::communicationPolicy::VAddr<T_CP>;
+                using Tag       = typename graybat::communicationPolicy::Tag<T_CP>;
+                using MsgType   = typename graybat::communicationPolicy::MsgType<T_CP>;
+
+                Message() :
+                    msgType(MsgType::PEER),
+                    contextID(0),
+                    srcVAddr(0),
+                    tag(0){
+
+                }
+
+                Message(MsgType const msgType, ContextID const contextID, VAddr const srcVAddr, Tag const tag, void const * data, std::size_t const size) :
+                    msgType(msgType),
+                    contextID(contextID),
+                    srcVAddr(srcVAddr),
+                    tag(tag),
+                    payload(static_cast<std::int8_t const *>(data), static_cast<std::int8_t const *>(data) + size){
+
+                }
+
+                std::int8_t const * getData() const {
+                    return payload.data();
+                }
+
+                std::size_t getDataSize() const {
+                    return payload.size();
+                }
+
+                MsgType   msgType;
+                ContextID contextID;
+                VAddr     srcVAddr;
+                Tag       tag;
+                std::vector<std::int8_t> payload;
+
+            };
+
+        } // threads
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <atomic>             /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <cstddef>            /* std::size_t */
+#include <memory>             /* std::unique_ptr */
+#include <mutex>              /* std::mutex, std::lock_guard, std::unique_lock */
+#include <stdexcept>          /* std::runtime_error */
+#include <utility>            /* std::move */
+#include <vector>             /* std::vector */
+
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/threads/Message.hpp> /* Message */
+#include <graybat/utils/SpscQueue.hpp>                     /* utils::SpscQueue */
+
+namespace graybat {
+
+    namespace communicationPolicy {
+
+        namespace threads {
+
+            /**
+             * @brief Connects the peers of one process, each peer is a
+             *        thread with its own communication policy.
+             *
+             * There is a channel for each ordered pair of peers, which
+             * is only pushed to by the sending peer and only popped from
+             * by the receiving peer, thus channels are lock-free single
+             * producer single consumer queues. A receiving peer that has
+             * nothing to receive polls for a while and then sleeps until
+             * the arrival count of its mailbox changes.
+             *
+             */
+            template <typename T_CP>
+            struct Network {
+
+                using ContextID = typename graybat::communicationPolicy::ContextID<T_CP>;
+                using VAddr     = typename graybat::communicationPolicy::VAddr<T_CP>;
+                using Message   = graybat::communicationPolicy::threads::Message<T_CP>;
+                using Channel   = utils::SpscQueue<Message>;
+
+                Network(std::size_t const nPeers) :
+                    nPeers(nPeers),
+                    nJoined(0),
+                    maxContextID(0){
+
+                    for(std::size_t channel_i = 0; channel_i < nPeers * nPeers; ++channel_i){
+                        channels.emplace_back(new Channel());
+                    }
+                    for(std::size_t peer_i = 0; peer_i < nPeers; ++peer_i){
+                        mailboxes.emplace_back(new Mailbox());
+                    }
+
+                }
+
+                Network(Network const &) = delete;
+                Network& operator=(Network const &) = delete;
+
+                std::size_t const nPeers;
+
+                /**
+                 * @brief Returns the vAddr of a new peer, peers are
+                 *        numbered in the order they join.
+                 *
+                 */
+                VAddr join(){
+                    std::size_t const vAddr = nJoined++;
+                    if(vAddr >= nPeers){
+                        throw std::runtime_error("More peers joined than the network was created for.");
+                    }
+                    return static_cast<VAddr>(vAddr);
+                }
+
+                ContextID newContextID(){
+                    return ++maxContextID;
+                }
+
+                Channel& channel(VAddr const srcVAddr, VAddr const destVAddr){
+                    return *channels[srcVAddr * nPeers + destVAddr];
+                }
+
+                /**
+                 * @brief Must only be called by the peer *srcVAddr*.
+                 *
+                 */
+                void post(VAddr const srcVAddr, VAddr const destVAddr, Message && message){
+                    channel(srcVAddr, destVAddr).push(std::move(message));
+
+                    Mailbox &mailbox = *mailboxes[destVAddr];
+                    ++mailbox.arrivals;
+                    if(mailbox.sleeping){
+                        {
+                            std::lock_guard<std::mutex> wakeLock(mailbox.wakeMtx);
+                        }
+                        mailbox.wakeCondition.notify_one();
+                    }
+
+                }
+
+                /**
+                 * @brief Number of messages posted to *vAddr* so far. Read
+                 *        before the channels are checked and passed to
+                 *        waitArrival if nothing was found.
+                 *
+                 */
+                std::size_t arrivals(VAddr const vAddr) const {
+                    return mailboxes[vAddr]->arrivals;
+                }
+
+                /**
+                 * @brief Returns when a message was posted to *vAddr*
+                 *        after *seen* messages.
+                 *
+                 */
+                void waitArrival(VAddr const vAddr, std::size_t const seen, std::size_t const spinCount){
+                    Mailbox &mailbox = *mailboxes[vAddr];
+                    for(std::size_t spin_i = 0; spin_i < spinCount; ++spin_i){
+                        if(mailbox.arrivals != seen){
+                            return;
+                        }
+                    }
+
+                    std::unique_lock<std::mutex> wakeLock(mailbox.wakeMtx);
+                    mailbox.sleeping = true;
+                    mailbox.wakeCondition.wait(wakeLock, [&]{ return mailbox.arrivals != seen; });
+                    mailbox.sleeping = false;
+
+                }
+
+            private:
+                struct Mailbox {
+                    std::atomic<std::size_t> arrivals{0};
+                    std::atomic<bool> sleeping{false};
+                    std::mutex wakeMtx;
+                    std::condition_variable wakeCondition;
+                };
+
+                std::vector<std::unique_ptr<Channel> > channels;
+                std::vector<std::unique_ptr<Mailbox> > mailboxes;
+                std::atomic<std::size_t> nJoined;
+                std::atomic<ContextID> maxContextID;
+
+            };
+
+        } // threads
+
+    } // namespace communicationPolicy
+
+} // namespace graybat
@@ -33,6 +33,28 @@ namespace graybat {
                 size_t contextSize;
                 std::string contextName = "context";
                 size_t maxBufferSize = 100 * 1000 * 1000;
+                // Sends complete when the receiver confirmed the delivery,
+                // instead of when the message is handed to ZMQ
+                bool confirmDelivery = false;
+                // Number of messages a receiver confirms at once per peer
+                size_t confirmBatchSize = 1;
+                // Sends reference the user buffer instead of copying it,
+                // they complete when ZMQ has released the buffer
+                bool zeroCopySend = false;
+                // Number of I/O threads, that send the queued messages,
+                // each serves a fixed subset of the peers
+                size_t sendThreads = 1;
+                // Peer messages smaller than coalesceSize bytes are packed
+                // into one message per peer, which is sent when it reaches
+                // coalesceSize bytes, after coalesceDelay microseconds or
+                // on flush. 0 disables the coalescing
+                size_t coalesceSize = 0;
+                size_t coalesceDelay = 100;
+                // Broadcast and reduce send payloads of at least two
+                // segments in segments of this size along a chain of the
+                // peers, each peer passes a segment on as soon as it
+                // arrived. 0 disables the pipelining
+                size_t segmentSize = 1024 * 1024;
             };
 
         } // zmq
@@ -21,10 +21,12 @@
 #pragma once
 
 // STL
-#include <memory> /* std::unique_ptr */
+#include <memory> /* std::unique_ptr, std::shared_ptr */
 
 // graybat
 #include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/Operation.hpp> /* Operation */
+#include <graybat/communicationPolicy/socket/SendState.hpp> /* SendState */
 
 namespace graybat {
 
@@ -50,6 +52,7 @@ namespace graybat {
                 using MsgType   = typename graybat::communicationPolicy::MsgType<T_CP>;
                 using MsgID     = typename graybat::communicationPolicy::MsgID<T_CP>;
                 using Context   = typename graybat::communicationPolicy::Context<T_CP>;
+                using SendState = graybat::communicationPolicy::socket::SendState;
 
                 Event(MsgID msgID, Context context, VAddr vAddr, Tag tag, T_CP& comm) :
                     msgID(msgID),
@@ -63,6 +66,43 @@ namespace graybat {
 
                 }
 
+                Event(MsgID msgID, Context context, VAddr vAddr, Tag tag, bool done, T_CP& comm) :
+                    msgID(msgID),
+                    context(context),
+                    vAddr(vAddr),
+                    tag(tag),
+                    buf(nullptr),
+                    size(0),
+                    done(done),
+                    comm(&comm) {
+
+                }
+
+                Event(MsgID msgID, Context context, VAddr vAddr, Tag tag, bool done, std::shared_ptr<SendState> sendState, T_CP& comm) :
+                    msgID(msgID),
+                    context(context),
+                    vAddr(vAddr),
+                    tag(tag),
+                    buf(nullptr),
+                    size(0),
+                    done(done),
+                    comm(&comm),
+                    sendState(sendState) {
+
+                }
+
+                Event(std::shared_ptr<Operation> operation) :
+                    msgID(0),
+                    vAddr(0),
+                    tag(0),
+                    buf(nullptr),
+                    size(0),
+                    done(false),
+                    comm(nullptr),
+                    operation(operation) {
+
+                }
+
                 template<typename T_Buf>
                 Event(MsgID msgID, Context context, VAddr vAddr, Tag tag, T_Buf & buf, bool done, T_CP& comm) :
                     msgID(msgID),
@@ -79,19 +119,38 @@ namespace graybat {
                 Event& operator=(const Event&) = default;
 
                 void wait(){
-                    while(!ready());
+                    if(operation){
+                        operation->wait();
+                    }
+                    else if(buf == nullptr){
+                        // asyncSend Event, sleeps until the buffer is
+                        // released and the delivery confirmed
+                        if(!done){
+                            if(sendState){
+                                sendState->wait();
+                            }
+                            comm->waitReady(msgID, context, vAddr, tag);
+                            done = true;
+                        }
+                    }
+                    else {
+                        while(!ready());
+                    }
 
                 }
 
                 bool ready(){
                     //std::cout << "ready? size: " << size << std::endl;
+                    if(operation){
+                        return operation->ready();
+                    }
                     if(done == true){
                         return true;
                     }
                     else {
                         if(buf == nullptr){
                             // asyncSend Event
-                            done = comm->ready(msgID, context, vAddr, tag);
+                            done = (!sendState || sendState->ready()) && comm->ready(msgID, context, vAddr, tag);
                         }
                         else {
                             // asyncRecv Event
@@ -118,6 +177,8 @@ namespace graybat {
                 size_t size;
                 bool       done;
                 T_CP *     comm;
+                std::shared_ptr<SendState> sendState;
+                std::shared_ptr<Operation> operation;
 
 
 
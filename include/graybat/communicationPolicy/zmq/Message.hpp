@@ -20,7 +20,16 @@
 
 #pragma once
 
+// STL
+#include <array>       /* std::array */
+#include <cstdint>     /* std::uint64_t */
+#include <memory>      /* std::shared_ptr */
+#include <type_traits> /* std::remove_const */
+#include <vector>      /* std::vector */
+
+// GRAYBAT
 #include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/communicationPolicy/socket/SendState.hpp> /* SendState */
 
 namespace graybat {
     
@@ -28,6 +37,13 @@ namespace graybat {
     
         namespace zmq {
 
+            /**
+             * @brief A message consists of a header frame, that is
+             *        directly followed by the payload, or in the
+             *        zero copy case of a header frame and a second
+             *        frame, that references the payload of the sender.
+             *
+             */
             template <typename T_CommunicationPolicy>
             struct Message {
 
@@ -39,8 +55,25 @@ namespace graybat {
                 using MsgType             = typename graybat::communicationPolicy::MsgType<CommunicationPolicy>;
                 using MsgID               = typename graybat::communicationPolicy::MsgID<CommunicationPolicy>;
 
+                using SendState           = graybat::communicationPolicy::socket::SendState;
+
+                // The header is padded, thus the payload of a single frame
+                // message is aligned and can be viewed in place
+                static constexpr size_t headerAlignment = alignof(std::uint64_t);
+                static constexpr size_t headerSize = (sizeof(MsgType) +
+                                                      sizeof(MsgID) +
+                                                      sizeof(ContextID) +
+                                                      sizeof(VAddr) +
+                                                      sizeof(Tag) +
+                                                      headerAlignment - 1) / headerAlignment * headerAlignment;
+
+                // Header frame of all messages of a channel
+                using Header = std::array<char, headerSize>;
+
                 // Members
                 ::zmq::message_t message;
+                ::zmq::message_t payload;
+                bool multipart = false;
 
                 // Methods
                 Message(){
@@ -53,11 +86,7 @@ namespace graybat {
                         ContextID const contextID,
                         VAddr const srcVAddr,
                         Tag const tag,      
-                        T_Data & data) : message(sizeof(MsgType) +
-                                                       sizeof(MsgID) +
-                                                       sizeof(ContextID) +
-                                                       sizeof(VAddr) +
-                                                       sizeof(Tag) +
+                        T_Data & data) : message(headerSize +
                                                        data.size() * sizeof(typename T_Data::value_type)){
 
                     size_t    msgOffset(0);
@@ -65,11 +94,163 @@ namespace graybat {
                     memcpy (static_cast<char*>(message.data()) + msgOffset, &msgID,      sizeof(MsgID));     msgOffset += sizeof(MsgID);		
                     memcpy (static_cast<char*>(message.data()) + msgOffset, &contextID,  sizeof(ContextID)); msgOffset += sizeof(ContextID);
                     memcpy (static_cast<char*>(message.data()) + msgOffset, &srcVAddr,   sizeof(VAddr));     msgOffset += sizeof(VAddr);
-                    memcpy (static_cast<char*>(message.data()) + msgOffset, &tag,        sizeof(Tag));       msgOffset += sizeof(Tag);
-                    memcpy (static_cast<char*>(message.data()) + msgOffset, data.data(), sizeof(typename T_Data::value_type) * data.size());
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &tag,        sizeof(Tag));
+                    memcpy (static_cast<char*>(message.data()) + headerSize, data.data(), sizeof(typename T_Data::value_type) * data.size());
+
+                }
+
+                /**
+                 * @brief Zero copy message, the payload frame references
+                 *        *data* until ZMQ releases it and completes
+                 *        *sendState*.
+                 *
+                 */
+                template <typename T_Data>
+                Message(MsgType const msgType,
+                        MsgID const msgID,
+                        ContextID const contextID,
+                        VAddr const srcVAddr,
+                        Tag const tag,
+                        T_Data & data,
+                        std::shared_ptr<SendState> const & sendState) : message(headerSize),
+                                                                          payload(const_cast<typename std::remove_const<typename T_Data::value_type>::type*>(data.data()),
+                                                                                  data.size() * sizeof(typename T_Data::value_type),
+                                                                                  &Message::releasePayload,
+                                                                                  new std::shared_ptr<SendState>(sendState)),
+                                                                          multipart(true){
+
+                    size_t    msgOffset(0);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &msgType,    sizeof(MsgType));   msgOffset += sizeof(MsgType);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &msgID,      sizeof(MsgID));     msgOffset += sizeof(MsgID);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &contextID,  sizeof(ContextID)); msgOffset += sizeof(ContextID);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &srcVAddr,   sizeof(VAddr));     msgOffset += sizeof(VAddr);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &tag,        sizeof(Tag));
+
+                }
+
+                /**
+                 * @brief Message with the prefilled *header* of a
+                 *        channel, directly followed by the payload.
+                 *
+                 */
+                template <typename T_Data>
+                Message(Header const & header, T_Data & data) : message(headerSize +
+                                                                       data.size() * sizeof(typename T_Data::value_type)){
+
+                    memcpy (static_cast<char*>(message.data()), header.data(), headerSize);
+                    memcpy (static_cast<char*>(message.data()) + headerSize, data.data(), sizeof(typename T_Data::value_type) * data.size());
 
                 }
 
+                /**
+                 * @brief Zero copy message with the prefilled *header*
+                 *        of a channel.
+                 *
+                 */
+                template <typename T_Data>
+                Message(Header const & header,
+                        T_Data & data,
+                        std::shared_ptr<SendState> const & sendState) : message(headerSize),
+                                                                          payload(const_cast<typename std::remove_const<typename T_Data::value_type>::type*>(data.data()),
+                                                                                  data.size() * sizeof(typename T_Data::value_type),
+                                                                                  &Message::releasePayload,
+                                                                                  new std::shared_ptr<SendState>(sendState)),
+                                                                          multipart(true){
+
+                    memcpy (static_cast<char*>(message.data()), header.data(), headerSize);
+
+                }
+
+                /**
+                 * @brief Header of the messages, that a channel sends.
+                 *
+                 */
+                static Header makeHeader(MsgType const msgType,
+                                         MsgID const msgID,
+                                         ContextID const contextID,
+                                         VAddr const srcVAddr,
+                                         Tag const tag){
+                    Header header{};
+                    size_t    msgOffset(0);
+                    memcpy (header.data() + msgOffset, &msgType,    sizeof(MsgType));   msgOffset += sizeof(MsgType);
+                    memcpy (header.data() + msgOffset, &msgID,      sizeof(MsgID));     msgOffset += sizeof(MsgID);
+                    memcpy (header.data() + msgOffset, &contextID,  sizeof(ContextID)); msgOffset += sizeof(ContextID);
+                    memcpy (header.data() + msgOffset, &srcVAddr,   sizeof(VAddr));     msgOffset += sizeof(VAddr);
+                    memcpy (header.data() + msgOffset, &tag,        sizeof(Tag));
+                    return header;
+                }
+
+                /**
+                 * @brief Batch message, whose payload holds the copies of
+                 *        *messages*. Each is prefixed by its size and
+                 *        padded, thus the payloads stay aligned.
+                 *
+                 */
+                Message(MsgType const msgType,
+                        ContextID const contextID,
+                        VAddr const srcVAddr,
+                        std::vector<Message> & messages) : message(headerSize + batchSize(messages)){
+
+                    MsgID const msgID = 0;
+                    Tag const tag = 0;
+                    size_t    msgOffset(0);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &msgType,    sizeof(MsgType));   msgOffset += sizeof(MsgType);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &msgID,      sizeof(MsgID));     msgOffset += sizeof(MsgID);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &contextID,  sizeof(ContextID)); msgOffset += sizeof(ContextID);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &srcVAddr,   sizeof(VAddr));     msgOffset += sizeof(VAddr);
+                    memcpy (static_cast<char*>(message.data()) + msgOffset, &tag,        sizeof(Tag));
+
+                    char * batch = static_cast<char*>(message.data()) + headerSize;
+                    for(Message &batched : messages){
+                        std::uint64_t const batchedSize = batched.size();
+                        memcpy (batch, &batchedSize, sizeof(std::uint64_t));
+                        memcpy (batch + sizeof(std::uint64_t), batched.message.data(), batched.message.size());
+                        memcpy (batch + sizeof(std::uint64_t) + batched.message.size(), batched.payload.data(), batched.payload.size());
+                        batch += paddedSize(batched.size());
+                    }
+
+                }
+
+                /**
+                 * @brief Calls *op* with each message of a batch message.
+                 *
+                 */
+                template <typename T_Op>
+                void unbatch(T_Op op){
+                    char const * batch = reinterpret_cast<char const *>(getData());
+                    char const * const end = batch + getDataSize();
+                    while(batch < end){
+                        std::uint64_t batchedSize;
+                        memcpy (&batchedSize, batch, sizeof(std::uint64_t));
+
+                        Message batched;
+                        batched.message.rebuild(batchedSize);
+                        memcpy (batched.message.data(), batch + sizeof(std::uint64_t), batchedSize);
+                        op(batched);
+
+                        batch += paddedSize(batchedSize);
+                    }
+
+                }
+
+                static size_t paddedSize(size_t const size){
+                    return (sizeof(std::uint64_t) + size + headerAlignment - 1) / headerAlignment * headerAlignment;
+                }
+
+                static size_t batchSize(std::vector<Message> & messages){
+                    size_t size = 0;
+                    for(Message &batched : messages){
+                        size += paddedSize(batched.size());
+                    }
+                    return size;
+                }
+
+                static void releasePayload(void*, void* hint){
+                    std::shared_ptr<SendState> *sendState = static_cast<std::shared_ptr<SendState>*>(hint);
+                    (*sendState)->complete();
+                    delete sendState;
+                }
+
                 MsgType getMsgType(){
                     MsgType msgType;
                     memcpy (&msgType, static_cast<char*>(message.data()), sizeof(MsgType));
@@ -107,17 +288,40 @@ namespace graybat {
                 }
 		
 		size_t size() {
-		    return message.size();
+		    return message.size() + payload.size();
 		}
 
                 std::int8_t* getData(){
-                    return static_cast<std::int8_t*>(message.data()) + sizeof(MsgType) + sizeof(MsgID) + sizeof(ContextID) + sizeof(VAddr) + sizeof(Tag);
+                    if(multipart){
+                        return static_cast<std::int8_t*>(payload.data());
+                    }
+                    return static_cast<std::int8_t*>(message.data()) + headerSize;
                     
                 }
+
+                std::int8_t const * getData() const {
+                    if(multipart){
+                        return static_cast<std::int8_t const *>(payload.data());
+                    }
+                    return static_cast<std::int8_t const *>(message.data()) + headerSize;
+
+                }
+
+                size_t getDataSize() const {
+                    if(multipart){
+                        return payload.size();
+                    }
+                    return message.size() - headerSize;
+
+                }
                 
                 ::zmq::message_t& getMessage(){
                     return message;
                 }
+
+                ::zmq::message_t& getPayload(){
+                    return payload;
+                }
                 
             };
 
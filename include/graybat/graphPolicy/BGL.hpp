@@ -37,14 +37,13 @@
 #include <boost/graph/graphviz.hpp>
 #include <boost/bimap.hpp>
 
+// GRAYBAT
+#include <graybat/graphPolicy/Traits.hpp> /* VertexID, EdgeID, SimpleProperty */
+
 
 namespace graybat {
     
     namespace graphPolicy {
-	
-	struct SimpleProperty{
-
-	};
 
   	/************************************************************************//**
          * @class BGL
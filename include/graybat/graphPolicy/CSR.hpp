@@ -0,0 +1,234 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <vector>  /* std::vector */
+#include <utility> /* std::pair, std::make_pair */
+#include <cstddef> /* std::size_t */
+
+// BOOST
+#include <boost/iterator/counting_iterator.hpp> /* boost::counting_iterator */
+
+// GRAYBAT
+#include <graybat/graphPolicy/Traits.hpp> /* VertexID, EdgeID, SimpleProperty */
+
+namespace graybat {
+
+    namespace graphPolicy {
+
+  	/************************************************************************//**
+         * @class CSR
+	 *
+	 * @brief A class to describe directed graphs.
+	 *
+	 * GraphPolicy on basis of compressed sparse rows. The edges leaving
+	 * and entering a vertex are stored in contiguous rows, edge and
+	 * vertex ids are indices into flat arrays of sources, targets and
+	 * properties. Thus all lookups are constant time and each edge
+	 * costs a few words of memory. The graph can not be changed after
+	 * construction, which is all a cage needs.
+	 *
+	 ***************************************************************************/
+	template <class T_VertexProperty = SimpleProperty, class T_EdgeProperty = SimpleProperty>
+	class CSR {
+
+        private:
+            using VertexID    = graybat::graphPolicy::VertexID;
+            using EdgeID      = graybat::graphPolicy::EdgeID;
+            using GraphID     = graybat::graphPolicy::GraphID;
+
+        public:
+
+	    using VertexProperty     = T_VertexProperty;
+	    using EdgeProperty       = T_EdgeProperty;
+            using VertexDescription  = graybat::graphPolicy::VertexDescription<CSR>;
+            using EdgeDescription    = graybat::graphPolicy::EdgeDescription<CSR>;
+            using GraphDescription   = graybat::graphPolicy::GraphDescription<CSR>;
+	    using InEdgeIter         = typename std::vector<EdgeID>::const_iterator;
+	    using OutEdgeIter        = typename std::vector<EdgeID>::const_iterator;
+	    using AdjacentVertexIter = typename std::vector<VertexID>::const_iterator;
+	    using AllVertexIter      = boost::counting_iterator<VertexID>;
+
+        private:
+	    // Rows of the edges leaving a vertex, in order of their ids,
+	    // and the target vertices of these edges
+	    std::vector<std::size_t> outOffsets;
+	    std::vector<EdgeID>      outEdges;
+	    std::vector<VertexID>    outTargets;
+
+	    // Rows of the edges entering a vertex, in order of their ids
+	    std::vector<std::size_t> inOffsets;
+	    std::vector<EdgeID>      inEdges;
+
+	    // Indexed by edge id
+	    std::vector<VertexID>    edgeSources;
+	    std::vector<VertexID>    edgeTargets;
+	    std::vector<std::pair<EdgeID, EdgeProperty>> edgeProperties;
+
+	    // Indexed by vertex id
+	    std::vector<std::pair<VertexID, VertexProperty>> vertexProperties;
+
+	public:
+	    GraphID id;
+
+	    /**
+	     * @brief The graph has to be described by *edges*
+	     * (source Vertex ==> target Vertex) and
+	     * the *vertices* of this graph.
+	     *
+	     */
+	    CSR(GraphDescription graphDesc) :
+		id(0){
+
+		std::vector<VertexDescription> const &vertices = graphDesc.first;
+		std::vector<EdgeDescription> const &edges      = graphDesc.second;
+
+		vertexProperties.resize(vertices.size());
+		for(VertexDescription const &v : vertices){
+		    vertexProperties.at(v.first) = v;
+		}
+
+		edgeSources.reserve(edges.size());
+		edgeTargets.reserve(edges.size());
+		edgeProperties.reserve(edges.size());
+		outOffsets.assign(vertices.size() + 1, 0);
+		inOffsets.assign(vertices.size() + 1, 0);
+
+		for(EdgeID edgeId = 0; edgeId < edges.size(); ++edgeId){
+		    VertexID const source = edges[edgeId].first.first;
+		    VertexID const target = edges[edgeId].first.second;
+		    edgeSources.push_back(source);
+		    edgeTargets.push_back(target);
+		    edgeProperties.push_back(std::make_pair(edgeId, edges[edgeId].second));
+		    ++outOffsets[source + 1];
+		    ++inOffsets[target + 1];
+		}
+
+		for(VertexID vertex = 0; vertex < vertices.size(); ++vertex){
+		    outOffsets[vertex + 1] += outOffsets[vertex];
+		    inOffsets[vertex + 1]  += inOffsets[vertex];
+		}
+
+		// Counting sort of the edges into the rows of their
+		// source and target, keeps the order of the edge ids
+		std::vector<std::size_t> outFill(outOffsets.begin(), outOffsets.end() - 1);
+		std::vector<std::size_t> inFill(inOffsets.begin(), inOffsets.end() - 1);
+		outEdges.resize(edges.size());
+		outTargets.resize(edges.size());
+		inEdges.resize(edges.size());
+
+		for(EdgeID edgeId = 0; edgeId < edges.size(); ++edgeId){
+		    std::size_t const out_i = outFill[edgeSources[edgeId]]++;
+		    outEdges[out_i]   = edgeId;
+		    outTargets[out_i] = edgeTargets[edgeId];
+		    inEdges[inFill[edgeTargets[edgeId]]++] = edgeId;
+		}
+
+	    }
+
+            /*******************************************************************
+             * GRAPH OPERATIONS
+             ******************************************************************/
+
+	    /**
+	     * @brief Returns all vertices of the graph
+	     *
+	     */
+	    std::pair<AllVertexIter, AllVertexIter> getVertices(){
+		return std::make_pair(AllVertexIter(0), AllVertexIter(vertexProperties.size()));
+
+	    }
+
+	    /**
+	     * @brief Returns the edge between source and target vertex.
+	     *
+	     */
+	    std::pair<EdgeID, bool> getEdge(const VertexID source, const VertexID target){
+		for(std::size_t out_i = outOffsets[source]; out_i < outOffsets[source + 1]; ++out_i){
+		    if(outTargets[out_i] == target){
+			return std::make_pair(outEdges[out_i], true);
+		    }
+		}
+		return std::make_pair(EdgeID(0), false);
+	    }
+
+	    /**
+	     * @brief Returns all vertices, that are adjacent (connected) to *vertex*
+	     *
+	     */
+	    std::pair<AdjacentVertexIter, AdjacentVertexIter>  getAdjacentVertices(const VertexID id){
+		return std::make_pair(outTargets.cbegin() + outOffsets[id], outTargets.cbegin() + outOffsets[id + 1]);
+	    }
+
+	    /**
+	     * @brief Returns all outgoing edges of *srcVertex*.
+	     *
+	     */
+	    std::pair<OutEdgeIter, OutEdgeIter> getOutEdges(const VertexID id){
+		return std::make_pair(outEdges.cbegin() + outOffsets[id], outEdges.cbegin() + outOffsets[id + 1]);
+	    }
+
+	    /**
+	     * @brief Returns all incoming edges to *targetVertex*.
+	     *
+	     */
+	    std::pair<InEdgeIter, InEdgeIter> getInEdges(const VertexID id){
+		return std::make_pair(inEdges.cbegin() + inOffsets[id], inEdges.cbegin() + inOffsets[id + 1]);
+	    }
+
+	    /**
+	     * @brief Returns the property of *vertex*.
+	     *
+	     */
+	    std::pair<VertexID, VertexProperty>& getVertexProperty(const VertexID vertex){
+		return vertexProperties[vertex];
+	    }
+
+	    /**
+	     * @brief Return the property of *edge*.
+	     *
+	     */
+	    std::pair<EdgeID, EdgeProperty>& getEdgeProperty(const EdgeID edge){
+		return edgeProperties[edge];
+	    }
+
+	    /**
+	     * @brief Return the vertex to which *edge* points to.
+	     *
+	     */
+	    VertexID getEdgeTarget(const EdgeID edge){
+		return edgeTargets[edge];
+	    }
+
+	    /**
+	     * @brief Return the vertex to which *edge* points from.
+	     *
+	     */
+	    VertexID getEdgeSource(const EdgeID edge){
+		return edgeSources[edge];
+	    }
+
+	};
+
+    } // namespace graphPolicy
+
+} // namespace graybat
@@ -63,6 +63,14 @@ namespace graybat {
         using VertexID = size_t;
         using EdgeID   = size_t;        
         using GraphID  = size_t;
+
+        /**
+         * @brief Default property of vertices and edges, that
+         *        carry no data besides their id.
+         */
+        struct SimpleProperty{
+
+        };
         
         template <typename T_GraphPolicy>        
         using VertexDescription = std::pair<VertexID, VertexProperty<T_GraphPolicy> >;
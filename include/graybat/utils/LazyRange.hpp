@@ -0,0 +1,164 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <cstddef>  /* std::size_t, std::ptrdiff_t */
+#include <iterator> /* std::distance, std::next, std::forward_iterator_tag */
+#include <vector>   /* std::vector */
+
+// BOOST
+#include <boost/optional.hpp> /* boost::optional */
+
+namespace utils {
+
+    /**
+     * @brief Iterator, that builds its value from the element of the
+     *        underlying iterator not until it is dereferenced.
+     *
+     * The value is kept in the iterator, thus references to it stay
+     * valid until the iterator is moved on. Copies of the iterator
+     * build their own value.
+     *
+     */
+    template <typename T_Value, typename T_Iter, typename T_Make>
+    class LazyIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T_Value;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T_Value*;
+        using reference         = T_Value&;
+
+        LazyIterator(T_Iter iter, T_Make make) :
+            iter(iter),
+            make(make){
+
+        }
+
+        LazyIterator(LazyIterator const &other) :
+            iter(other.iter),
+            make(other.make){
+
+        }
+
+        LazyIterator& operator=(LazyIterator const &other){
+            iter = other.iter;
+            make = other.make;
+            value.reset();
+            return *this;
+        }
+
+        T_Value& operator*() const {
+            value.reset();
+            value.emplace(make(*iter));
+            return *value;
+        }
+
+        T_Value* operator->() const {
+            return &(**this);
+        }
+
+        LazyIterator& operator++(){
+            ++iter;
+            value.reset();
+            return *this;
+        }
+
+        LazyIterator operator++(int){
+            LazyIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(LazyIterator const &other) const {
+            return iter == other.iter;
+        }
+
+        bool operator!=(LazyIterator const &other) const {
+            return iter != other.iter;
+        }
+
+    private:
+        T_Iter iter;
+        T_Make make;
+        mutable boost::optional<T_Value> value;
+
+    };
+
+    /**
+     * @brief Pair of lazy iterators, that can be used in range based
+     *        for loops without allocating a container of values.
+     *
+     * Converts to a std::vector of all values for code, that keeps
+     * the values or visits them several times.
+     *
+     */
+    template <typename T_Value, typename T_Iter, typename T_Make>
+    class LazyRange {
+    public:
+        using iterator   = LazyIterator<T_Value, T_Iter, T_Make>;
+        using value_type = T_Value;
+
+        LazyRange(T_Iter first, T_Iter last, T_Make make) :
+            first(first),
+            last(last),
+            make(make){
+
+        }
+
+        iterator begin() const {
+            return iterator(first, make);
+        }
+
+        iterator end() const {
+            return iterator(last, make);
+        }
+
+        std::size_t size() const {
+            return static_cast<std::size_t>(std::distance(first, last));
+        }
+
+        bool empty() const {
+            return first == last;
+        }
+
+        T_Value operator[](std::size_t const i) const {
+            return make(*std::next(first, i));
+        }
+
+        operator std::vector<T_Value>() const {
+            std::vector<T_Value> values;
+            values.reserve(size());
+            for(T_Iter iter = first; iter != last; ++iter){
+                values.push_back(make(*iter));
+            }
+            return values;
+        }
+
+    private:
+        T_Iter first;
+        T_Iter last;
+        T_Make make;
+
+    };
+
+} /* utils */
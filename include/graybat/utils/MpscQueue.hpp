@@ -0,0 +1,103 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <atomic>  /* std::atomic */
+#include <utility> /* std::move */
+
+// BOOST
+#include <boost/optional.hpp>
+
+namespace utils {
+
+    /**
+     * @brief Unbounded lock-free queue for many producers and a
+     *        single consumer.
+     *
+     * Producers append a node with a single atomic exchange on the
+     * head and link it to its predecessor afterwards. The consumer
+     * owns the tail and only follows these links, thus a node that is
+     * appended but not linked yet is not visible until its producer
+     * has finished the push.
+     *
+     */
+    template <typename T_Value>
+    struct MpscQueue {
+
+        MpscQueue() :
+            head(new Node()),
+            tail(head.load()){
+
+        }
+
+        MpscQueue(MpscQueue const &) = delete;
+        MpscQueue& operator=(MpscQueue const &) = delete;
+
+        ~MpscQueue(){
+            while(tail){
+                Node *next = tail->next.load();
+                delete tail;
+                tail = next;
+            }
+        }
+
+        /**
+         * @brief May be called by any thread.
+         *
+         */
+        void push(T_Value&& value){
+            Node *node = new Node();
+            node->value = std::move(value);
+            Node *prev = head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        /**
+         * @brief Must only be called by the consumer. Returns false if
+         *        no linked value is available.
+         *
+         */
+        bool tryPop(T_Value &value){
+            Node *next = tail->next.load(std::memory_order_acquire);
+            if(!next){
+                return false;
+            }
+            value = std::move(*next->value);
+            next->value = boost::none;
+            delete tail;
+            tail = next;
+            return true;
+        }
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            boost::optional<T_Value> value;
+        };
+
+        // The tail is a consumed node, whose successor is the front
+        std::atomic<Node*> head;
+        Node *tail;
+
+    };
+
+} /* utils */
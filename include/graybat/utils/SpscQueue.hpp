@@ -0,0 +1,111 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <atomic>  /* std::atomic */
+#include <utility> /* std::move */
+
+// BOOST
+#include <boost/optional.hpp>
+
+namespace utils {
+
+    /**
+     * @brief Unbounded lock-free queue for a single producer and a
+     *        single consumer.
+     *
+     * The producer owns the head and links new nodes with a release
+     * store, the consumer owns the tail and only follows these links.
+     * Head and tail are kept on different cache lines, thus producer
+     * and consumer do not share a line unless the queue is empty.
+     *
+     */
+    template <typename T_Value>
+    struct SpscQueue {
+
+        SpscQueue() :
+            head(new Node()),
+            tail(head){
+
+        }
+
+        SpscQueue(SpscQueue const &) = delete;
+        SpscQueue& operator=(SpscQueue const &) = delete;
+
+        ~SpscQueue(){
+            while(tail){
+                Node *next = tail->next.load();
+                delete tail;
+                tail = next;
+            }
+        }
+
+        /**
+         * @brief Must only be called by the producer.
+         *
+         */
+        void push(T_Value&& value){
+            Node *node = new Node();
+            node->value = std::move(value);
+            head->next.store(node, std::memory_order_release);
+            head = node;
+        }
+
+        /**
+         * @brief Must only be called by the consumer. Returns false if
+         *        no value is available.
+         *
+         */
+        bool tryPop(T_Value &value){
+            Node *next = tail->next.load(std::memory_order_acquire);
+            if(!next){
+                return false;
+            }
+            value = std::move(*next->value);
+            next->value = boost::none;
+            delete tail;
+            tail = next;
+            return true;
+        }
+
+        /**
+         * @brief Must only be called by the consumer.
+         *
+         */
+        bool empty() const {
+            return tail->next.load(std::memory_order_acquire) == nullptr;
+        }
+
+    private:
+        struct Node {
+            std::atomic<Node*> next{nullptr};
+            boost::optional<T_Value> value;
+        };
+
+        // The tail is a consumed node, whose successor is the front
+        Node *head;
+        char padding[64 - sizeof(Node*)];
+        Node *tail;
+
+    };
+
+} /* utils */
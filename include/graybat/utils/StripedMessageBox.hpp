@@ -0,0 +1,355 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// STL
+#include <array>              /* std::array */
+#include <atomic>             /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <cstdint>            /* std::uint64_t */
+#include <functional>         /* std::hash */
+#include <initializer_list>   /* std::initializer_list */
+#include <mutex>              /* std::mutex, std::lock_guard, std::unique_lock */
+#include <queue>              /* std::queue */
+#include <tuple>              /* std::tuple, std::get, std::forward_as_tuple */
+#include <unordered_map>      /* std::unordered_map */
+#include <utility>            /* std::forward, std::index_sequence, std::piecewise_construct */
+
+// HANA
+#include <boost/hana.hpp>
+namespace hana = boost::hana;
+
+namespace utils {
+
+    /**
+     * @brief Composite key of a StripedMessageBox. All keys are packed
+     *        into one tuple and the hash is computed only once on
+     *        construction, since it is needed twice: to select the
+     *        stripe and to look up the queue within the stripe.
+     *
+     */
+    template <typename... T_Keys>
+    struct PackedKey {
+        using Keys = std::tuple<T_Keys...>;
+
+        Keys keys;
+        // 64 bit on every platform, since the stripe is selected by the upper bits
+        std::uint64_t hash;
+
+        PackedKey(const T_Keys... keys) :
+            keys(keys...),
+            hash(hashKeys(std::index_sequence_for<T_Keys...>())){
+
+        }
+
+        bool operator==(PackedKey const &other) const {
+            return hash == other.hash && keys == other.keys;
+        }
+
+        /**
+         * @brief Returns true if the first sizeof...(T_SubKeys)
+         *        keys are equal to *subKeys*.
+         *
+         */
+        template <typename... T_SubKeys>
+        bool startsWith(const T_SubKeys... subKeys) const {
+            return startsWithImpl(std::make_tuple(subKeys...), std::index_sequence_for<T_SubKeys...>());
+        }
+
+        hana::tuple<T_Keys...> toHana() const {
+            return toHanaImpl(std::index_sequence_for<T_Keys...>());
+        }
+
+    private:
+        static std::uint64_t mix(std::uint64_t x){
+            // splitmix64 finalizer
+            x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        template <std::size_t... I>
+        std::uint64_t hashKeys(std::index_sequence<I...>) const {
+            std::uint64_t h = 0;
+            (void)std::initializer_list<int>{
+                (h = mix(h ^ static_cast<std::uint64_t>(std::hash<T_Keys>()(std::get<I>(keys)))), 0)...
+            };
+            return h;
+        }
+
+        template <typename T_SubKeysTpl, std::size_t... I>
+        bool startsWithImpl(T_SubKeysTpl const &subKeys, std::index_sequence<I...>) const {
+            bool equal = true;
+            (void)std::initializer_list<int>{ (equal = equal && (std::get<I>(keys) == std::get<I>(subKeys)), 0)... };
+            return equal;
+        }
+
+        template <std::size_t... I>
+        hana::tuple<T_Keys...> toHanaImpl(std::index_sequence<I...>) const {
+            return hana::make_tuple(std::get<I>(keys)...);
+        }
+
+    };
+
+    template <typename T_Key>
+    struct PackedKeyHash {
+        std::size_t operator()(T_Key const &key) const {
+            // Keeps the lower bits, which select the bucket, if std::size_t is 32 bit
+            return static_cast<std::size_t>(key.hash);
+        }
+    };
+
+
+    /**
+     * @brief A message box with the same interface as MessageBox, but
+     *        implemented by a flat hash table instead of cascaded std::maps.
+     *
+     * The hash table is split into stripes, each with its own lock and
+     * queues, thus the receive handler and the threads dequeueing messages
+     * only contend when they access keys of the same stripe. Empty queues
+     * are removed, so the table only contains keys with pending messages
+     * or waiting threads.
+     *
+     * Waiting threads register at the slot of their key and are woken by
+     * the enqueue of exactly this key. Threads that wait for a key prefix
+     * are woken by every enqueue while they wait.
+     *
+     */
+    template <typename T_Value, typename... T_Keys>
+    struct StripedMessageBox {
+
+        using Key   = PackedKey<T_Keys...>;
+        using Queue = std::queue<T_Value>;
+
+        static constexpr std::size_t nStripes = 64;
+
+        struct Slot {
+            Queue values;
+            std::size_t waiters = 0;
+            std::condition_variable condition;
+        };
+
+        struct StripeData {
+            std::mutex access;
+            std::unordered_map<Key, Slot, PackedKeyHash<Key> > slots;
+        };
+
+        // Padded instead of aligned, since the box is allocated with
+        // new, which ignores extended alignment before C++17
+        struct Stripe : StripeData {
+            char padding[64 - sizeof(StripeData) % 64];
+        };
+
+        StripedMessageBox(size_t const maxBufferSize) :
+            maxBufferSize(maxBufferSize),
+            bufferSize(0),
+            blockedWriters(0),
+            prefixWaiters(0),
+            prefixGeneration(0){
+        }
+
+        size_t maxBufferSize;
+        std::atomic<size_t> bufferSize;
+
+        auto enqueue(T_Value&& value, const T_Keys... keys) -> void {
+            if(maxBufferSize < bufferSize + value.size()){
+                std::unique_lock<std::mutex> notifyLock(readNotify);
+                ++blockedWriters;
+                readCondition.wait(notifyLock, [&]{ return maxBufferSize >= bufferSize + value.size(); });
+                --blockedWriters;
+            }
+
+            bufferSize += value.size();
+            Key key(keys...);
+            Stripe &stripe = stripeOf(key);
+            {
+                std::lock_guard<std::mutex> accessLock(stripe.access);
+                Slot &slot = stripe.slots[key];
+                slot.values.push(std::forward<T_Value>(value));
+                if(slot.waiters){
+                    slot.condition.notify_one();
+                }
+            }
+
+            if(prefixWaiters){
+                {
+                    std::lock_guard<std::mutex> notifyLock(prefixNotify);
+                    ++prefixGeneration;
+                }
+                prefixCondition.notify_all();
+            }
+        }
+
+        auto waitDequeue(const T_Keys... keys) -> T_Value {
+            Key key(keys...);
+            Stripe &stripe = stripeOf(key);
+            std::unique_lock<std::mutex> accessLock(stripe.access);
+            auto it = stripe.slots.find(key);
+            if(it == stripe.slots.end()){
+                it = stripe.slots.emplace(std::piecewise_construct,
+                                          std::forward_as_tuple(key),
+                                          std::forward_as_tuple()).first;
+            }
+            Slot &slot = it->second;
+
+            if(slot.values.empty()){
+                // The wait releases the lock, enqueues of other keys may
+                // rehash the stripe meanwhile. This keeps the slot, but
+                // not the iterator, thus the key is looked up again
+                ++slot.waiters;
+                slot.condition.wait(accessLock, [&slot]{ return !slot.values.empty(); });
+                --slot.waiters;
+                it = stripe.slots.find(key);
+            }
+            return pop(stripe, it);
+
+        }
+
+        /**
+         * @brief Dequeues a message of any key that starts with
+         *        *someKeys*. The complete key of the message is
+         *        returned in *allKeys*.
+         *
+         */
+        template <typename... SubKeys>
+        auto waitDequeue(hana::tuple<T_Keys...> &allKeys, const SubKeys... someKeys) -> T_Value {
+            PrefixWaiter waiter(*this);
+
+            while(true){
+                std::size_t generation;
+                {
+                    std::lock_guard<std::mutex> notifyLock(prefixNotify);
+                    generation = prefixGeneration;
+                }
+
+                // Each scan takes new iterators under the lock of the
+                // stripe, none of them is kept across the wait below
+                for(Stripe &stripe : stripes){
+                    std::lock_guard<std::mutex> accessLock(stripe.access);
+                    for(auto it = stripe.slots.begin(); it != stripe.slots.end(); ++it){
+                        if(it->first.startsWith(someKeys...) && !it->second.values.empty()){
+                            allKeys = it->first.toHana();
+                            return pop(stripe, it);
+                        }
+                    }
+                }
+
+                std::unique_lock<std::mutex> notifyLock(prefixNotify);
+                prefixCondition.wait(notifyLock, [&]{ return prefixGeneration != generation; });
+
+            }
+
+        }
+
+        /**
+         * @brief Dequeues a message of any key that starts with
+         *        *someKeys* without waiting, *result* tells whether
+         *        there was one. The complete key of the message is
+         *        returned in *allKeys*.
+         *
+         */
+        template <typename... SubKeys>
+        auto tryDequeue(bool &result, hana::tuple<T_Keys...> &allKeys, const SubKeys... someKeys) -> T_Value {
+            for(Stripe &stripe : stripes){
+                std::lock_guard<std::mutex> accessLock(stripe.access);
+                for(auto it = stripe.slots.begin(); it != stripe.slots.end(); ++it){
+                    if(it->first.startsWith(someKeys...) && !it->second.values.empty()){
+                        allKeys = it->first.toHana();
+                        result = true;
+                        return pop(stripe, it);
+                    }
+                }
+            }
+            result = false;
+            return T_Value();
+
+        }
+
+        auto tryDequeue(bool &result, const T_Keys... keys) -> T_Value {
+            Key key(keys...);
+            Stripe &stripe = stripeOf(key);
+            std::lock_guard<std::mutex> accessLock(stripe.access);
+            auto it = stripe.slots.find(key);
+            if(it == stripe.slots.end() || it->second.values.empty()){
+                result = false;
+                return T_Value();
+            }
+            result = true;
+            return pop(stripe, it);
+        }
+
+    private:
+        std::array<Stripe, nStripes> stripes;
+
+        std::mutex readNotify;
+        std::condition_variable readCondition;
+        std::atomic<std::size_t> blockedWriters;
+
+        std::mutex prefixNotify;
+        std::condition_variable prefixCondition;
+        std::atomic<std::size_t> prefixWaiters;
+        std::size_t prefixGeneration;
+
+        /**
+         * @brief Announces a prefix waiter for its lifetime, so that
+         *        enqueue only touches the prefix condition when
+         *        somebody waits on it.
+         *
+         */
+        struct PrefixWaiter {
+            StripedMessageBox &box;
+
+            PrefixWaiter(StripedMessageBox &box) : box(box) {
+                ++box.prefixWaiters;
+            }
+
+            ~PrefixWaiter(){
+                --box.prefixWaiters;
+            }
+        };
+
+        Stripe& stripeOf(Key const &key){
+            // The lower bits select the bucket within the stripe, the upper the stripe
+            return stripes[(key.hash >> 40) % nStripes];
+        }
+
+        template <typename T_Iter>
+        auto pop(Stripe &stripe, T_Iter it) -> T_Value {
+            T_Value value = std::move(it->second.values.front());
+            it->second.values.pop();
+            if(it->second.values.empty() && !it->second.waiters){
+                stripe.slots.erase(it);
+            }
+
+            bufferSize -= value.size();
+            if(blockedWriters){
+                {
+                    std::lock_guard<std::mutex> notifyLock(readNotify);
+                }
+                readCondition.notify_all();
+            }
+            return value;
+        }
+
+    };
+
+} /* utils */
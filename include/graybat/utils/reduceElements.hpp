@@ -0,0 +1,178 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// CLIB
+#include <string.h>    /* memcpy */
+
+// STL
+#include <cstddef>     /* std::size_t */
+#include <functional>  /* std::plus, std::multiplies */
+#include <type_traits> /* std::integral_constant, std::is_integral, std::is_same */
+
+namespace utils {
+
+    /**
+     * @brief Minimum of two values, reductions with this operator
+     *        are vectorized.
+     *
+     */
+    template <typename T_Value>
+    struct minimum {
+        T_Value operator()(T_Value const & lhs, T_Value const & rhs) const {
+            return rhs < lhs ? rhs : lhs;
+        }
+    };
+
+    /**
+     * @brief Maximum of two values, reductions with this operator
+     *        are vectorized.
+     *
+     */
+    template <typename T_Value>
+    struct maximum {
+        T_Value operator()(T_Value const & lhs, T_Value const & rhs) const {
+            return lhs < rhs ? rhs : lhs;
+        }
+    };
+
+    namespace detail {
+
+        // Values a vector register holds, long double has no vector type
+        template <typename T_Value>
+        struct IsVectorValue : std::integral_constant<bool,
+                                                      (std::is_integral<T_Value>::value && !std::is_same<T_Value, bool>::value)
+                                                      || std::is_same<T_Value, float>::value
+                                                      || std::is_same<T_Value, double>::value> {};
+
+        // Operators with a vector variant, applied to whole vectors.
+        // The operator needs to take T_Value itself, std::plus<int>
+        // on floats truncates
+        template <typename T_Op, typename T_Value>
+        struct VectorOp : std::false_type {};
+
+        template <typename T_Value>
+        struct VectorOp<std::plus<T_Value>, T_Value> : std::true_type {
+            template <typename T_Vector>
+            static void apply(T_Vector const & lhs, T_Vector const & rhs, T_Vector & result){
+                result = lhs + rhs;
+            }
+        };
+
+        template <typename T_Value>
+        struct VectorOp<std::plus<>, T_Value> : VectorOp<std::plus<T_Value>, T_Value> {};
+
+        template <typename T_Value>
+        struct VectorOp<std::multiplies<T_Value>, T_Value> : std::true_type {
+            template <typename T_Vector>
+            static void apply(T_Vector const & lhs, T_Vector const & rhs, T_Vector & result){
+                result = lhs * rhs;
+            }
+        };
+
+        template <typename T_Value>
+        struct VectorOp<std::multiplies<>, T_Value> : VectorOp<std::multiplies<T_Value>, T_Value> {};
+
+        // Comparisons yield a mask of integers of the same width, the
+        // lanes are selected bitwise
+        template <typename T_Value>
+        struct VectorOp<minimum<T_Value>, T_Value> : std::true_type {
+            template <typename T_Vector>
+            static void apply(T_Vector const & lhs, T_Vector const & rhs, T_Vector & result){
+                using Mask = decltype(rhs < lhs);
+                Mask const takeRhs = rhs < lhs;
+                result = (T_Vector)(((Mask)rhs & takeRhs) | ((Mask)lhs & ~takeRhs));
+            }
+        };
+
+        template <typename T_Value>
+        struct VectorOp<maximum<T_Value>, T_Value> : std::true_type {
+            template <typename T_Vector>
+            static void apply(T_Vector const & lhs, T_Vector const & rhs, T_Vector & result){
+                using Mask = decltype(lhs < rhs);
+                Mask const takeRhs = lhs < rhs;
+                result = (T_Vector)(((Mask)rhs & takeRhs) | ((Mask)lhs & ~takeRhs));
+            }
+        };
+
+        template <typename T_Value, typename T_Op>
+        void reduceElements(T_Op const op, T_Value const * lhs, T_Value const * rhs, T_Value * result, std::size_t const nElements, std::false_type){
+            for(std::size_t i = 0; i < nElements; ++i){
+                result[i] = op(lhs[i], rhs[i]);
+            }
+
+        }
+
+#if defined(__GNUC__)
+        // Vectors wider than the registers of the target are split by
+        // the compiler, which turns the selects of minimum and maximum
+        // into scalar code
+#if defined(__AVX512F__)
+        constexpr std::size_t vectorBytes = 64;
+#elif defined(__AVX__)
+        constexpr std::size_t vectorBytes = 32;
+#else
+        constexpr std::size_t vectorBytes = 16;
+#endif
+
+        template <typename T_Value, typename T_Op>
+        void reduceElements(T_Op const op, T_Value const * lhs, T_Value const * rhs, T_Value * result, std::size_t const nElements, std::true_type){
+            typedef T_Value Vector __attribute__((vector_size(vectorBytes)));
+            std::size_t const nLanes = sizeof(Vector) / sizeof(T_Value);
+
+            // The buffers need not be aligned, result may alias lhs or rhs
+            std::size_t i = 0;
+            for(; i + nLanes <= nElements; i += nLanes){
+                Vector lhsVector;
+                Vector rhsVector;
+                memcpy(&lhsVector, lhs + i, sizeof(Vector));
+                memcpy(&rhsVector, rhs + i, sizeof(Vector));
+                Vector resultVector;
+                VectorOp<T_Op, T_Value>::apply(lhsVector, rhsVector, resultVector);
+                memcpy(result + i, &resultVector, sizeof(Vector));
+            }
+            reduceElements(op, lhs + i, rhs + i, result + i, nElements - i, std::false_type());
+
+        }
+#else
+        template <typename T_Value, typename T_Op>
+        void reduceElements(T_Op const op, T_Value const * lhs, T_Value const * rhs, T_Value * result, std::size_t const nElements, std::true_type){
+            reduceElements(op, lhs, rhs, result, nElements, std::false_type());
+        }
+#endif
+
+    } /* detail */
+
+    /**
+     * @brief Combines two buffers element-wise, result[i] = op(lhs[i], rhs[i]).
+     *
+     * std::plus, std::multiplies, minimum and maximum on float, double
+     * and integers are applied to whole vectors of elements. Other
+     * operators and values are applied element by element.
+     *
+     */
+    template <typename T_Value, typename T_Op>
+    void reduceElements(T_Op const op, T_Value const * lhs, T_Value const * rhs, T_Value * result, std::size_t const nElements){
+        detail::reduceElements(op, lhs, rhs, result, nElements,
+                               std::integral_constant<bool, detail::VectorOp<T_Op, T_Value>::value && detail::IsVectorValue<T_Value>::value>());
+    }
+
+} /* utils */
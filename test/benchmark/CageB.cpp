@@ -35,6 +35,24 @@ ZMQConfig zmqConfig = {
     "context_cage_test"};
 ZMQCage zmqCage(zmqConfig);
 
+ZMQConfig zmqConfirmConfig = {
+    "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_cage_confirm_test", 100 * 1000 * 1000, true};
+ZMQCage zmqConfirmCage(zmqConfirmConfig);
+
+ZMQConfig zmqZeroCopyConfig = {
+    "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_cage_zero_copy_test", 100 * 1000 * 1000, false, 1, true};
+ZMQCage zmqZeroCopyCage(zmqZeroCopyConfig);
+
+ZMQConfig zmqCoalesceConfig = {
+    "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_cage_coalesce_test", 100 * 1000 * 1000, false, 1, false, 1, 64 * 1024};
+ZMQCage zmqCoalesceCage(zmqCoalesceConfig);
+
 BMPIConfig bmpiConfig;
 BMPICage bmpiCage(bmpiConfig);
 
@@ -84,6 +102,57 @@ static void meassureSingleMessageSendBmpi(benchmark::State &state) {
   }
 }
 ////////////////////////////////////////////////////////////////////////////////
+static void meassureChannelSendBmpi(benchmark::State &state) {
+  auto &cage = bmpiCage;
+
+  using Cage = decltype(bmpiCage);
+  using GP = typename Cage::GraphPolicy;
+  using Vertex = typename Cage::Vertex;
+  using Edge = typename Cage::Edge;
+  using SendChannel = typename Cage::template SendChannel<std::vector<unsigned>>;
+  using RecvChannel = typename Cage::template RecvChannel<std::vector<unsigned>>;
+
+  cage.setGraph(graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+  cage.distribute(graybat::mapping::Roundrobin());
+
+  const unsigned nElements = state.range(0);
+
+  std::vector<unsigned> send(nElements, 0);
+  std::vector<unsigned> recv(nElements, 0);
+
+  for (unsigned i = 0; i < send.size(); ++i) {
+    send.at(i) = i;
+  }
+
+  // Bind the edges once, the loop only starts and waits
+  std::vector<SendChannel> sendChannels;
+  std::vector<RecvChannel> recvChannels;
+  for (Vertex &v : cage.getHostedVertices()) {
+    for (Edge edge : cage.getOutEdges(v)) {
+      sendChannels.push_back(cage.bindSend(edge, send));
+    }
+    for (Edge edge : cage.getInEdges(v)) {
+      recvChannels.push_back(cage.bindRecv(edge, recv));
+    }
+  }
+
+  while (state.KeepRunning()) {
+    for (SendChannel &channel : sendChannels) {
+      channel.start();
+    }
+
+    // Receives into the same buffer, thus one after another
+    for (RecvChannel &channel : recvChannels) {
+      channel.start();
+      channel.wait();
+    }
+
+    for (SendChannel &channel : sendChannels) {
+      channel.wait();
+    }
+  }
+}
+////////////////////////////////////////////////////////////////////////////////
 static void meassureSingleMessageSendZmq(benchmark::State &state) {
     while (state.KeepRunning()) {
 
@@ -128,9 +197,148 @@ static void meassureSingleMessageSendZmq(benchmark::State &state) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+static void meassureSingleMessageSendZmqConfirm(benchmark::State &state) {
+    while (state.KeepRunning()) {
+
+        auto &cage = zmqConfirmCage;
+
+        using Cage = decltype(zmqConfirmCage);
+        using GP = typename Cage::GraphPolicy;
+        using Event = typename Cage::Event;
+        using Vertex = typename Cage::Vertex;
+        using Edge = typename Cage::Edge;
+
+        cage.setGraph(graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+        cage.distribute(graybat::mapping::Roundrobin());
+
+        const unsigned nElements = state.range(0);
+
+        std::vector<Event> events;
+        std::vector<unsigned> send(nElements, 0);
+        std::vector<unsigned> recv(nElements, 0);
+
+        for (unsigned i = 0; i < send.size(); ++i) {
+            send.at(i) = i;
+        }
+
+        // Send state to neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getOutEdges(v)) {
+                cage.send(edge, send, events);
+            }
+        }
+
+        // Recv state from neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getInEdges(v)) {
+                cage.recv(edge, recv);
+            }
+        }
+
+        for (Event &e : events) {
+            e.wait();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void meassureSingleMessageSendZmqZeroCopy(benchmark::State &state) {
+    while (state.KeepRunning()) {
+
+        auto &cage = zmqZeroCopyCage;
+
+        using Cage = decltype(zmqZeroCopyCage);
+        using GP = typename Cage::GraphPolicy;
+        using Event = typename Cage::Event;
+        using Vertex = typename Cage::Vertex;
+        using Edge = typename Cage::Edge;
+
+        cage.setGraph(graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+        cage.distribute(graybat::mapping::Roundrobin());
+
+        const unsigned nElements = state.range(0);
+
+        std::vector<Event> events;
+        std::vector<unsigned> send(nElements, 0);
+        std::vector<unsigned> recv(nElements, 0);
+
+        for (unsigned i = 0; i < send.size(); ++i) {
+            send.at(i) = i;
+        }
+
+        // Send state to neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getOutEdges(v)) {
+                cage.send(edge, send, events);
+            }
+        }
+
+        // Recv state from neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getInEdges(v)) {
+                cage.recv(edge, recv);
+            }
+        }
+
+        for (Event &e : events) {
+            e.wait();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void meassureSingleMessageSendZmqCoalesce(benchmark::State &state) {
+    while (state.KeepRunning()) {
+
+        auto &cage = zmqCoalesceCage;
+
+        using Cage = decltype(zmqCoalesceCage);
+        using GP = typename Cage::GraphPolicy;
+        using Event = typename Cage::Event;
+        using Vertex = typename Cage::Vertex;
+        using Edge = typename Cage::Edge;
+
+        cage.setGraph(graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+        cage.distribute(graybat::mapping::Roundrobin());
+
+        const unsigned nElements = state.range(0);
+
+        std::vector<Event> events;
+        std::vector<unsigned> send(nElements, 0);
+        std::vector<unsigned> recv(nElements, 0);
+
+        for (unsigned i = 0; i < send.size(); ++i) {
+            send.at(i) = i;
+        }
+
+        // Send state to neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getOutEdges(v)) {
+                cage.send(edge, send, events);
+            }
+        }
+
+        // Recv state from neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getInEdges(v)) {
+                cage.recv(edge, recv);
+            }
+        }
+
+        for (Event &e : events) {
+            e.wait();
+        }
+    }
+}
+
 
 BENCHMARK(meassureSingleMessageSendBmpi)->RangeMultiplier(10)->Range(1, 1000000);
+BENCHMARK(meassureChannelSendBmpi)->RangeMultiplier(10)->Range(1, 1000000);
 BENCHMARK(meassureSingleMessageSendZmq)->RangeMultiplier(10)->Range(1, 1000000);
+BENCHMARK(meassureSingleMessageSendZmqConfirm)->RangeMultiplier(10)->Range(1, 1000000);
+BENCHMARK(meassureSingleMessageSendZmqZeroCopy)->RangeMultiplier(10)->Range(1, 1000000);
+BENCHMARK(meassureSingleMessageSendZmqCoalesce)->RangeMultiplier(10)->Range(1, 1000000);
 
 
 BENCHMARK_MAIN()
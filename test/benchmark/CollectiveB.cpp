@@ -0,0 +1,114 @@
+#include <graybat/communicationPolicy/SHM.hpp>
+#include <graybat/communicationPolicy/ZMQ.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+// run: mpiexec -n 4 benchmark --benchmark_filter='Broadcast|Reduce'
+// with a zmq signaling server at tcp://127.0.0.1:5000
+
+using SHM = graybat::communicationPolicy::SHM;
+using SHMConfig = SHM::Config;
+
+using ZMQ = graybat::communicationPolicy::ZMQ;
+using ZMQConfig = ZMQ::Config;
+
+SHMConfig shmCollectiveConfig = {
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_shm_collective_benchmark"};
+SHM shmCollectiveCP(shmCollectiveConfig);
+
+// Same transport, the segment size of broadcast and reduce differs
+ZMQConfig zmqUnsegmentedConfig = {
+    "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_collective_unsegmented_benchmark", 100 * 1000 * 1000, false, 1, false, 1, 0, 100, 0};
+ZMQ zmqUnsegmentedCP(zmqUnsegmentedConfig);
+
+ZMQConfig zmqSegment64KConfig = {
+    "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_collective_segment_64k_benchmark", 100 * 1000 * 1000, false, 1, false, 1, 0, 100, 64 * 1024};
+ZMQ zmqSegment64KCP(zmqSegment64KConfig);
+
+ZMQConfig zmqSegment1MConfig = {
+    "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_collective_segment_1m_benchmark", 100 * 1000 * 1000, false, 1, false, 1, 0, 100, 1024 * 1024};
+ZMQ zmqSegment1MCP(zmqSegment1MConfig);
+
+////////////////////////////////////////////////////////////////////////////////
+// Broadcast of state.range(0) bytes from the peer with vAddr 0 to all
+// other peers. The number of iterations is fixed, since all peers need
+// to take part in the same number of broadcasts.
+template <typename T_CP>
+void broadcast(benchmark::State &state, T_CP &cp) {
+  auto context = cp.getGlobalContext();
+  std::vector<char> data(state.range(0));
+
+  while (state.KeepRunning()) {
+    cp.broadcast(0, context, data);
+  }
+
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sum of state.range(0) bytes of unsigned values of all peers on the
+// peer with vAddr 0.
+template <typename T_CP>
+void reduce(benchmark::State &state, T_CP &cp) {
+  auto context = cp.getGlobalContext();
+  std::vector<unsigned> send(state.range(0) / sizeof(unsigned), 1);
+  std::vector<unsigned> recv(send.size(), 0);
+
+  while (state.KeepRunning()) {
+    cp.reduce(0, context, std::plus<unsigned>(), send, recv);
+  }
+
+  state.SetBytesProcessed(state.iterations() * send.size() * sizeof(unsigned));
+}
+
+static void meassureBroadcastSHM(benchmark::State &state) {
+  broadcast(state, shmCollectiveCP);
+}
+BENCHMARK(meassureBroadcastSHM)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureBroadcastZMQUnsegmented(benchmark::State &state) {
+  broadcast(state, zmqUnsegmentedCP);
+}
+BENCHMARK(meassureBroadcastZMQUnsegmented)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureBroadcastZMQPipelined64K(benchmark::State &state) {
+  broadcast(state, zmqSegment64KCP);
+}
+BENCHMARK(meassureBroadcastZMQPipelined64K)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureBroadcastZMQPipelined1M(benchmark::State &state) {
+  broadcast(state, zmqSegment1MCP);
+}
+BENCHMARK(meassureBroadcastZMQPipelined1M)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureReduceSHM(benchmark::State &state) {
+  reduce(state, shmCollectiveCP);
+}
+BENCHMARK(meassureReduceSHM)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureReduceZMQUnsegmented(benchmark::State &state) {
+  reduce(state, zmqUnsegmentedCP);
+}
+BENCHMARK(meassureReduceZMQUnsegmented)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureReduceZMQPipelined64K(benchmark::State &state) {
+  reduce(state, zmqSegment64KCP);
+}
+BENCHMARK(meassureReduceZMQPipelined64K)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
+
+static void meassureReduceZMQPipelined1M(benchmark::State &state) {
+  reduce(state, zmqSegment1MCP);
+}
+BENCHMARK(meassureReduceZMQPipelined1M)->RangeMultiplier(4)->Range(64 << 10, 64 << 20)->Iterations(20)->UseRealTime();
@@ -0,0 +1,120 @@
+#include <graybat/graphPolicy/BGL.hpp>
+#include <graybat/graphPolicy/CSR.hpp>
+#include <graybat/pattern/GridDiagonal.hpp>
+#include <graybat/pattern/Random.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <malloc.h>
+
+#include <memory>
+#include <tuple>
+
+// run: benchmark --benchmark_filter=Graph
+//
+// Builds the Random and GridDiagonal patterns with both graph
+// policies and walks all out and in edges the way a cage does.
+// The heap bytes of a built graph are reported per edge.
+
+using BGL = graybat::graphPolicy::BGL<>;
+using CSR = graybat::graphPolicy::CSR<>;
+
+template <typename T_GraphPolicy>
+using Random = graybat::pattern::Random<T_GraphPolicy>;
+
+template <typename T_GraphPolicy>
+using GridDiagonal = graybat::pattern::GridDiagonal<T_GraphPolicy>;
+
+////////////////////////////////////////////////////////////////////////////////
+template <typename T_GraphPolicy, typename T_Pattern>
+static void buildGraph(benchmark::State &state, T_Pattern pattern) {
+  auto const graphDesc = pattern();
+
+  while (state.KeepRunning()) {
+    T_GraphPolicy graph(graphDesc);
+    benchmark::DoNotOptimize(&graph);
+  }
+
+  // Heap in use by one graph, the description is already allocated
+  std::size_t const heapBefore = mallinfo2().uordblks;
+  std::unique_ptr<T_GraphPolicy> graph(new T_GraphPolicy(graphDesc));
+  std::size_t const heapAfter = mallinfo2().uordblks;
+
+  state.counters["bytes_per_edge"] =
+      static_cast<double>(heapAfter - heapBefore) / graphDesc.second.size();
+  state.SetItemsProcessed(state.iterations() * graphDesc.second.size());
+}
+
+template <typename T_GraphPolicy, typename T_Pattern>
+static void traverseGraph(benchmark::State &state, T_Pattern pattern) {
+  T_GraphPolicy graph(pattern());
+  std::size_t nEdges = 0;
+
+  while (state.KeepRunning()) {
+    typename T_GraphPolicy::AllVertexIter vi_first, vi_last;
+    std::tie(vi_first, vi_last) = graph.getVertices();
+
+    std::size_t sum = 0;
+    nEdges = 0;
+    for (; vi_first != vi_last; ++vi_first) {
+      typename T_GraphPolicy::OutEdgeIter oi_first, oi_last;
+      std::tie(oi_first, oi_last) = graph.getOutEdges(*vi_first);
+      for (; oi_first != oi_last; ++oi_first) {
+        sum += graph.getEdgeProperty(*oi_first).first + graph.getEdgeTarget(*oi_first);
+        ++nEdges;
+      }
+
+      typename T_GraphPolicy::InEdgeIter ii_first, ii_last;
+      std::tie(ii_first, ii_last) = graph.getInEdges(*vi_first);
+      for (; ii_first != ii_last; ++ii_first) {
+        sum += graph.getEdgeProperty(*ii_first).first + graph.getEdgeSource(*ii_first);
+        ++nEdges;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * nEdges);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static void meassureGraphBuildRandomBgl(benchmark::State &state) {
+  buildGraph<BGL>(state, Random<BGL>(state.range(0), 1, 20, 0));
+}
+
+static void meassureGraphBuildRandomCsr(benchmark::State &state) {
+  buildGraph<CSR>(state, Random<CSR>(state.range(0), 1, 20, 0));
+}
+
+static void meassureGraphBuildGridDiagonalBgl(benchmark::State &state) {
+  buildGraph<BGL>(state, GridDiagonal<BGL>(state.range(0), state.range(0)));
+}
+
+static void meassureGraphBuildGridDiagonalCsr(benchmark::State &state) {
+  buildGraph<CSR>(state, GridDiagonal<CSR>(state.range(0), state.range(0)));
+}
+
+static void meassureGraphTraverseRandomBgl(benchmark::State &state) {
+  traverseGraph<BGL>(state, Random<BGL>(state.range(0), 1, 20, 0));
+}
+
+static void meassureGraphTraverseRandomCsr(benchmark::State &state) {
+  traverseGraph<CSR>(state, Random<CSR>(state.range(0), 1, 20, 0));
+}
+
+static void meassureGraphTraverseGridDiagonalBgl(benchmark::State &state) {
+  traverseGraph<BGL>(state, GridDiagonal<BGL>(state.range(0), state.range(0)));
+}
+
+static void meassureGraphTraverseGridDiagonalCsr(benchmark::State &state) {
+  traverseGraph<CSR>(state, GridDiagonal<CSR>(state.range(0), state.range(0)));
+}
+
+BENCHMARK(meassureGraphBuildRandomBgl)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(meassureGraphBuildRandomCsr)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(meassureGraphBuildGridDiagonalBgl)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(meassureGraphBuildGridDiagonalCsr)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(meassureGraphTraverseRandomBgl)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(meassureGraphTraverseRandomCsr)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(meassureGraphTraverseGridDiagonalBgl)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK(meassureGraphTraverseGridDiagonalCsr)->RangeMultiplier(4)->Range(64, 1024);
@@ -0,0 +1,55 @@
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/utils/MultiKeyMap.hpp>
+#include <graybat/utils/StripedMessageBox.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using MsgType = graybat::communicationPolicy::MsgTypeType;
+using ContextID = unsigned;
+using VAddr = unsigned;
+using Tag = unsigned;
+
+struct Payload {
+  size_t size() const { return 1; }
+};
+
+using NestedBox = utils::MessageBox<Payload, MsgType, ContextID, VAddr, Tag>;
+using StripedBox =
+    utils::StripedMessageBox<Payload, MsgType, ContextID, VAddr, Tag>;
+
+////////////////////////////////////////////////////////////////////////////////
+// Enqueue and dequeue on a box that already holds state.range(0) live keys,
+// which is the situation of a peer with many edges and pending messages.
+template <typename T_Box>
+static void meassureEnqueueDequeue(benchmark::State &state) {
+  const unsigned nKeys = state.range(0);
+  const unsigned nVAddrs = 1000;
+
+  auto box = std::make_unique<T_Box>(static_cast<size_t>(-1));
+  for (unsigned key_i = 0; key_i < nKeys; ++key_i) {
+    box->enqueue(Payload(), MsgType::PEER, 0, key_i % nVAddrs, key_i / nVAddrs);
+  }
+
+  unsigned key_i = 0;
+  while (state.KeepRunning()) {
+    const VAddr vAddr = key_i % nVAddrs;
+    const Tag tag = key_i / nVAddrs;
+    box->enqueue(Payload(), MsgType::PEER, 0, vAddr, tag);
+    benchmark::DoNotOptimize(box->waitDequeue(MsgType::PEER, 0, vAddr, tag));
+    key_i = (key_i + 7919) % nKeys;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(meassureEnqueueDequeue, NestedBox)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+BENCHMARK_TEMPLATE(meassureEnqueueDequeue, StripedBox)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
@@ -0,0 +1,103 @@
+#include <graybat/communicationPolicy/Traits.hpp>
+#include <graybat/utils/MultiKeyMap.hpp>
+#include <graybat/utils/StripedMessageBox.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using MsgType = graybat::communicationPolicy::MsgTypeType;
+using ContextID = unsigned;
+using VAddr = unsigned;
+using Tag = unsigned;
+
+struct Message {
+  size_t size() const { return 1; }
+};
+
+using PollingBox = utils::MessageBox<Message, MsgType, ContextID, VAddr, Tag>;
+using WaiterBox =
+    utils::StripedMessageBox<Message, MsgType, ContextID, VAddr, Tag>;
+
+const VAddr pingVAddr = 0;
+const VAddr pongVAddr = 1;
+const VAddr idleVAddr = 2;
+
+////////////////////////////////////////////////////////////////////////////////
+// Ping-pong between two threads through a message box, while
+// state.range(0) further threads wait for messages on other keys, like
+// receives on edges that are currently quiet. Reports the round trip
+// latency percentiles in microseconds.
+template <typename T_Box>
+static void meassurePingPongLatency(benchmark::State &state) {
+  const unsigned nIdleWaiters = state.range(0);
+
+  auto box = std::make_unique<T_Box>(static_cast<size_t>(-1));
+
+  std::vector<std::thread> idleWaiters;
+  for (unsigned waiter_i = 0; waiter_i < nIdleWaiters; ++waiter_i) {
+    idleWaiters.emplace_back([&box, waiter_i]() {
+      box->waitDequeue(MsgType::PEER, 0, idleVAddr, waiter_i);
+    });
+  }
+
+  // The echo thread answers pings until it is stopped by a last ping
+  std::atomic<bool> stop(false);
+  std::thread echo([&box, &stop]() {
+    while (true) {
+      box->waitDequeue(MsgType::PEER, 0, pingVAddr, 0);
+      if (stop) {
+        break;
+      }
+      box->enqueue(Message(), MsgType::PEER, 0, pongVAddr, 0);
+    }
+  });
+
+  std::vector<double> latencies;
+  while (state.KeepRunning()) {
+    auto start = std::chrono::high_resolution_clock::now();
+    box->enqueue(Message(), MsgType::PEER, 0, pingVAddr, 0);
+    box->waitDequeue(MsgType::PEER, 0, pongVAddr, 0);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::chrono::duration<double> elapsed = end - start;
+    state.SetIterationTime(elapsed.count());
+    latencies.push_back(elapsed.count() * 1e6);
+  }
+
+  for (unsigned waiter_i = 0; waiter_i < nIdleWaiters; ++waiter_i) {
+    box->enqueue(Message(), MsgType::PEER, 0, idleVAddr, waiter_i);
+  }
+  for (std::thread &waiter : idleWaiters) {
+    waiter.join();
+  }
+  stop = true;
+  box->enqueue(Message(), MsgType::PEER, 0, pingVAddr, 0);
+  echo.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+  };
+  state.counters["p50_us"] = percentile(0.50);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["max_us"] = latencies.back();
+}
+
+// Each polling round trip may take up to 200 ms, thus the fixed
+// iteration count.
+BENCHMARK_TEMPLATE(meassurePingPongLatency, PollingBox)
+    ->Arg(0)
+    ->Arg(4)
+    ->Iterations(100)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(meassurePingPongLatency, WaiterBox)
+    ->Arg(0)
+    ->Arg(4)
+    ->Iterations(100)
+    ->UseManualTime();
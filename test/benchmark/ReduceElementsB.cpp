@@ -0,0 +1,59 @@
+#include <graybat/utils/reduceElements.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+// Element-wise reduction of two buffers of state.range(0) bytes into the
+// first, which is what the collectives do with every received buffer.
+// The lambdas have no vector variant and are reduced element by element.
+template <typename T_Value, typename T_Op>
+static void reduceElements(benchmark::State &state, T_Op op) {
+  std::vector<T_Value> data(state.range(0) / sizeof(T_Value), 1);
+  std::vector<T_Value> tmpData(data.size(), 1);
+
+  while (state.KeepRunning()) {
+    utils::reduceElements(op, data.data(), tmpData.data(), data.data(), data.size());
+    benchmark::DoNotOptimize(data.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T_Value));
+}
+
+static void meassureReduceElementsPlusFloat(benchmark::State &state) {
+  reduceElements<float>(state, std::plus<float>());
+}
+BENCHMARK(meassureReduceElementsPlusFloat)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+
+static void meassureReduceElementsPlusFloatScalar(benchmark::State &state) {
+  reduceElements<float>(state, [](float a, float b) { return a + b; });
+}
+BENCHMARK(meassureReduceElementsPlusFloatScalar)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+
+static void meassureReduceElementsPlusDouble(benchmark::State &state) {
+  reduceElements<double>(state, std::plus<double>());
+}
+BENCHMARK(meassureReduceElementsPlusDouble)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+
+static void meassureReduceElementsMaxDouble(benchmark::State &state) {
+  reduceElements<double>(state, utils::maximum<double>());
+}
+BENCHMARK(meassureReduceElementsMaxDouble)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+
+static void meassureReduceElementsMaxDoubleScalar(benchmark::State &state) {
+  reduceElements<double>(state, [](double a, double b) { return a < b ? b : a; });
+}
+BENCHMARK(meassureReduceElementsMaxDoubleScalar)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+
+static void meassureReduceElementsMinInt(benchmark::State &state) {
+  reduceElements<int>(state, utils::minimum<int>());
+}
+BENCHMARK(meassureReduceElementsMinInt)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
+
+static void meassureReduceElementsMultipliesUnsigned(benchmark::State &state) {
+  reduceElements<unsigned>(state, std::multiplies<unsigned>());
+}
+BENCHMARK(meassureReduceElementsMultipliesUnsigned)->RangeMultiplier(4)->Range(1 << 20, 64 << 20);
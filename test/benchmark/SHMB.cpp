@@ -0,0 +1,46 @@
+#include <graybat/communicationPolicy/SHM.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// run: mpiexec -n 2 benchmark --benchmark_filter=PingPong
+
+using SHM = graybat::communicationPolicy::SHM;
+using SHMConfig = SHM::Config;
+
+SHMConfig shmConfig = {
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_shm_benchmark"};
+SHM shmCP(shmConfig);
+
+////////////////////////////////////////////////////////////////////////////////
+// Ping-pong of state.range(0) bytes between the peers with vAddr 0 and 1,
+// all other peers idle. The time is a round trip, thus the one way
+// latency is half of it. The number of iterations is fixed, since both
+// peers need to run the same number of round trips.
+template <typename T_CP>
+void pingPong(benchmark::State &state, T_CP &cp) {
+  auto context = cp.getGlobalContext();
+  const unsigned vAddr = context.getVAddr();
+  std::vector<char> data(state.range(0));
+
+  while (state.KeepRunning()) {
+    if (vAddr == 0) {
+      cp.send(1, 0, context, data);
+      cp.recv(1, 0, context, data);
+    } else if (vAddr == 1) {
+      cp.recv(0, 0, context, data);
+      cp.send(0, 0, context, data);
+    }
+  }
+
+  state.SetBytesProcessed(2 * state.iterations() * data.size());
+}
+
+static void meassurePingPongSHM(benchmark::State &state) {
+  pingPong(state, shmCP);
+}
+BENCHMARK(meassurePingPongSHM)->Arg(8)->Arg(4096)->Arg(256 << 10)->Arg(4 << 20)->Iterations(1000)->UseRealTime();
@@ -0,0 +1,51 @@
+#include <graybat/communicationPolicy/Threads.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using Threads = graybat::communicationPolicy::Threads;
+
+const unsigned pingTag = 0;
+const unsigned stopTag = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+// Ping-pong of state.range(0) bytes between two peers of the Threads
+// policy. The time is a round trip, thus the one way latency is half of it.
+static void meassurePingPongThreads(benchmark::State &state) {
+  const size_t nBytes = state.range(0);
+
+  Threads::Config config;
+  config.network = std::make_shared<Threads::Network>(2);
+
+  Threads ping(config);
+  std::thread echo([&config, nBytes]() {
+    Threads pong(config);
+    auto context = pong.getGlobalContext();
+    std::vector<char> data(nBytes);
+    while (true) {
+      auto event = pong.recv(context, data);
+      if (event.getTag() == stopTag) {
+        break;
+      }
+      pong.send(event.source(), pingTag, context, data);
+    }
+  });
+
+  auto context = ping.getGlobalContext();
+  const unsigned pongVAddr = 1 - context.getVAddr();
+  std::vector<char> data(nBytes);
+
+  while (state.KeepRunning()) {
+    ping.send(pongVAddr, pingTag, context, data);
+    ping.recv(pongVAddr, pingTag, context, data);
+  }
+
+  ping.send(pongVAddr, stopTag, context, data);
+  echo.join();
+
+  state.SetItemsProcessed(2 * state.iterations());
+}
+BENCHMARK(meassurePingPongThreads)->Arg(8)->Arg(4096)->Arg(1 << 20)->UseRealTime();
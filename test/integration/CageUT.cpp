@@ -19,12 +19,20 @@
  */
 
 // STL
+#include <algorithm>  /* std::max */
 #include <array>
 #include <vector>
+#include <map>        /* std::map */
 #include <iostream>   /* std::cout, std::endl */
 #include <functional> /* std::plus, std::ref */
+#include <memory>     /* std::make_shared */
 #include <cstdlib>    /* std::getenv */
 #include <string>     /* std::string, std::stoi */
+#include <numeric>    /* std::iota */
+#include <atomic>     /* std::atomic */
+#include <chrono>     /* std::chrono::milliseconds */
+#include <thread>     /* std::thread, std::this_thread::sleep_for */
+#include <stdexcept>  /* std::runtime_error */
 
 // BOOST
 #include <boost/test/unit_test.hpp>
@@ -35,6 +43,9 @@
 #include <graybat/Cage.hpp>
 #include <graybat/communicationPolicy/BMPI.hpp>
 #include <graybat/communicationPolicy/ZMQ.hpp>
+#include <graybat/communicationPolicy/SHM.hpp>
+#include <graybat/communicationPolicy/Hybrid.hpp>
+#include <graybat/communicationPolicy/Threads.hpp>
 #include <graybat/graphPolicy/BGL.hpp>
 #include <graybat/mapping/Random.hpp>
 #include <graybat/mapping/Consecutive.hpp>
@@ -43,6 +54,14 @@
 #include <graybat/pattern/InStar.hpp>
 #include <graybat/pattern/Grid.hpp>
 
+/*******************************************************************************
+ * Allocation Counting
+ ******************************************************************************/
+// Counted by the operator new of CommunicationPolicyUT.cpp
+extern std::atomic<bool> countAllocations;
+extern std::atomic<size_t> countedAllocationSize;
+extern std::atomic<size_t> nCountedAllocations;
+
 /*******************************************************************************
  * Test Suites
  ******************************************************************************/
@@ -61,11 +80,20 @@ size_t const nRuns = 1;
 
 using ZMQ = graybat::communicationPolicy::ZMQ;
 using BMPI = graybat::communicationPolicy::BMPI;
+using SHM = graybat::communicationPolicy::SHM;
+using HybridBMPI = graybat::communicationPolicy::Hybrid<BMPI>;
+using Threads = graybat::communicationPolicy::Threads;
 using GP = graybat::graphPolicy::BGL<>;
 using ZMQCage = graybat::Cage<ZMQ, GP>;
 using BMPICage = graybat::Cage<BMPI, GP>;
+using SHMCage = graybat::Cage<SHM, GP>;
+using HybridBMPICage = graybat::Cage<HybridBMPI, GP>;
+using ThreadsCage = graybat::Cage<Threads, GP>;
 using ZMQConfig = ZMQ::Config;
 using BMPIConfig = BMPI::Config;
+using SHMConfig = SHM::Config;
+using HybridBMPIConfig = HybridBMPI::Config;
+using ThreadsConfig = Threads::Config;
 
 ZMQConfig zmqConfig = {
     "tcp://127.0.0.1:5000", "tcp://127.0.0.1:5001",
@@ -74,10 +102,27 @@ ZMQConfig zmqConfig = {
 
 BMPIConfig bmpiConfig;
 
+SHMConfig shmConfig = {
+    static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+    "context_cage_test"};
+
+// Peers alternate between two nodes
+HybridBMPIConfig hybridBMPIConfig = {
+    bmpiConfig, {0, "context_cage_hybrid_test"},
+    "node" + std::to_string(std::stoi(std::getenv("OMPI_COMM_WORLD_RANK")) % 2)};
+
+// Every process is a network of a single peer thread
+ThreadsConfig threadsConfig = {std::make_shared<Threads::Network>(1)};
+
 ZMQCage zmqCage(zmqConfig);
 BMPICage bmpiCage(bmpiConfig);
+SHMCage shmCage(shmConfig);
+HybridBMPICage hybridBMPICage(hybridBMPIConfig);
+ThreadsCage threadsCage(threadsConfig);
 
-auto cages = hana::make_tuple(std::ref(zmqCage), std::ref(bmpiCage));
+auto cages = hana::make_tuple(std::ref(zmqCage), std::ref(bmpiCage),
+                              std::ref(shmCage), std::ref(hybridBMPICage),
+                              std::ref(threadsCage));
 
 BOOST_AUTO_TEST_CASE(move_construct) {
   hana::for_each(cages, [](auto cageRef) {
@@ -90,6 +135,127 @@ BOOST_AUTO_TEST_CASE(move_construct) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(iterate_without_allocation) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+
+    // Test run
+    {
+      auto &cage = cageRef.get();
+
+      cage.setGraph(graybat::pattern::Grid<GP>(4, 4));
+      cage.distribute(graybat::mapping::Consecutive());
+
+      size_t nVertices = 0;
+      size_t nEdges = 0;
+      size_t idSum = 0;
+
+      nCountedAllocations = 0;
+      countedAllocationSize = 1;
+      countAllocations = true;
+
+      for (Vertex &v : cage.getVertices()) {
+        ++nVertices;
+        for (Edge e : cage.getOutEdges(v)) {
+          idSum += e.target.id;
+          ++nEdges;
+        }
+        for (Edge e : cage.getInEdges(v)) {
+          idSum += e.source.id;
+          ++nEdges;
+        }
+        for (Vertex a : cage.getAdjacentVertices(v)) {
+          idSum += a.id;
+        }
+        nEdges += v.nOutEdges() + v.nInEdges();
+      }
+
+      countAllocations = false;
+
+      BOOST_CHECK_EQUAL(nCountedAllocations, 0);
+      BOOST_CHECK_EQUAL(nVertices, 16);
+      // 48 edges, each visited as out and in edge and counted twice
+      BOOST_CHECK_EQUAL(nEdges, 4 * 48);
+      BOOST_CHECK_GT(idSum, 0);
+
+      // The ranges still convert to containers
+      std::vector<Vertex> vertices = cage.getVertices();
+      std::vector<Edge> outEdges = cage.getOutEdges(vertices.at(5));
+      BOOST_CHECK_EQUAL(vertices.size(), 16);
+      BOOST_CHECK_EQUAL(outEdges.size(), 4);
+      BOOST_CHECK_EQUAL(outEdges.at(0).source.id, 5);
+    }
+
+  });
+}
+
+BOOST_AUTO_TEST_CASE(is_hosting) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+
+    // Test run
+    {
+      auto &cage = cageRef.get();
+
+      cage.setGraph(graybat::pattern::Grid<GP>(3, 5));
+      cage.distribute(graybat::mapping::Roundrobin());
+
+      std::vector<unsigned> hosted(cage.getVertices().size(), 0);
+      for (Vertex &v : cage.getHostedVertices()) {
+        hosted.at(v.id) = 1;
+      }
+
+      for (Vertex &v : cage.getVertices()) {
+        BOOST_CHECK_EQUAL(cage.isHosting(v), hosted.at(v.id) == 1);
+      }
+    }
+
+  });
+}
+
+BOOST_AUTO_TEST_CASE(announce_smaller_graph) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+
+    // Test run
+    {
+      auto &cage = cageRef.get();
+      const unsigned nPeers = cage.getPeers().size();
+
+      // The last peer hosts no vertex of the second graph, so it
+      // takes part in no announce of it
+      cage.setGraph(graybat::pattern::Grid<GP>(nPeers + 1, nPeers + 1));
+      cage.distribute(graybat::mapping::Roundrobin());
+      cage.setGraph(graybat::pattern::InStar<GP>(std::max(nPeers - 1, 1u)));
+      cage.distribute(graybat::mapping::Consecutive());
+
+      if (cage.getHostedVertices().empty()) {
+        for (unsigned vAddr = 0; vAddr < nPeers; ++vAddr) {
+          BOOST_CHECK(cage.getVerticesHostedBy(vAddr).empty());
+        }
+        for (Vertex &v : cage.getVertices()) {
+          BOOST_CHECK_THROW(cage.locateVertex(v), std::runtime_error);
+        }
+      } else {
+        for (Vertex &v : cage.getVertices()) {
+          BOOST_CHECK_NO_THROW(cage.locateVertex(v));
+        }
+      }
+    }
+
+  });
+}
+
 BOOST_AUTO_TEST_CASE(send_recv) {
   hana::for_each(cages, [](auto cageRef) {
     // Test setup
@@ -143,6 +309,149 @@ BOOST_AUTO_TEST_CASE(send_recv) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(send_recv_view) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Event = typename Cage::Event;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+
+    // Test run
+    {
+      const unsigned nElements = 1000;
+
+      auto &cage = cageRef.get();
+      cage.setGraph(
+          graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+      cage.distribute(graybat::mapping::Roundrobin());
+
+      for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+        std::vector<Event> events;
+        std::vector<unsigned> send(nElements, 0);
+
+        for (unsigned i = 0; i < send.size(); ++i) {
+          send.at(i) = i;
+        }
+
+        // Send state to neighbor cells
+        for (Vertex &v : cage.getHostedVertices()) {
+          for (Edge edge : cage.getOutEdges(v)) {
+            cage.send(edge, send, events);
+          }
+        }
+
+        // Recv state from neighbor cells in place
+        for (Vertex &v : cage.getHostedVertices()) {
+          for (Edge edge : cage.getInEdges(v)) {
+            auto recv = cage.template recv<unsigned>(edge);
+            BOOST_CHECK_EQUAL(recv.size(), nElements);
+            for (unsigned i = 0; i < recv.size(); ++i) {
+              BOOST_CHECK_EQUAL(recv[i], i);
+            }
+          }
+        }
+
+        for (Event &e : events) {
+          e.wait();
+        }
+      }
+    }
+
+  });
+}
+
+BOOST_AUTO_TEST_CASE(send_recv_local) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Event = typename Cage::Event;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+
+    // Test run
+    {
+      const unsigned nElements = 100;
+
+      auto &cage = cageRef.get();
+      cage.setGraph(graybat::pattern::Grid<GP>(4, 4));
+      cage.distribute(graybat::mapping::Consecutive());
+
+      // Edges between vertices of this peer use the mailbox of the cage
+      std::size_t nLocalEdges = 0;
+      for (Vertex &v : cage.getHostedVertices()) {
+        for (Edge edge : cage.getInEdges(v)) {
+          nLocalEdges += cage.isHosting(edge.source) ? 1 : 0;
+        }
+      }
+
+      for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+        std::vector<Event> events;
+        std::vector<unsigned> send(nElements, 0);
+        std::vector<unsigned> recv(nElements, 0);
+        std::vector<std::vector<unsigned>> early(nLocalEdges, std::vector<unsigned>(nElements, 0));
+
+        // Receives posted before the message was sent
+        unsigned early_i = 0;
+        for (Vertex &v : cage.getHostedVertices()) {
+          for (Edge edge : cage.getInEdges(v)) {
+            if (cage.isHosting(edge.source)) {
+              cage.recv(edge, early.at(early_i++), events);
+            }
+          }
+        }
+
+        // Three messages on each edge, received in send order
+        for (unsigned message_i = 0; message_i < 3; ++message_i) {
+          std::iota(send.begin(), send.end(), run_i + message_i);
+          for (Vertex &v : cage.getHostedVertices()) {
+            for (Edge edge : cage.getOutEdges(v)) {
+              if (cage.isHosting(edge.target)) {
+                cage.send(edge, send, events);
+              }
+            }
+          }
+        }
+
+        for (Event &e : events) {
+          e.wait();
+        }
+
+        for (std::vector<unsigned> &e : early) {
+          for (unsigned i = 0; i < e.size(); ++i) {
+            BOOST_CHECK_EQUAL(e.at(i), run_i + i);
+          }
+        }
+
+        for (Vertex &v : cage.getHostedVertices()) {
+          for (Edge edge : cage.getInEdges(v)) {
+            if (cage.isHosting(edge.source)) {
+              auto view = cage.template recv<unsigned>(edge);
+              BOOST_REQUIRE_EQUAL(view.size(), nElements);
+              for (unsigned i = 0; i < view.size(); ++i) {
+                BOOST_CHECK_EQUAL(view[i], run_i + 1 + i);
+              }
+            }
+          }
+        }
+
+        // Receive from any edge finds the local messages first
+        for (std::size_t edge_i = 0; edge_i < nLocalEdges; ++edge_i) {
+          Edge edge = cage.recv(recv);
+          BOOST_CHECK(cage.isHosting(edge.source));
+          BOOST_CHECK(cage.isHosting(edge.target));
+          for (unsigned i = 0; i < recv.size(); ++i) {
+            BOOST_CHECK_EQUAL(recv.at(i), run_i + 2 + i);
+          }
+        }
+      }
+    }
+
+  });
+}
+
 BOOST_AUTO_TEST_CASE(asyncSend_recv) {
   hana::for_each(cages, [](auto cageRef) {
     // Test setup
@@ -200,6 +509,154 @@ BOOST_AUTO_TEST_CASE(asyncSend_recv) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(send_recv_channel) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+    using SendChannel = typename Cage::template SendChannel<std::vector<unsigned>>;
+    using RecvChannel = typename Cage::template RecvChannel<std::vector<unsigned>>;
+
+    // Test run
+    {
+
+      auto &cage = cageRef.get();
+
+      cage.setGraph(
+          graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+      cage.distribute(graybat::mapping::Consecutive());
+
+      const unsigned nElements = 1000;
+
+      // One buffer per edge, bound once to its channel
+      std::size_t nOutEdges = 0;
+      std::size_t nInEdges = 0;
+      for (Vertex &v : cage.getHostedVertices()) {
+        nOutEdges += cage.getOutEdges(v).size();
+        nInEdges += cage.getInEdges(v).size();
+      }
+
+      std::vector<std::vector<unsigned>> sends(nOutEdges, std::vector<unsigned>(nElements, 0));
+      std::vector<std::vector<unsigned>> recvs(nInEdges, std::vector<unsigned>(nElements, 0));
+      std::vector<SendChannel> sendChannels;
+      std::vector<RecvChannel> recvChannels;
+
+      unsigned send_i = 0;
+      unsigned recv_i = 0;
+      for (Vertex &v : cage.getHostedVertices()) {
+        for (Edge edge : cage.getOutEdges(v)) {
+          sendChannels.push_back(cage.bindSend(edge, sends.at(send_i++)));
+        }
+        for (Edge edge : cage.getInEdges(v)) {
+          recvChannels.push_back(cage.bindRecv(edge, recvs.at(recv_i++)));
+        }
+      }
+
+      for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+        for (std::vector<unsigned> &send : sends) {
+          std::iota(send.begin(), send.end(), run_i);
+        }
+
+        for (RecvChannel &channel : recvChannels) {
+          channel.start();
+        }
+        for (SendChannel &channel : sendChannels) {
+          channel.start();
+        }
+        for (RecvChannel &channel : recvChannels) {
+          channel.wait();
+        }
+        for (SendChannel &channel : sendChannels) {
+          channel.wait();
+        }
+
+        for (std::vector<unsigned> &recv : recvs) {
+          for (unsigned i = 0; i < recv.size(); ++i) {
+            BOOST_CHECK_EQUAL(recv.at(i), run_i + i);
+          }
+        }
+      }
+    }
+
+  });
+}
+
+BOOST_AUTO_TEST_CASE(send_recv_local_channel) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+    using RecvChannel = typename Cage::template RecvChannel<std::vector<unsigned>>;
+
+    // Test run
+    {
+      const unsigned nElements = 100;
+
+      auto &cage = cageRef.get();
+      cage.setGraph(graybat::pattern::Grid<GP>(4, 4));
+      cage.distribute(graybat::mapping::Consecutive());
+
+      std::vector<Edge> localEdges;
+      for (Vertex &v : cage.getHostedVertices()) {
+        for (Edge edge : cage.getInEdges(v)) {
+          if (cage.isHosting(edge.source)) {
+            localEdges.push_back(edge);
+          }
+        }
+      }
+
+      std::vector<std::vector<unsigned>> recvs(localEdges.size(), std::vector<unsigned>(nElements, 0));
+      std::vector<RecvChannel> channels;
+      for (std::size_t edge_i = 0; edge_i < localEdges.size(); ++edge_i) {
+        channels.push_back(cage.bindRecv(localEdges.at(edge_i), recvs.at(edge_i)));
+      }
+
+      for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+        std::vector<unsigned> send(nElements);
+        std::iota(send.begin(), send.end(), run_i);
+
+        // Channels on local edges are paired with send
+        for (RecvChannel &channel : channels) {
+          channel.start();
+        }
+        for (Edge &edge : localEdges) {
+          cage.send(edge, send);
+        }
+        for (RecvChannel &channel : channels) {
+          channel.wait();
+        }
+
+        for (std::vector<unsigned> &recv : recvs) {
+          for (unsigned i = 0; i < recv.size(); ++i) {
+            BOOST_CHECK_EQUAL(recv.at(i), run_i + i);
+          }
+        }
+
+        // A blocking recv waits for a send of another thread
+        std::thread sender([&cage, &localEdges, &send] {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          for (Edge &edge : localEdges) {
+            cage.send(edge, send);
+          }
+        });
+        std::vector<unsigned> recv(nElements, 0);
+        for (Edge &edge : localEdges) {
+          cage.recv(edge, recv);
+          for (unsigned i = 0; i < recv.size(); ++i) {
+            BOOST_CHECK_EQUAL(recv.at(i), run_i + i);
+          }
+        }
+        sender.join();
+      }
+    }
+
+  });
+}
+
 BOOST_AUTO_TEST_CASE(asyncSend_asyncRecv) {
   hana::for_each(cages, [](auto cageRef) {
     // Test setup
@@ -386,6 +843,91 @@ BOOST_AUTO_TEST_CASE(gather) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(collectives_on_fewer_peers) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+
+    // Test run
+    {
+      auto &cage = cageRef.get();
+      const unsigned nPeers = cage.getPeers().size();
+
+      const unsigned nElements = 10;
+      const unsigned testValue = 1;
+      const bool reorder = true;
+
+      std::vector<unsigned> send(nElements, testValue);
+
+      // Every peer hosts a vertex of the first graph. The vertices of
+      // the second one are hosted by all peers but one, first without
+      // the last peer and then without the first one
+      for (unsigned skippedPeer : {nPeers - 1, 0u}) {
+        cage.setGraph(graybat::pattern::FullyConnected<GP>(nPeers));
+        cage.distribute(graybat::mapping::Consecutive());
+        cage.setGraph(graybat::pattern::InStar<GP>(std::max(nPeers - 1, 1u)));
+        cage.distribute([nPeers, skippedPeer](unsigned const peer, unsigned, auto &cage) {
+          std::vector<Vertex> vertices = cage.getVertices();
+          std::vector<Vertex> hosted;
+          if (nPeers == 1 || peer != skippedPeer) {
+            hosted.push_back(vertices.at(peer > skippedPeer ? peer - 1 : peer));
+          }
+          return hosted;
+        });
+
+        // The root moves from peer to peer, and every round receives
+        // into new buffers
+        for (Vertex rootVertex : cage.getVertices()) {
+          std::vector<unsigned> reduced(nElements, 0);
+          std::vector<unsigned> allReduced(nElements, 0);
+          std::vector<unsigned> gathered(nElements * cage.getVertices().size(), 0);
+          std::vector<unsigned> allGathered(nElements * cage.getVertices().size(), 0);
+
+          if (cage.getHostedVertices().empty()) {
+            BOOST_CHECK(!cage.isHosting(rootVertex));
+          }
+
+          for (Vertex v : cage.getHostedVertices()) {
+            cage.reduce(rootVertex, v, std::plus<unsigned>(), send, reduced);
+          }
+
+          for (Vertex v : cage.getHostedVertices()) {
+            cage.gather(rootVertex, v, send, gathered, reorder);
+          }
+
+          for (Vertex v : cage.getHostedVertices()) {
+            cage.allReduce(v, std::plus<unsigned>(), send, allReduced);
+          }
+
+          for (Vertex v : cage.getHostedVertices()) {
+            cage.allGather(v, send, allGathered, reorder);
+          }
+
+          if (!cage.getHostedVertices().empty()) {
+            for (unsigned receivedElement : allReduced) {
+              BOOST_CHECK_EQUAL(receivedElement, cage.getVertices().size());
+            }
+            for (unsigned receivedElement : allGathered) {
+              BOOST_CHECK_EQUAL(receivedElement, testValue);
+            }
+          }
+
+          if (cage.isHosting(rootVertex)) {
+            for (unsigned receivedElement : reduced) {
+              BOOST_CHECK_EQUAL(receivedElement, cage.getVertices().size());
+            }
+            for (unsigned receivedElement : gathered) {
+              BOOST_CHECK_EQUAL(receivedElement, testValue);
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
 
 BOOST_AUTO_TEST_CASE(allGather) {
   hana::for_each(cages, [](auto cageRef) {
@@ -421,6 +963,45 @@ BOOST_AUTO_TEST_CASE(allGather) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(allToAll) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+
+    // Test run
+    {
+
+      auto &cage = cageRef.get();
+
+      cage.setGraph(graybat::pattern::Grid<GP>(cage.getPeers().size(),
+                                               cage.getPeers().size()));
+      cage.distribute(graybat::mapping::Roundrobin());
+
+      const unsigned nElements = 10;
+      const unsigned nVertices = cage.getVertices().size();
+
+      // Block of dest holds src * nVertices + dest
+      std::map<unsigned, std::vector<unsigned>> recvs;
+      for (Vertex v : cage.getHostedVertices()) {
+        std::vector<unsigned> send(nElements * nVertices);
+        for (unsigned i = 0; i < send.size(); ++i) {
+          send[i] = v.id * nVertices + i / nElements;
+        }
+        recvs[v.id].resize(nElements * nVertices, 0);
+        cage.allToAll(v, send, recvs[v.id]);
+      }
+
+      for (Vertex v : cage.getHostedVertices()) {
+        for (unsigned i = 0; i < nElements * nVertices; ++i) {
+          BOOST_CHECK_EQUAL(recvs[v.id][i], i / nElements * nVertices + v.id);
+        }
+      }
+    }
+  });
+}
+
 BOOST_AUTO_TEST_CASE(spreadAndCollect) {
   hana::for_each(cages, [](auto cageRef) {
     // Test setup
@@ -463,4 +1044,93 @@ BOOST_AUTO_TEST_CASE(spreadAndCollect) {
   });
 }
 
+BOOST_AUTO_TEST_CASE(exchange) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+
+    // Test run
+    {
+      auto &cage = cageRef.get();
+
+      cage.setGraph(graybat::pattern::Grid<GP>(4, 5));
+      cage.distribute(graybat::mapping::Roundrobin());
+
+      const unsigned nElements = 10;
+
+      std::size_t nInEdges = 0;
+      for (Vertex &v : cage.getHostedVertices()) {
+        nInEdges += v.nInEdges();
+      }
+
+      // Each vertex sends its id and the run, the buffers stay the same
+      std::vector<std::vector<unsigned>> data(cage.getVertices().size(), std::vector<unsigned>(nElements, 0));
+
+      for (unsigned run_i = 0; run_i < 3; ++run_i) {
+        for (Vertex &v : cage.getHostedVertices()) {
+          std::iota(data.at(v.id).begin(), data.at(v.id).end(), v.id + run_i);
+        }
+
+        std::vector<unsigned> nReceived(cage.getVertices().size(), 0);
+        std::size_t nCalls = 0;
+
+        cage.exchange(
+            [&data](Vertex const &v) -> std::vector<unsigned> const & {
+              return data.at(v.id);
+            },
+            [&](Edge const &edge, unsigned const *first, unsigned const *last) {
+              BOOST_CHECK(cage.isHosting(edge.target));
+              BOOST_REQUIRE_EQUAL(last - first, nElements);
+              for (unsigned i = 0; i < nElements; ++i) {
+                BOOST_CHECK_EQUAL(first[i], edge.source.id + run_i + i);
+              }
+              ++nReceived.at(edge.target.id);
+              ++nCalls;
+            });
+
+        BOOST_CHECK_EQUAL(nCalls, nInEdges);
+        for (Vertex &v : cage.getHostedVertices()) {
+          BOOST_CHECK_EQUAL(nReceived.at(v.id), v.nInEdges());
+        }
+      }
+    }
+  });
+}
+
+BOOST_AUTO_TEST_CASE(exchange_size_mismatch) {
+  hana::for_each(cages, [](auto cageRef) {
+    // Test setup
+    using Cage = typename decltype(cageRef)::type;
+    using GP = typename Cage::GraphPolicy;
+    using Vertex = typename Cage::Vertex;
+    using Edge = typename Cage::Edge;
+
+    // Test run
+    {
+      auto &cage = cageRef.get();
+
+      // Every peer hosts two vertices, thus every peer throws
+      cage.setGraph(graybat::pattern::Grid<GP>(cage.getPeers().size(), 2));
+      cage.distribute(graybat::mapping::Consecutive());
+
+      const unsigned nElements = 10;
+
+      std::vector<std::vector<unsigned>> data;
+      for (Vertex &v : cage.getVertices()) {
+        data.push_back(std::vector<unsigned>(nElements + v.id, 0));
+      }
+
+      BOOST_CHECK_THROW(cage.exchange(
+                            [&data](Vertex const &v) -> std::vector<unsigned> const & {
+                              return data.at(v.id);
+                            },
+                            [](Edge const &, unsigned const *, unsigned const *) {}),
+                        std::runtime_error);
+    }
+  });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
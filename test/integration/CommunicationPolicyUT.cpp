@@ -23,12 +23,29 @@
 #include <boost/hana/tuple.hpp>
 
 // STL
+#include <algorithm>  /* std::max */
+#include <atomic>     /* std::atomic */
+#include <cstdint>    /* std::uint64_t, std::uintptr_t */
+#include <cstdlib>    /* std::malloc, std::free */
+#include <cstring>    /* std::memcpy */
+#include <functional> /* std::function, std::plus */
 #include <iostream>   /* std::cout, std::endl */
+#include <memory>     /* std::make_shared */
+#include <new>        /* std::bad_alloc, std::nothrow_t */
+#include <numeric>    /* std::iota */
+#include <string>     /* std::string */
+#include <thread>     /* std::thread */
+#include <utility>    /* std::pair */
 
 // GRAYBAT
 #include <graybat/Cage.hpp>
+#include <graybat/communicationPolicy/RecvView.hpp>
 #include <graybat/communicationPolicy/ZMQ.hpp>
 #include <graybat/communicationPolicy/BMPI.hpp>
+#include <graybat/communicationPolicy/SHM.hpp>
+#include <graybat/communicationPolicy/Hybrid.hpp>
+#include <graybat/communicationPolicy/Threads.hpp>
+#include <graybat/utils/reduceElements.hpp> /* utils::minimum, utils::maximum */
 
 /*******************************************************************************
  * Communication Policies to Test
@@ -39,21 +56,140 @@ size_t const nRuns = 1;
 
 using ZMQ        = graybat::communicationPolicy::ZMQ;
 using BMPI       = graybat::communicationPolicy::BMPI;
+using SHM        = graybat::communicationPolicy::SHM;
+using HybridBMPI = graybat::communicationPolicy::Hybrid<BMPI>;
+using Threads    = graybat::communicationPolicy::Threads;
 using ZMQConfig  = ZMQ::Config;
 using BMPIConfig = BMPI::Config;
+using SHMConfig  = SHM::Config;
+using HybridBMPIConfig = HybridBMPI::Config;
+using ThreadsConfig    = Threads::Config;
 
 ZMQConfig zmqConfig = {"tcp://127.0.0.1:5000",
                        "tcp://127.0.0.1:5001",
                        static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
                        "context_cp_test"};
 
+// Sends complete only after the receiver confirmed them
+ZMQConfig zmqConfirmConfig = {"tcp://127.0.0.1:5000",
+                              "tcp://127.0.0.1:5001",
+                              static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+                              "context_cp_confirm_test",
+                              100 * 1000 * 1000,
+                              true,
+                              4};
+
+// Sends reference the user buffer until ZMQ released it
+ZMQConfig zmqZeroCopyConfig = {"tcp://127.0.0.1:5000",
+                               "tcp://127.0.0.1:5001",
+                               static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+                               "context_cp_zero_copy_test",
+                               100 * 1000 * 1000,
+                               false,
+                               1,
+                               true};
+
+// Send queues are drained by two I/O threads
+ZMQConfig zmqSendThreadsConfig = {"tcp://127.0.0.1:5000",
+                                  "tcp://127.0.0.1:5001",
+                                  static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+                                  "context_cp_send_threads_test",
+                                  100 * 1000 * 1000,
+                                  false,
+                                  1,
+                                  false,
+                                  2};
+
+// Small messages are packed into batches of up to 4 KiB
+ZMQConfig zmqCoalesceConfig = {"tcp://127.0.0.1:5000",
+                               "tcp://127.0.0.1:5001",
+                               static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+                               "context_cp_coalesce_test",
+                               100 * 1000 * 1000,
+                               false,
+                               1,
+                               false,
+                               1,
+                               4096};
+
 BMPIConfig bmpiConfig;
 
+SHMConfig shmConfig = {static_cast<size_t>(std::stoi(std::getenv("OMPI_COMM_WORLD_SIZE"))),
+                       "context_cp_test"};
+
+// Peers alternate between two nodes, thus both shared memory and
+// MPI carry messages
+HybridBMPIConfig hybridBMPIConfig = {bmpiConfig,
+                                     {0, "context_cp_hybrid_test"},
+                                     "node" + std::to_string(std::stoi(std::getenv("OMPI_COMM_WORLD_RANK")) % 2)};
+
+// Every process is a network of a single peer thread, several peer
+// threads are tested by ThreadsUT.cpp
+ThreadsConfig threadsConfig = {std::make_shared<Threads::Network>(1)};
+
 ZMQ zmqCP(zmqConfig);
+ZMQ zmqConfirmCP(zmqConfirmConfig);
+ZMQ zmqZeroCopyCP(zmqZeroCopyConfig);
+ZMQ zmqSendThreadsCP(zmqSendThreadsConfig);
+ZMQ zmqCoalesceCP(zmqCoalesceConfig);
 BMPI bmpiCP(bmpiConfig);
+SHM shmCP(shmConfig);
+HybridBMPI hybridBMPICP(hybridBMPIConfig);
+Threads threadsCP(threadsConfig);
 
 auto communicationPolicies = hana::make_tuple(std::ref(zmqCP),
-                                              std::ref(bmpiCP) );
+                                              std::ref(zmqConfirmCP),
+                                              std::ref(zmqZeroCopyCP),
+                                              std::ref(zmqSendThreadsCP),
+                                              std::ref(zmqCoalesceCP),
+                                              std::ref(bmpiCP),
+                                              std::ref(shmCP),
+                                              std::ref(hybridBMPICP),
+                                              std::ref(threadsCP) );
+
+// Policies that can be used by several threads at once
+auto threadSafeCommunicationPolicies = hana::make_tuple(std::ref(zmqCP),
+                                                        std::ref(zmqConfirmCP),
+                                                        std::ref(zmqSendThreadsCP),
+                                                        std::ref(zmqCoalesceCP) );
+
+
+/*******************************************************************************
+ * Allocation Counting
+ ******************************************************************************/
+// Allocations from this size on are counted, while a test set the flag
+std::atomic<bool>   countAllocations{false};
+std::atomic<size_t> countedAllocationSize{0};
+std::atomic<size_t> nCountedAllocations{0};
+
+void* operator new(size_t size){
+    if(countAllocations && size >= countedAllocationSize){
+        ++nCountedAllocations;
+    }
+    void *ptr = std::malloc(size ? size : 1);
+    if(!ptr){
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+// Replaced as well, otherwise ASan reports the nothrow allocations of
+// libzmq as mismatched with the free below
+void* operator new(size_t size, std::nothrow_t const &) noexcept {
+    if(countAllocations && size >= countedAllocationSize){
+        ++nCountedAllocations;
+    }
+    return std::malloc(size ? size : 1);
+}
+
+// Not inlined, otherwise gcc mistakes the free for a mismatched delete
+[[gnu::noinline]] void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
 
 
 /*******************************************************************************
@@ -115,9 +251,11 @@ BOOST_AUTO_TEST_CASE( async_send_recv){
                 std::vector<unsigned> recv(nElements, 0);
                 std::vector<Event> events;
 
+                // Send buffers live until their events are finished
+                std::vector<unsigned> data(nElements, 0);
+                std::iota(data.begin(), data.end(), context.getVAddr());
+
                 for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
-                  std::vector<unsigned> data(nElements, 0);
-                  std::iota(data.begin(), data.end(), context.getVAddr());
                   events.push_back(cp.asyncSend(vAddr, tag, context, data));
                 }
 
@@ -160,9 +298,11 @@ BOOST_AUTO_TEST_CASE( async_send_recv){
                     std::vector<unsigned> recv (nElements, 0);
                     std::vector<Event> events;
 
+                    // Send buffers live until their events are finished
+                    std::vector<unsigned> data (nElements, 1);
+                    std::iota(data.begin(), data.end(), context.getVAddr());
+
                     for(unsigned vAddr = 0; vAddr < context.size(); ++vAddr){
-                        std::vector<unsigned> data (nElements, 1);
-                        std::iota(data.begin(), data.end(), context.getVAddr());
                         events.push_back(cp.asyncSend(vAddr, tag, context, data));
                     }
 
@@ -199,7 +339,9 @@ BOOST_AUTO_TEST_CASE( async_send_recv){
             // Test run
             {
 
-              Context context = cp.getGlobalContext();
+              // A receive from any peer takes any message of its context,
+              // thus other cases must not send into it
+              Context context = cp.splitContext(true, cp.getGlobalContext());
 
               const unsigned nElements = 10;
 
@@ -207,9 +349,11 @@ BOOST_AUTO_TEST_CASE( async_send_recv){
                 std::vector<unsigned> recv(nElements, 0);
                 std::vector<Event> events;
 
+                // Send buffers live until their events are finished
+                std::vector<unsigned> data(nElements, 0);
+                std::iota(data.begin(), data.end(), context.getVAddr());
+
                 for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
-                  std::vector<unsigned> data(nElements, 0);
-                  std::iota(data.begin(), data.end(), context.getVAddr());
                   events.push_back(cp.asyncSend(vAddr, 99, context, data));
                 }
 
@@ -234,6 +378,134 @@ BOOST_AUTO_TEST_CASE( async_send_recv){
 }
 
 
+BOOST_AUTO_TEST_CASE( send_recv_view ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            using Event = typename CP::Event;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              const unsigned nElements = 10;
+              const unsigned tag = 99;
+
+              Context context = cp.getGlobalContext();
+
+              for (unsigned i = 0; i < nRuns; ++i) {
+                std::vector<Event> events;
+
+                // Every peer sends a different number of elements
+                std::vector<unsigned> data(nElements + context.getVAddr(), 0);
+                std::iota(data.begin(), data.end(), context.getVAddr());
+
+                for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+                  events.push_back(cp.asyncSend(vAddr, tag, context, data));
+                }
+
+                for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+                  auto recv = cp.template recv<unsigned>(vAddr, tag, context);
+
+                  BOOST_CHECK_EQUAL(recv.size(), nElements + vAddr);
+                  for (unsigned i = 0; i < recv.size(); ++i) {
+                    BOOST_CHECK_EQUAL(recv[i], vAddr + i);
+                  }
+                }
+
+                for (Event &e : events) {
+                  e.wait();
+                }
+              }
+
+            }
+
+	});
+
+}
+
+/**
+ * @brief Storage of a payload at an odd address, like a frame of a
+ *        transport, that does not align its messages.
+ */
+struct MisalignedStorage {
+    MisalignedStorage(std::vector<std::uint64_t> const &values) :
+        bytes(values.size() * sizeof(std::uint64_t) + 1){
+        std::memcpy(bytes.data() + 1, values.data(), values.size() * sizeof(std::uint64_t));
+    }
+
+    std::int8_t const * getData() const {
+        return bytes.data() + 1;
+    }
+
+    std::size_t getDataSize() const {
+        return bytes.size() - 1;
+    }
+
+    std::vector<std::int8_t> bytes;
+};
+
+BOOST_AUTO_TEST_CASE( recv_view_misaligned ){
+    std::vector<std::uint64_t> values(17);
+    std::iota(values.begin(), values.end(), 0x0102030405060708ULL);
+
+    graybat::communicationPolicy::RecvView<std::uint64_t, MisalignedStorage> view{MisalignedStorage(values)};
+
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(view.data()) % alignof(std::uint64_t), 0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(view.begin(), view.end(), values.begin(), values.end());
+
+    auto moved = std::move(view);
+    BOOST_CHECK_EQUAL_COLLECTIONS(moved.begin(), moved.end(), values.begin(), values.end());
+
+}
+
+
+BOOST_AUTO_TEST_CASE( send_recv_channel ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              const unsigned nElements = 10;
+              const unsigned tag = 99;
+
+              Context context = cp.getGlobalContext();
+              const unsigned nPeers = context.size();
+              const unsigned right = (context.getVAddr() + 1) % nPeers;
+              const unsigned left = (context.getVAddr() + nPeers - 1) % nPeers;
+
+              std::vector<unsigned> send(nElements, 0);
+              std::vector<unsigned> recv(nElements, 0);
+
+              // Bind once, transmit every run
+              auto sendChannel = cp.bindSend(right, tag, context, send);
+              auto recvChannel = cp.bindRecv(left, tag, context, recv);
+
+              for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+                std::iota(send.begin(), send.end(), context.getVAddr() + run_i);
+
+                recvChannel.start();
+                sendChannel.start();
+                recvChannel.wait();
+                sendChannel.wait();
+
+                for (unsigned i = 0; i < recv.size(); ++i) {
+                  BOOST_CHECK_EQUAL(recv[i], left + run_i + i);
+                }
+              }
+
+            }
+
+	});
+
+}
+
+
 BOOST_AUTO_TEST_CASE( send_recv_order ){
     hana::for_each(communicationPolicies, [](auto cpRef){
 	    // Test setup
@@ -297,6 +569,105 @@ BOOST_AUTO_TEST_CASE( send_recv_order ){
 }
 
 
+BOOST_AUTO_TEST_CASE( send_recv_threads ){
+    hana::for_each(threadSafeCommunicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              Context context = cp.getGlobalContext();
+
+              const unsigned nElements = 10;
+              const unsigned nMsgs = 10;
+              const unsigned tag = 99;
+
+              for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+
+                // Every peer is sent to by its own thread
+                std::vector<std::thread> senders;
+                for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+                  senders.emplace_back([&cp, context, vAddr]() {
+                    for (unsigned msg_i = 0; msg_i < nMsgs; ++msg_i) {
+                      std::vector<unsigned> data(nElements, context.getVAddr() + msg_i);
+                      cp.send(vAddr, tag, context, data);
+                    }
+                  });
+                }
+
+                for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+                  std::vector<unsigned> recv(nElements, 0);
+                  for (unsigned msg_i = 0; msg_i < nMsgs; ++msg_i) {
+                    cp.recv(vAddr, tag, context, recv);
+                    for (unsigned i = 0; i < recv.size(); ++i) {
+                      BOOST_CHECK_EQUAL(recv[i], vAddr + msg_i);
+                    }
+                  }
+                }
+
+                for (std::thread &sender : senders) {
+                  sender.join();
+                }
+              }
+            }
+
+	});
+
+}
+
+// Batches of small messages are sent on flush and after the coalescing
+// delay, large messages pass the batch of their link without reordering
+BOOST_AUTO_TEST_CASE( send_recv_coalesced ){
+    using Context = ZMQ::Context;
+    using Event   = ZMQ::Event;
+    ZMQ &cp = zmqCoalesceCP;
+
+    Context context = cp.getGlobalContext();
+
+    const unsigned nMsgs = 1000;
+    const unsigned nLargeElements = 2048;
+    const unsigned tag = 99;
+
+    auto const nElements = [](unsigned const msg_i) {
+      return msg_i % 100 == 99 ? nLargeElements : 1 + msg_i % 8;
+    };
+
+    for (bool const flush : {true, false}) {
+
+      std::vector<Event> events;
+
+      for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+        for (unsigned msg_i = 0; msg_i < nMsgs; ++msg_i) {
+          std::vector<unsigned> data(nElements(msg_i), context.getVAddr() * nMsgs + msg_i);
+          events.push_back(cp.asyncSend(vAddr, tag, context, data));
+        }
+      }
+
+      if (flush) {
+        cp.flush();
+      }
+
+      for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+        for (unsigned msg_i = 0; msg_i < nMsgs; ++msg_i) {
+          std::vector<unsigned> recv(nElements(msg_i), 0);
+          cp.recv(vAddr, tag, context, recv);
+          for (unsigned i = 0; i < recv.size(); ++i) {
+            BOOST_CHECK_EQUAL(recv[i], vAddr * nMsgs + msg_i);
+          }
+        }
+      }
+
+      for (Event &e : events) {
+        e.wait();
+      }
+    }
+
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -581,6 +952,215 @@ BOOST_AUTO_TEST_CASE( reduce ){
 
 }
 
+BOOST_AUTO_TEST_CASE( all_reduce ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+    
+                Context context = cp.getGlobalContext();
+
+                unsigned vAddrSum = 0;
+                for(auto const &vAddr : context){
+                    vAddrSum += vAddr;
+                }
+
+                // Small and large payloads take different algorithms
+                for(const unsigned nElements : {10u, 100u * 1000u}){
+    
+                    std::vector<unsigned> send (nElements, 0);
+                    std::iota(send.begin(), send.end(), context.getVAddr());
+                    std::vector<unsigned> recv (nElements, 0);
+                    
+                    cp.allReduce(context, std::plus<unsigned>(), send, recv);
+
+                    for(unsigned i = 0; i < nElements; ++i){
+                        BOOST_CHECK_EQUAL(recv[i], vAddrSum + i * context.size());
+                    }
+
+                }
+		
+            }
+	    
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( all_reduce_min_max ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+    
+                Context context = cp.getGlobalContext();
+
+                // Not a multiple of the vector width, the tail is reduced
+                // element by element
+                const unsigned nElements = 1001;
+
+                std::vector<double> send (nElements, 0);
+                for(unsigned i = 0; i < nElements; ++i){
+                    send[i] = static_cast<double>((context.getVAddr() + i) % context.size()) - 0.5;
+                }
+                std::vector<double> min (nElements, static_cast<double>(context.size()));
+                std::vector<double> max (nElements, -1.0);
+
+                cp.allReduce(context, utils::minimum<double>(), send, min);
+                cp.allReduce(context, utils::maximum<double>(), send, max);
+
+                for(unsigned i = 0; i < nElements; ++i){
+                    BOOST_CHECK_EQUAL(min[i], -0.5);
+                    BOOST_CHECK_EQUAL(max[i], static_cast<double>(context.size() - 1) - 0.5);
+                }
+		
+            }
+	    
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( collectives_without_allocation ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+                Context context = cp.getGlobalContext();
+
+                // Large enough for the ring and pipelined algorithms
+                const unsigned nElements = 1 << 20;
+                const unsigned rootVAddr = context.size() - 1;
+
+                std::vector<unsigned> send (nElements, 1);
+                std::vector<unsigned> recv (nElements, 0);
+                std::vector<unsigned> all  (nElements * context.size(), 0);
+                std::vector<unsigned> recvCount;
+
+                std::vector<std::pair<std::string, std::function<void()> > > const collectives {
+                    {"gather",       [&](){ cp.gather(rootVAddr, context, send, all); }},
+                    {"gatherVar",    [&](){ cp.gatherVar(rootVAddr, context, send, all, recvCount); }},
+                    {"allGather",    [&](){ cp.allGather(context, send, all); }},
+                    {"allGatherVar", [&](){ cp.allGatherVar(context, send, all, recvCount); }},
+                    {"scatter",      [&](){ cp.scatter(rootVAddr, context, all, recv); }},
+                    {"reduce",       [&](){ cp.reduce(rootVAddr, context, std::plus<unsigned>(), send, recv); }},
+                    {"allReduce",    [&](){ cp.allReduce(context, std::plus<unsigned>(), send, recv); }},
+                    {"broadcast",    [&](){ cp.broadcast(rootVAddr, context, recv); }}
+                };
+
+                // Payload buffers are at least a segment or a chunk of
+                // nElements / P, far more than a page. Below a page are
+                // events, operations and lists of peers, that a call
+                // may create, but not the data it transmits.
+                countedAllocationSize = 4096;
+
+                // The warm-up rounds provide the buffers, after them a
+                // collective allocates no payload buffer at all
+                const unsigned nWarmUpRounds = 2;
+                for(auto const &collective : collectives){
+                    for(unsigned i = 0; i < nWarmUpRounds; ++i){
+                        collective.second();
+                    }
+                    cp.synchronize(context);
+
+                    nCountedAllocations = 0;
+                    countAllocations = true;
+                    collective.second();
+                    countAllocations = false;
+                    size_t const nAllocations = nCountedAllocations;
+
+                    cp.synchronize(context);
+                    BOOST_CHECK_MESSAGE(nAllocations == 0, collective.first << " allocated " << nAllocations << " payload buffers");
+                }
+
+            }
+	    
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( all_gather_large ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+    
+                Context context = cp.getGlobalContext();
+
+                const unsigned nElements = 100 * 1000;
+
+                std::vector<unsigned> send (nElements, context.getVAddr());
+                std::vector<unsigned> recv (nElements * context.size(), 0);
+
+                cp.allGather(context, send, recv);
+
+                for(unsigned i = 0; i < recv.size(); ++i){
+                    BOOST_CHECK_EQUAL(recv[i], i / nElements);
+                }
+		
+            }
+	    
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( broadcast_reduce_large ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+    
+                Context context = cp.getGlobalContext();
+
+                // Several segments and a partial one
+                const unsigned nElements = 1000 * 1000;
+                const unsigned rootVAddr = context.size() - 1;
+
+                std::vector<unsigned> data (nElements, 0);
+                if(context.getVAddr() == rootVAddr){
+                    std::iota(data.begin(), data.end(), 0);
+                }
+
+                cp.broadcast(rootVAddr, context, data);
+
+                for(unsigned i = 0; i < nElements; ++i){
+                    BOOST_CHECK_EQUAL(data[i], i);
+                }
+
+                std::vector<unsigned> recv (nElements, 0);
+                cp.reduce(rootVAddr, context, std::plus<unsigned>(), data, recv);
+
+                if(context.getVAddr() == rootVAddr){
+                    for(unsigned i = 0; i < nElements; ++i){
+                        BOOST_CHECK_EQUAL(recv[i], i * context.size());
+                    }
+                }
+		
+            }
+	    
+        });
+
+}
+
 BOOST_AUTO_TEST_CASE( broadcast ){
     hana::for_each(communicationPolicies, [](auto cpRef){
 	    // Test setup
@@ -619,4 +1199,310 @@ BOOST_AUTO_TEST_CASE( broadcast ){
 
 }
 
+BOOST_AUTO_TEST_CASE( all_to_all ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            using VAddr = typename CP::VAddr;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              Context context = cp.getGlobalContext();
+
+              const unsigned nElements = 10;
+              const unsigned vAddr = context.getVAddr();
+
+              for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+
+                // Block of dest holds src * size + dest
+                std::vector<unsigned> send(nElements * context.size());
+                for (unsigned i = 0; i < send.size(); ++i) {
+                  send[i] = vAddr * context.size() + i / nElements;
+                }
+                std::vector<unsigned> recv(nElements * context.size(), 0);
+
+                cp.allToAll(context, send, recv);
+
+                for (VAddr src = 0; src < context.size(); ++src) {
+                  for (unsigned j = 0; j < nElements; ++j) {
+                    BOOST_CHECK_EQUAL(recv[src * nElements + j], src * context.size() + vAddr);
+                  }
+                }
+              }
+            }
+	    
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( all_to_all_var ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            using VAddr = typename CP::VAddr;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              Context context = cp.getGlobalContext();
+
+              const unsigned vAddr = context.getVAddr();
+
+              for (unsigned run_i = 0; run_i < nRuns; ++run_i) {
+
+                // Src sends (src + dest) % 3 elements of value src * size + dest to dest
+                std::vector<unsigned> send;
+                std::vector<unsigned> sendCount;
+                for (VAddr dest = 0; dest < context.size(); ++dest) {
+                  sendCount.push_back((vAddr + dest) % 3);
+                  send.insert(send.end(), sendCount.back(), vAddr * context.size() + dest);
+                }
+                std::vector<unsigned> recv;
+                std::vector<unsigned> recvCount;
+
+                cp.allToAllVar(context, send, sendCount, recv, recvCount);
+
+                BOOST_REQUIRE_EQUAL(recvCount.size(), context.size());
+                unsigned i = 0;
+                for (VAddr src = 0; src < context.size(); ++src) {
+                  BOOST_CHECK_EQUAL(recvCount[src], (src + vAddr) % 3);
+                  for (unsigned j = 0; j < recvCount[src]; ++j) {
+                    BOOST_CHECK_EQUAL(recv.at(i), src * context.size() + vAddr);
+                    i++;
+                  }
+                }
+                BOOST_CHECK_EQUAL(recv.size(), i);
+              }
+            }
+
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( collectives_without_first_peer ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+              // The collectives use the vAddrs of the subcontext as
+              // block indices, thus they need to start at 0 again
+              Context global = cp.getGlobalContext();
+              bool const isMember = global.getVAddr() != 0 || global.size() == 1;
+              Context context = cp.splitContext(isMember, global);
+
+              if(context.valid()){
+                BOOST_CHECK_EQUAL(context.size(), std::max<std::size_t>(global.size() - 1, 1));
+                BOOST_CHECK_LT(context.getVAddr(), context.size());
+
+                const unsigned nElements = 10;
+                unsigned const vAddr = context.getVAddr();
+                std::size_t const nBlocks = nElements * context.size();
+                std::vector<unsigned> send(nElements, vAddr);
+
+                std::vector<unsigned> gathered(nBlocks, 0);
+                cp.gather(0, context, send, gathered);
+                if(vAddr == 0){
+                  for(unsigned i = 0; i < nBlocks; ++i){
+                    BOOST_CHECK_EQUAL(gathered[i], i / nElements);
+                  }
+                }
+
+                std::vector<unsigned> allGathered(nBlocks, 0);
+                cp.allGather(context, send, allGathered);
+                std::vector<unsigned> asyncAllGathered(nBlocks, 0);
+                cp.asyncAllGather(context, send, asyncAllGathered).wait();
+                for(unsigned i = 0; i < nBlocks; ++i){
+                  BOOST_CHECK_EQUAL(allGathered[i], i / nElements);
+                  BOOST_CHECK_EQUAL(asyncAllGathered[i], i / nElements);
+                }
+
+                std::vector<unsigned> sendAll(nBlocks, 0);
+                for(unsigned i = 0; i < nBlocks; ++i){
+                  sendAll[i] = vAddr * context.size() + i / nElements;
+                }
+                std::vector<unsigned> recvAll(nBlocks, 0);
+                cp.allToAll(context, sendAll, recvAll);
+                for(unsigned i = 0; i < nBlocks; ++i){
+                  BOOST_CHECK_EQUAL(recvAll[i], (i / nElements) * context.size() + vAddr);
+                }
+              }
+            }
+
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( async_collectives ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            using Event = typename CP::Event;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              Context context = cp.getGlobalContext();
+
+              const unsigned nElements = 10;
+              const unsigned vAddr = context.getVAddr();
+              const unsigned rootVAddr = context.size() - 1;
+
+              std::vector<unsigned> send(nElements, vAddr);
+              std::vector<unsigned> recv(nElements * context.size(), 0);
+
+              // The peers would compute while the collectives progress
+              Event gather = cp.asyncGather(rootVAddr, context, send, recv);
+              while (!gather.ready()) {
+              }
+              if (vAddr == rootVAddr) {
+                for (unsigned i = 0; i < recv.size(); ++i) {
+                  BOOST_CHECK_EQUAL(recv[i], i / nElements);
+                }
+              }
+
+              std::fill(recv.begin(), recv.end(), 0);
+              cp.asyncAllGather(context, send, recv).wait();
+              for (unsigned i = 0; i < recv.size(); ++i) {
+                BOOST_CHECK_EQUAL(recv[i], i / nElements);
+              }
+
+              std::vector<unsigned> block(nElements, 0);
+              cp.asyncScatter(rootVAddr, context, recv, block).wait();
+              for (unsigned d : block) {
+                BOOST_CHECK_EQUAL(d, vAddr);
+              }
+
+              std::vector<unsigned> sum(nElements, 0);
+              cp.asyncReduce(rootVAddr, context, std::plus<unsigned>(), send, sum).wait();
+              if (vAddr == rootVAddr) {
+                for (unsigned d : sum) {
+                  BOOST_CHECK_EQUAL(d, context.size() * (context.size() - 1) / 2);
+                }
+              }
+
+              // Custom operators are not mapped to the library
+              std::vector<unsigned> max(nElements, 0);
+              auto const maximum = [](unsigned a, unsigned b) { return a > b ? a : b; };
+              Event allReduce = cp.asyncAllReduce(context, maximum, send, max);
+              while (!allReduce.ready()) {
+              }
+              for (unsigned d : max) {
+                BOOST_CHECK_EQUAL(d, context.size() - 1);
+              }
+
+              std::fill(sum.begin(), sum.end(), 0);
+              cp.asyncAllReduce(context, std::plus<unsigned>(), send, sum).wait();
+              for (unsigned d : sum) {
+                BOOST_CHECK_EQUAL(d, context.size() * (context.size() - 1) / 2);
+              }
+
+              std::vector<unsigned> data(nElements, vAddr);
+              cp.asyncBroadcast(rootVAddr, context, data).wait();
+              for (unsigned d : data) {
+                BOOST_CHECK_EQUAL(d, rootVAddr);
+              }
+
+            }
+	    
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( async_reduce_like_blocking ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              Context context = cp.getGlobalContext();
+
+              const unsigned nElements = 10;
+              const unsigned vAddr = context.getVAddr();
+              const unsigned rootVAddr = context.size() - 1;
+
+              std::vector<unsigned> send(nElements, vAddr + 1);
+
+              // The received data is not zero, thus the asynchronous
+              // collectives need to treat it the same way
+              std::vector<unsigned> initial(nElements);
+              std::iota(initial.begin(), initial.end(), 100 * vAddr);
+
+              std::vector<unsigned> blocking(initial);
+              std::vector<unsigned> async(initial);
+              cp.reduce(rootVAddr, context, std::plus<unsigned>(), send, blocking);
+              cp.asyncReduce(rootVAddr, context, std::plus<unsigned>(), send, async).wait();
+              if (vAddr == rootVAddr) {
+                BOOST_CHECK_EQUAL_COLLECTIONS(async.begin(), async.end(), blocking.begin(), blocking.end());
+              }
+
+              blocking = initial;
+              async = initial;
+              cp.allReduce(context, std::plus<unsigned>(), send, blocking);
+              cp.asyncAllReduce(context, std::plus<unsigned>(), send, async).wait();
+              BOOST_CHECK_EQUAL_COLLECTIONS(async.begin(), async.end(), blocking.begin(), blocking.end());
+
+            }
+
+        });
+
+}
+
+BOOST_AUTO_TEST_CASE( synchronize ){
+    hana::for_each(communicationPolicies, [](auto cpRef){
+	    // Test setup
+	    using CP      = typename decltype(cpRef)::type;
+	    using Context = typename CP::Context;
+            using Event = typename CP::Event;
+            CP &cp = cpRef.get();
+
+            // Test run
+            {
+
+              Context context = cp.getGlobalContext();
+
+              // Barriers follow each other closely
+              const unsigned nBarriers = 10;
+              unsigned passed = 0;
+
+              for (unsigned barrier_i = 0; barrier_i < nBarriers; ++barrier_i) {
+
+                cp.synchronize(context);
+
+                // The peers would overlap the barrier with their own work
+                Event event = cp.asyncSynchronize(context);
+                while (!event.ready()) {
+                }
+                event.wait();
+
+                ++passed;
+
+              }
+
+              std::array<unsigned, 1> send{{passed}};
+              std::array<unsigned, 1> recv{{0}};
+              cp.allReduce(context, std::plus<unsigned>(), send, recv);
+
+              BOOST_CHECK_EQUAL(recv[0], nBarriers * context.size());
+
+            }
+	    
+        });
+
+}
+
 BOOST_AUTO_TEST_SUITE_END()
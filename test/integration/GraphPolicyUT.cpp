@@ -0,0 +1,187 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <vector>  /* std::vector */
+#include <tuple>   /* std::tie */
+
+// GRAYBAT
+#include <graybat/Cage.hpp>
+#include <graybat/communicationPolicy/BMPI.hpp>
+#include <graybat/graphPolicy/BGL.hpp>
+#include <graybat/graphPolicy/CSR.hpp>
+#include <graybat/pattern/Grid.hpp>
+#include <graybat/pattern/GridDiagonal.hpp>
+#include <graybat/pattern/FullyConnected.hpp>
+#include <graybat/pattern/Random.hpp>
+
+/***************************************************************************
+ * Test Suites
+ ****************************************************************************/
+BOOST_AUTO_TEST_SUITE( graybat_graph_policy )
+
+/*******************************************************************************
+ * Graph Policies to Test
+ ******************************************************************************/
+using BGL        = graybat::graphPolicy::BGL<>;
+using CSR        = graybat::graphPolicy::CSR<>;
+using BMPI       = graybat::communicationPolicy::BMPI;
+using BGLCage    = graybat::Cage<BMPI, BGL>;
+using CSRCage    = graybat::Cage<BMPI, CSR>;
+using BMPIConfig = BMPI::Config;
+
+using GraphDescription = graybat::graphPolicy::GraphDescription<BGL>;
+using EdgeID           = graybat::graphPolicy::EdgeID;
+using VertexID         = graybat::graphPolicy::VertexID;
+
+BMPIConfig bmpiGraphConfig;
+
+/**
+ * @brief Both policies are build from the same description, thus
+ *        they need to agree on every vertex, edge and its order.
+ */
+void checkEqualGraphs(GraphDescription const & graphDesc){
+    BGL bgl(graphDesc);
+    CSR csr(graphDesc);
+
+    BGL::AllVertexIter bglVertex, bglVertexEnd;
+    CSR::AllVertexIter csrVertex, csrVertexEnd;
+    std::tie(bglVertex, bglVertexEnd) = bgl.getVertices();
+    std::tie(csrVertex, csrVertexEnd) = csr.getVertices();
+
+    BOOST_REQUIRE_EQUAL(std::distance(bglVertex, bglVertexEnd), std::distance(csrVertex, csrVertexEnd));
+
+    for(; bglVertex != bglVertexEnd; ++bglVertex, ++csrVertex){
+        VertexID const vertex = *csrVertex;
+        BOOST_CHECK_EQUAL(*bglVertex, vertex);
+        BOOST_CHECK_EQUAL(bgl.getVertexProperty(vertex).first, csr.getVertexProperty(vertex).first);
+
+        std::vector<EdgeID> bglOutEdges;
+        std::vector<EdgeID> csrOutEdges;
+        BGL::OutEdgeIter bglOut, bglOutEnd;
+        CSR::OutEdgeIter csrOut, csrOutEnd;
+        std::tie(bglOut, bglOutEnd) = bgl.getOutEdges(vertex);
+        std::tie(csrOut, csrOutEnd) = csr.getOutEdges(vertex);
+        for(; bglOut != bglOutEnd; ++bglOut){
+            bglOutEdges.push_back(bgl.getEdgeProperty(*bglOut).first);
+            BOOST_CHECK_EQUAL(bgl.getEdgeSource(*bglOut), vertex);
+        }
+        for(; csrOut != csrOutEnd; ++csrOut){
+            csrOutEdges.push_back(csr.getEdgeProperty(*csrOut).first);
+            BOOST_CHECK_EQUAL(csr.getEdgeSource(*csrOut), vertex);
+        }
+        BOOST_CHECK_EQUAL_COLLECTIONS(bglOutEdges.begin(), bglOutEdges.end(), csrOutEdges.begin(), csrOutEdges.end());
+
+        std::vector<EdgeID> bglInEdges;
+        std::vector<EdgeID> csrInEdges;
+        BGL::InEdgeIter bglIn, bglInEnd;
+        CSR::InEdgeIter csrIn, csrInEnd;
+        std::tie(bglIn, bglInEnd) = bgl.getInEdges(vertex);
+        std::tie(csrIn, csrInEnd) = csr.getInEdges(vertex);
+        for(; bglIn != bglInEnd; ++bglIn){
+            bglInEdges.push_back(bgl.getEdgeProperty(*bglIn).first);
+            BOOST_CHECK_EQUAL(bgl.getEdgeTarget(*bglIn), vertex);
+        }
+        for(; csrIn != csrInEnd; ++csrIn){
+            csrInEdges.push_back(csr.getEdgeProperty(*csrIn).first);
+            BOOST_CHECK_EQUAL(csr.getEdgeTarget(*csrIn), vertex);
+        }
+        BOOST_CHECK_EQUAL_COLLECTIONS(bglInEdges.begin(), bglInEdges.end(), csrInEdges.begin(), csrInEdges.end());
+
+        BGL::AdjacentVertexIter bglAdjacent, bglAdjacentEnd;
+        CSR::AdjacentVertexIter csrAdjacent, csrAdjacentEnd;
+        std::tie(bglAdjacent, bglAdjacentEnd) = bgl.getAdjacentVertices(vertex);
+        std::tie(csrAdjacent, csrAdjacentEnd) = csr.getAdjacentVertices(vertex);
+        BOOST_CHECK_EQUAL_COLLECTIONS(bglAdjacent, bglAdjacentEnd, csrAdjacent, csrAdjacentEnd);
+    }
+
+    for(EdgeID edge = 0; edge < graphDesc.second.size(); ++edge){
+        VertexID const source = csr.getEdgeSource(edge);
+        VertexID const target = csr.getEdgeTarget(edge);
+        BOOST_CHECK_EQUAL(bgl.getEdgeSource(edge), source);
+        BOOST_CHECK_EQUAL(bgl.getEdgeTarget(edge), target);
+        BOOST_CHECK_EQUAL(bgl.getEdge(source, target).first, csr.getEdge(source, target).first);
+        BOOST_CHECK(csr.getEdge(source, target).second);
+    }
+
+}
+
+/***************************************************************************
+ * Test Cases
+ ****************************************************************************/
+
+BOOST_AUTO_TEST_CASE( csr_grid ){
+    checkEqualGraphs(graybat::pattern::Grid<BGL>(7, 5)());
+}
+
+BOOST_AUTO_TEST_CASE( csr_grid_diagonal ){
+    checkEqualGraphs(graybat::pattern::GridDiagonal<BGL>(5, 7)());
+}
+
+BOOST_AUTO_TEST_CASE( csr_fully_connected ){
+    checkEqualGraphs(graybat::pattern::FullyConnected<BGL>(9)());
+}
+
+BOOST_AUTO_TEST_CASE( csr_random ){
+    checkEqualGraphs(graybat::pattern::Random<BGL>(100, 1, 10, 42)());
+}
+
+BOOST_AUTO_TEST_CASE( csr_missing_edge ){
+    CSR csr(graybat::pattern::Grid<BGL>(3, 3)());
+    BOOST_CHECK(!csr.getEdge(0, 8).second);
+}
+
+BOOST_AUTO_TEST_CASE( csr_cage ){
+    BGLCage bglCage(bmpiGraphConfig);
+    CSRCage csrCage(bmpiGraphConfig);
+
+    bglCage.setGraph(graybat::pattern::GridDiagonal<BGL>(4, 6));
+    csrCage.setGraph(graybat::pattern::GridDiagonal<CSR>(4, 6));
+
+    auto bglVertices = bglCage.getVertices();
+    auto csrVertices = csrCage.getVertices();
+    BOOST_REQUIRE_EQUAL(bglVertices.size(), csrVertices.size());
+
+    for(unsigned vertex_i = 0; vertex_i < csrVertices.size(); ++vertex_i){
+        BOOST_CHECK_EQUAL(bglVertices[vertex_i].id, csrVertices[vertex_i].id);
+
+        auto bglOutEdges = bglCage.getOutEdges(bglVertices[vertex_i]);
+        auto csrOutEdges = csrCage.getOutEdges(csrVertices[vertex_i]);
+        BOOST_REQUIRE_EQUAL(bglOutEdges.size(), csrOutEdges.size());
+        for(unsigned edge_i = 0; edge_i < csrOutEdges.size(); ++edge_i){
+            BOOST_CHECK_EQUAL(bglOutEdges[edge_i].id, csrOutEdges[edge_i].id);
+            BOOST_CHECK_EQUAL(bglOutEdges[edge_i].target.id, csrOutEdges[edge_i].target.id);
+        }
+
+        auto bglInEdges = bglCage.getInEdges(bglVertices[vertex_i]);
+        auto csrInEdges = csrCage.getInEdges(csrVertices[vertex_i]);
+        BOOST_REQUIRE_EQUAL(bglInEdges.size(), csrInEdges.size());
+        for(unsigned edge_i = 0; edge_i < csrInEdges.size(); ++edge_i){
+            BOOST_CHECK_EQUAL(bglInEdges[edge_i].id, csrInEdges[edge_i].id);
+            BOOST_CHECK_EQUAL(bglInEdges[edge_i].source.id, csrInEdges[edge_i].source.id);
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_SUITE_END()
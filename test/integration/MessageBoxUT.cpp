@@ -0,0 +1,127 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+
+// STL
+#include <chrono>  /* std::chrono::milliseconds */
+#include <thread>  /* std::thread, std::this_thread::sleep_for */
+#include <vector>  /* std::vector */
+
+// GRAYBAT
+#include <graybat/utils/StripedMessageBox.hpp>
+
+/***************************************************************************
+ * Test Suites
+ ****************************************************************************/
+BOOST_AUTO_TEST_SUITE( graybat_message_box )
+
+using Value = std::vector<char>;
+using Box   = utils::StripedMessageBox<Value, unsigned, unsigned>;
+using Key   = utils::PackedKey<unsigned, unsigned>;
+
+/**
+ * @brief Returns *n* keys, that fall into the same stripe as *key*.
+ */
+std::vector<unsigned> collidingKeys(unsigned const key, std::size_t const n){
+    auto const stripeOf = [](unsigned const k){
+        return (Key(0, k).hash >> 40) % Box::nStripes;
+    };
+
+    std::vector<unsigned> keys;
+    for(unsigned k = key + 1; keys.size() < n; ++k){
+        if(stripeOf(k) == stripeOf(key)){
+            keys.push_back(k);
+        }
+    }
+    return keys;
+}
+
+/***************************************************************************
+ * Test Cases
+ ****************************************************************************/
+
+BOOST_AUTO_TEST_CASE( wait_while_stripe_rehashes ){
+    Box box(1u << 30);
+    unsigned const waitKey = 7;
+    std::vector<unsigned> const keys = collidingKeys(waitKey, 2000);
+
+    for(unsigned round_i = 0; round_i < 20; ++round_i){
+        Value received;
+        std::thread waiter([&]{
+            received = box.waitDequeue(0, waitKey);
+        });
+
+        // Let the waiter block, then grow the stripe of its key
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for(unsigned k : keys){
+            box.enqueue(Value(1, 'x'), 0, k);
+        }
+        box.enqueue(Value(3, static_cast<char>(round_i)), 0, waitKey);
+        waiter.join();
+
+        BOOST_REQUIRE_EQUAL(received.size(), 3);
+        BOOST_CHECK_EQUAL(received[0], static_cast<char>(round_i));
+
+        // Drain, so the next round rehashes again
+        for(unsigned k : keys){
+            bool result = false;
+            box.tryDequeue(result, 0, k);
+            BOOST_CHECK(result);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(box.bufferSize, 0);
+}
+
+BOOST_AUTO_TEST_CASE( prefix_wait_while_stripe_rehashes ){
+    Box box(1u << 30);
+    unsigned const waitKey = 11;
+    std::vector<unsigned> const keys = collidingKeys(waitKey, 2000);
+
+    for(unsigned round_i = 0; round_i < 20; ++round_i){
+        boost::hana::tuple<unsigned, unsigned> allKeys;
+        Value received;
+        std::thread waiter([&]{
+            received = box.waitDequeue(allKeys, 1u);
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        for(unsigned k : keys){
+            box.enqueue(Value(1, 'x'), 0, k);
+        }
+        box.enqueue(Value(3, static_cast<char>(round_i)), 1, waitKey);
+        waiter.join();
+
+        BOOST_REQUIRE_EQUAL(received.size(), 3);
+        BOOST_CHECK_EQUAL(boost::hana::at_c<1>(allKeys), waitKey);
+
+        for(unsigned k : keys){
+            bool result = false;
+            box.tryDequeue(result, 0, k);
+            BOOST_CHECK(result);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(box.bufferSize, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,258 @@
+/**
+ * Copyright 2016 Erik Zenker
+ *
+ * This file is part of Graybat.
+ *
+ * Graybat is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Graybat is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Graybat.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// STL
+#include <atomic>     /* std::atomic */
+#include <memory>     /* std::make_shared */
+#include <numeric>    /* std::iota */
+#include <thread>     /* std::thread */
+#include <vector>     /* std::vector */
+
+// BOOST
+#include <boost/test/unit_test.hpp>
+
+// GRAYBAT
+#include <graybat/Cage.hpp>
+#include <graybat/communicationPolicy/Threads.hpp>
+#include <graybat/graphPolicy/BGL.hpp>
+#include <graybat/mapping/Roundrobin.hpp>
+#include <graybat/pattern/FullyConnected.hpp>
+
+/*******************************************************************************
+ * Peers to Test
+ ******************************************************************************/
+using Threads = graybat::communicationPolicy::Threads;
+using GP = graybat::graphPolicy::BGL<>;
+using ThreadsCage = graybat::Cage<Threads, GP>;
+using Context = Threads::Context;
+using Event = Threads::Event;
+
+// The policy is part of the generic suites of CommunicationPolicyUT
+// and CageUT, where every process is a network of a single peer. The
+// cases below cover several peer threads of one network.
+unsigned const nPeers = 4;
+
+// Runs peer in nPeers threads of this process, each constructs its own
+// policy from the shared config. Boost.Test checks are not thread-safe,
+// thus the peers return their number of failed checks.
+template <typename T_Peer> unsigned runPeers(T_Peer peer) {
+  Threads::Config config;
+  config.network = std::make_shared<Threads::Network>(nPeers);
+
+  std::atomic<unsigned> nErrors{0};
+  std::vector<std::thread> peers;
+  for (unsigned peer_i = 0; peer_i < nPeers; ++peer_i) {
+    peers.emplace_back([&]() { nErrors += peer(config); });
+  }
+  for (std::thread &thread : peers) {
+    thread.join();
+  }
+  return nErrors;
+}
+
+/*******************************************************************************
+ * Point to Point Test Suites
+ ******************************************************************************/
+BOOST_AUTO_TEST_SUITE(graybat_threads_cp_point_to_point)
+
+BOOST_AUTO_TEST_CASE(context) {
+  BOOST_CHECK_EQUAL(runPeers([](Threads::Config const &config) {
+                      Threads cp(config);
+                      unsigned errors = 0;
+
+                      Context context = cp.getGlobalContext();
+                      errors += context.size() != nPeers;
+
+                      // Peers with even vAddr form a new context
+                      bool const isMember = context.getVAddr() % 2 == 0;
+                      Context evenContext = cp.splitContext(isMember, context);
+                      errors += evenContext.valid() != isMember;
+                      if (isMember) {
+                        errors += evenContext.size() != (nPeers + 1) / 2;
+                        errors += evenContext.getID() == context.getID();
+                      }
+
+                      Context newContext = cp.splitContext(true, context);
+                      errors += newContext.size() != nPeers;
+                      return errors;
+                    }),
+                    0);
+}
+
+BOOST_AUTO_TEST_CASE(send_recv_all) {
+  BOOST_CHECK_EQUAL(runPeers([](Threads::Config const &config) {
+                      Threads cp(config);
+                      unsigned errors = 0;
+                      const unsigned nElements = 10;
+
+                      Context context = cp.getGlobalContext();
+                      std::vector<unsigned> recv(nElements, 0);
+
+                      std::vector<unsigned> data(nElements, 0);
+                      std::iota(data.begin(), data.end(), context.getVAddr());
+                      for (unsigned vAddr = 0; vAddr < context.size(); ++vAddr) {
+                        cp.send(vAddr, context.getVAddr(), context, data);
+                      }
+
+                      for (unsigned i = 0; i < context.size(); ++i) {
+                        Event e = cp.recv(context, recv);
+                        unsigned vAddr = e.source();
+                        errors += e.getTag() != vAddr;
+                        for (unsigned i = 0; i < recv.size(); ++i) {
+                          errors += recv[i] != vAddr + i;
+                        }
+                      }
+                      return errors;
+                    }),
+                    0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/*******************************************************************************
+ * Collective Test Suites
+ ******************************************************************************/
+BOOST_AUTO_TEST_SUITE(graybat_threads_cp_collectives)
+
+BOOST_AUTO_TEST_CASE(synchronize) {
+  // No peer may leave a barrier before all peers arrived at it
+  std::atomic<unsigned> arrived{0};
+  BOOST_CHECK_EQUAL(runPeers([&arrived](Threads::Config const &config) {
+                      Threads cp(config);
+                      unsigned errors = 0;
+                      const unsigned nBarriers = 10;
+
+                      Context context = cp.getGlobalContext();
+
+                      for (unsigned barrier_i = 0; barrier_i < nBarriers; ++barrier_i) {
+                        ++arrived;
+                        if (barrier_i % 2) {
+                          cp.synchronize(context);
+                        } else {
+                          Event event = cp.asyncSynchronize(context);
+                          while (!event.ready()) {
+                          }
+                        }
+                        errors += arrived < (barrier_i + 1) * context.size();
+                      }
+                      return errors;
+                    }),
+                    0);
+}
+
+BOOST_AUTO_TEST_CASE(collectives_without_first_peer) {
+  BOOST_CHECK_EQUAL(runPeers([](Threads::Config const &config) {
+                      Threads cp(config);
+                      unsigned errors = 0;
+                      const unsigned nElements = 10;
+
+                      // The collectives use the vAddrs of the subcontext
+                      // as block indices
+                      Context global = cp.getGlobalContext();
+                      Context context = cp.splitContext(global.getVAddr() != 0, global);
+                      if (!context.valid()) {
+                        return errors;
+                      }
+                      errors += context.size() != nPeers - 1;
+                      errors += context.getVAddr() != global.getVAddr() - 1;
+
+                      unsigned const vAddr = context.getVAddr();
+                      unsigned const nBlocks = nElements * context.size();
+                      std::vector<unsigned> send(nElements, vAddr);
+
+                      std::vector<unsigned> gathered(nBlocks, 0);
+                      cp.gather(0, context, send, gathered);
+                      if (vAddr == 0) {
+                        for (unsigned i = 0; i < nBlocks; ++i) {
+                          errors += gathered[i] != i / nElements;
+                        }
+                      }
+
+                      std::vector<unsigned> allGathered(nBlocks, 0);
+                      cp.allGather(context, send, allGathered);
+                      std::vector<unsigned> asyncAllGathered(nBlocks, 0);
+                      cp.asyncAllGather(context, send, asyncAllGathered).wait();
+                      for (unsigned i = 0; i < nBlocks; ++i) {
+                        errors += allGathered[i] != i / nElements;
+                        errors += asyncAllGathered[i] != i / nElements;
+                      }
+
+                      std::vector<unsigned> sendAll(nBlocks, 0);
+                      for (unsigned i = 0; i < nBlocks; ++i) {
+                        sendAll[i] = vAddr * context.size() + i / nElements;
+                      }
+                      std::vector<unsigned> recvAll(nBlocks, 0);
+                      cp.allToAll(context, sendAll, recvAll);
+                      for (unsigned i = 0; i < nBlocks; ++i) {
+                        errors += recvAll[i] != (i / nElements) * context.size() + vAddr;
+                      }
+                      return errors;
+                    }),
+                    0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/*******************************************************************************
+ * Cage Test Suites
+ ******************************************************************************/
+BOOST_AUTO_TEST_SUITE(graybat_threads_cage)
+
+BOOST_AUTO_TEST_CASE(send_recv) {
+  BOOST_CHECK_EQUAL(runPeers([](Threads::Config const &config) {
+                      using Vertex = ThreadsCage::Vertex;
+                      using Edge = ThreadsCage::Edge;
+
+                      ThreadsCage cage(config);
+                      unsigned errors = 0;
+                      const unsigned nElements = 1000;
+
+                      cage.setGraph(graybat::pattern::FullyConnected<GP>(cage.getPeers().size()));
+                      cage.distribute(graybat::mapping::Roundrobin());
+
+                      std::vector<Event> events;
+                      std::vector<unsigned> send(nElements, 0);
+                      std::iota(send.begin(), send.end(), 0);
+
+                      for (Vertex &v : cage.getHostedVertices()) {
+                        for (Edge edge : cage.getOutEdges(v)) {
+                          cage.send(edge, send, events);
+                        }
+                      }
+
+                      for (Vertex &v : cage.getHostedVertices()) {
+                        for (Edge edge : cage.getInEdges(v)) {
+                          auto recv = cage.template recv<unsigned>(edge);
+                          errors += recv.size() != nElements;
+                          for (unsigned i = 0; i < recv.size(); ++i) {
+                            errors += recv[i] != i;
+                          }
+                        }
+                      }
+
+                      for (Event &e : events) {
+                        e.wait();
+                      }
+                      return errors;
+                    }),
+                    0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
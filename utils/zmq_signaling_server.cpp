@@ -19,13 +19,20 @@
  */
 
 // CLIB
-#include <string.h>   /* strup */
+#include <string.h>   /* memcpy */
 
 // STL
-#include <iostream> /* std::cout, std::endl */
+#include <algorithm> /* std::max, std::min */
+#include <atomic>   /* std::atomic */
+#include <chrono>   /* std::chrono::steady_clock */
+#include <cstdint>  /* std::uint64_t */
+#include <iostream> /* std::cout, std::cerr, std::endl */
 #include <map>      /* std::map */
+#include <mutex>    /* std::mutex, std::lock_guard */
+#include <stdexcept> /* std::runtime_error */
 #include <string>   /* std::string */
-#include <sstream>  /* std::stringstream */
+#include <thread>   /* std::thread */
+#include <vector>   /* std::vector */
 
 // BOOSt
 #include <boost/program_options.hpp>
@@ -34,44 +41,391 @@
 // ZMQ
 #include <zmq.hpp>
 
+// GrayBat
+#include <graybat/communicationPolicy/Traits.hpp>                  /* MsgTypeType */
+#include <graybat/communicationPolicy/socket/SignalingMessage.hpp> /* SignalingMessage */
+
 // Type defs
 typedef unsigned Tag;
 typedef unsigned ContextID;
 typedef std::string ContextName;
 typedef unsigned VAddr;
-typedef unsigned MsgType;
+typedef graybat::communicationPolicy::MsgTypeType MsgType;
+typedef graybat::communicationPolicy::socket::SignalingMessage SignalingMessage;
 typedef std::string Uri;
-
-// Message tags
-static const MsgType VADDR_REQUEST     = 0;
-static const MsgType VADDR_LOOKUP      = 1;
-static const MsgType DESTRUCT          = 2;
-static const MsgType RETRY             = 3;
-static const MsgType ACK               = 4;
-static const MsgType CONTEXT_INIT      = 5;
-static const MsgType CONTEXT_REQUEST   = 6;
-
-//  Receive 0MQ string from socket and convert into C string
-//  Caller must free returned string. Returns NULL if the context
-//  is being terminated.
-static char * s_recv (zmq::socket_t& socket) {
-    zmq::message_t message(256);
+typedef std::string PeerID;
+
+// Workers receive the requests of the frontend through this endpoint
+static const char * workersUri = "inproc://signaling_workers";
+
+// Phone book lookup that is answered when the context is complete
+struct PhoneBookLookup {
+    PeerID peer;
+    std::uint64_t contextSize;
+};
+
+//  Receive request from socket, the router prefixes it with
+//  the identity of the peer and an empty delimiter frame
+static SignalingMessage s_recv (zmq::socket_t& socket, PeerID & peer) {
+    zmq::message_t identity;
+    zmq::message_t delimiter;
+    zmq::message_t message;
+    socket.recv(&identity);
+    socket.recv(&delimiter);
     socket.recv(&message);
-    if (message.size() == static_cast<size_t>(-1))
-        return NULL;
-    if (message.size() > 255)
-        static_cast<char*>(message.data())[255] = 0;
-    return strdup (static_cast<char*>(message.data()));
+    peer = PeerID(static_cast<char*>(identity.data()), identity.size());
+    return SignalingMessage(message.data(), message.size());
 }
 
-//  Convert C string to 0MQ string and send to socket
-static int s_send (zmq::socket_t& socket, const char *string) {
-    zmq::message_t message(sizeof(char) * strlen(string));
-    memcpy (static_cast<char*>(message.data()), string, sizeof(char) * strlen(string));
+//  Send reply to the peer with identity peer
+static int s_send (zmq::socket_t& socket, PeerID const & peer, SignalingMessage const & reply) {
+    zmq::message_t identity(peer.size());
+    zmq::message_t delimiter(0);
+    zmq::message_t message(reply.size());
+    memcpy (static_cast<char*>(identity.data()), peer.data(), peer.size());
+    memcpy (static_cast<char*>(message.data()), reply.data(), reply.size());
+    socket.send(identity, ZMQ_SNDMORE);
+    socket.send(delimiter, ZMQ_SNDMORE);
     socket.send(message);
     return 0;
 }
 
+//  Send request of simulated peers through a dealer socket, which
+//  needs to add the empty delimiter frame of a req socket itself
+static void s_post (zmq::socket_t& socket, SignalingMessage const & request) {
+    zmq::message_t delimiter(0);
+    zmq::message_t message(request.size());
+    memcpy (static_cast<char*>(message.data()), request.data(), request.size());
+    socket.send(delimiter, ZMQ_SNDMORE);
+    socket.send(message);
+}
+
+//  Receive the next reply to a simulated peer from a dealer socket
+static SignalingMessage s_fetch (zmq::socket_t& socket) {
+    zmq::message_t delimiter;
+    zmq::message_t message;
+    socket.recv(&delimiter);
+    socket.recv(&message);
+    return SignalingMessage(message.data(), message.size());
+}
+
+//  Send request of a simulated peer and receive the reply
+static SignalingMessage s_request (zmq::socket_t& socket, SignalingMessage const & request) {
+    s_post(socket, request);
+    return s_fetch(socket);
+}
+
+/**
+ * @brief Phone books of the contexts, whose id maps to this shard.
+ *
+ */
+struct Shard {
+    std::mutex access;
+    std::map<ContextID, std::map<VAddr, Uri> > phoneBook;
+    std::map<ContextID, std::map<VAddr, Uri> > ctrlPhoneBook;
+    std::map<ContextID, std::vector<PhoneBookLookup> > pendingLookups;
+};
+
+/**
+ * @brief State of the signaling server, that is shared by all
+ *        workers. Requests of different contexts only contend
+ *        when their contexts map to the same shard.
+ *
+ */
+struct Signaling {
+
+    Signaling(size_t const nShards, bool const quiet) :
+        shards(nShards),
+        maxContextID(0),
+        quiet(quiet){
+
+    }
+
+    std::vector<Shard> shards;
+
+    std::mutex contextAccess;
+    std::map<ContextName, ContextID> contextIds;
+    ContextID maxContextID;
+
+    std::mutex logAccess;
+    bool const quiet;
+
+    Shard& shardOf(ContextID const contextID){
+        return shards[contextID % shards.size()];
+    }
+
+    template <typename T_Line>
+    void log(T_Line const & line){
+        if(!quiet){
+            std::lock_guard<std::mutex> logLock(logAccess);
+            std::cout << line() << std::endl;
+        }
+    }
+
+    // Errors are printed in quiet mode as well
+    template <typename T_Line>
+    void error(T_Line const & line){
+        std::lock_guard<std::mutex> logLock(logAccess);
+        std::cerr << line() << std::endl;
+    }
+
+    // The shard of the context needs to be locked
+    SignalingMessage phoneBookOf(Shard &shard, ContextID const contextID){
+        SignalingMessage reply;
+        reply << MsgType::ACK << static_cast<std::uint64_t>(shard.phoneBook[contextID].size());
+        for(auto const &entry : shard.phoneBook[contextID]){
+            reply << entry.first << entry.second << shard.ctrlPhoneBook[contextID][entry.first];
+        }
+        return reply;
+    }
+
+    void handle(zmq::socket_t& socket, PeerID const & peer, SignalingMessage & request){
+        Uri srcUri;
+        Uri ctrlUri;
+        MsgType type;
+        ContextID contextID;
+        ContextName contextName;
+        request >> type;
+
+        switch(type){
+
+            case MsgType::CONTEXT_REQUEST:
+            {
+                request >> contextName;
+                {
+                    std::lock_guard<std::mutex> contextLock(contextAccess);
+                    if(contextIds.find(contextName) != contextIds.end()){
+                        contextID = contextIds.at(contextName);
+                    }
+                    else {
+                        contextID = maxContextID++;
+                        contextIds[contextName] = contextID;
+                    }
+                }
+
+                SignalingMessage reply;
+                reply << contextID;
+                s_send(socket, peer, reply);
+                log([&]{ return "CONTEXT REQUEST [name:" + contextName + "]: " + std::to_string(contextID); });
+                break;
+
+            }
+
+            case MsgType::VADDR_REQUEST:
+            {
+                // Reply with correct information
+                request >> contextID >> srcUri >> ctrlUri;
+
+                VAddr vAddr;
+                std::vector<std::pair<PeerID, SignalingMessage> > completed;
+                {
+                    Shard &shard = shardOf(contextID);
+                    std::lock_guard<std::mutex> shardLock(shard.access);
+                    vAddr = shard.phoneBook[contextID].size();
+                    shard.phoneBook[contextID][vAddr] = srcUri;
+                    shard.ctrlPhoneBook[contextID][vAddr] = ctrlUri;
+
+                    // Answer the lookups, that waited for this peer
+                    std::vector<PhoneBookLookup> &lookups = shard.pendingLookups[contextID];
+                    for(auto it = lookups.begin(); it != lookups.end();){
+                        if(shard.phoneBook[contextID].size() >= it->contextSize){
+                            completed.emplace_back(it->peer, phoneBookOf(shard, contextID));
+                            it = lookups.erase(it);
+                        }
+                        else {
+                            ++it;
+                        }
+                    }
+                }
+
+                SignalingMessage reply;
+                reply << vAddr;
+                s_send(socket, peer, reply);
+                for(auto const &lookup : completed){
+                    s_send(socket, lookup.first, lookup.second);
+                }
+                log([&]{ return "VADDR REQUEST [contextID:" + std::to_string(contextID) + "][srcUri:" + srcUri + "][ctrlUri:" + ctrlUri + "]:" + std::to_string(vAddr); });
+                break;
+            }
+
+            case MsgType::VADDR_LOOKUP:
+            {
+                VAddr remoteVAddr;
+                request >> contextID >> remoteVAddr;
+
+                SignalingMessage reply;
+                {
+                    Shard &shard = shardOf(contextID);
+                    std::lock_guard<std::mutex> shardLock(shard.access);
+                    if(shard.phoneBook[contextID].count(remoteVAddr) == 0){
+                        reply << MsgType::RETRY;
+                    }
+                    else {
+                        reply << MsgType::ACK << shard.phoneBook[contextID][remoteVAddr] << shard.ctrlPhoneBook[contextID][remoteVAddr];
+                    }
+                }
+                s_send(socket, peer, reply);
+
+                break;
+            }
+
+            case MsgType::PHONEBOOK_LOOKUP:
+            {
+                std::uint64_t contextSize;
+                request >> contextID >> contextSize;
+
+                bool complete = false;
+                SignalingMessage reply;
+                {
+                    Shard &shard = shardOf(contextID);
+                    std::lock_guard<std::mutex> shardLock(shard.access);
+                    complete = shard.phoneBook[contextID].size() >= contextSize;
+                    if(complete){
+                        reply = phoneBookOf(shard, contextID);
+                    }
+                    else {
+                        shard.pendingLookups[contextID].push_back(PhoneBookLookup{peer, contextSize});
+                    }
+                }
+                if(complete){
+                    s_send(socket, peer, reply);
+                }
+                log([&]{ return "PHONEBOOK LOOKUP [contextID:" + std::to_string(contextID) + "][contextSize:" + std::to_string(contextSize) + "]"; });
+                break;
+            }
+
+            case MsgType::DESTRUCT:
+            {
+                request >> contextName;
+                {
+                    std::lock_guard<std::mutex> contextLock(contextAccess);
+                    if(contextIds.find(contextName) != contextIds.end()){
+                        contextIds.erase(contextIds.find(contextName));
+                    }
+                }
+
+                s_send(socket, peer, SignalingMessage());
+                log([&]{ return std::string("DESTRUCT"); });
+                break;
+            }
+
+            default:
+                // Reply empty message, which the peer fails to read,
+                // the server keeps serving the other peers
+                s_send(socket, peer, SignalingMessage());
+                error([&]{ return "UNKNOWN MESSAGE TYPE [type:" + std::to_string(static_cast<int>(type)) + "]"; });
+                break;
+
+        };
+
+    }
+
+};
+
+/**
+ * @brief Serves the requests, that the frontend distributes
+ *        among the workers.
+ *
+ */
+static void work(zmq::context_t & context, Signaling & signaling){
+    zmq::socket_t socket (context, ZMQ_DEALER);
+    socket.connect(workersUri);
+
+    while(true){
+        PeerID peer;
+        SignalingMessage request = s_recv(socket, peer);
+        try {
+            signaling.handle(socket, peer, request);
+        }
+        catch(std::runtime_error const & e){
+            // Truncated request, handle replies only after reading it
+            s_send(socket, peer, SignalingMessage());
+            signaling.error([&]{ return std::string("MALFORMED REQUEST: ") + e.what(); });
+        }
+    }
+
+}
+
+/**
+ * @brief Simulates *nJobs* jobs of *nPeers* peers each, that
+ *        register at the server and look each other up.
+ *
+ * The peers are distributed round robin over *nThreads* threads,
+ * each thread serves its peers through one dealer socket. A thread
+ * registers all of its peers before it sends their phone book
+ * lookups, thus the lookups never block the registration of the
+ * peers, that complete a job.
+ *
+ */
+static void simulate(std::string const signalingUri, size_t const nPeers, size_t const nJobs, size_t const nThreads){
+    zmq::context_t context(1);
+    std::atomic<size_t> nFailed(0);
+    std::vector<std::thread> threads;
+
+    size_t const nSimulated = nPeers * nJobs;
+    size_t const nUsedThreads = std::max(std::min(nThreads, nSimulated), static_cast<size_t>(1));
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for(size_t thread_i = 0; thread_i < nUsedThreads; ++thread_i){
+        threads.emplace_back([&, thread_i]{
+                zmq::socket_t socket (context, ZMQ_DEALER);
+                socket.connect(signalingUri.c_str());
+
+                std::vector<ContextID> contextIDs;
+                for(size_t simulated_i = thread_i; simulated_i < nSimulated; simulated_i += nUsedThreads){
+                    size_t const job_i  = simulated_i / nPeers;
+                    size_t const peer_i = simulated_i % nPeers;
+
+                    ContextID contextID;
+                    SignalingMessage contextRequest;
+                    contextRequest << MsgType::CONTEXT_REQUEST << ContextName("simulation_" + std::to_string(job_i));
+                    s_request(socket, contextRequest) >> contextID;
+
+                    VAddr vAddr;
+                    SignalingMessage vAddrRequest;
+                    vAddrRequest << MsgType::VADDR_REQUEST << contextID
+                                 << Uri("tcp://127.0.0.1:" + std::to_string(10000 + 2 * peer_i))
+                                 << Uri("tcp://127.0.0.1:" + std::to_string(10001 + 2 * peer_i));
+                    s_request(socket, vAddrRequest) >> vAddr;
+
+                    contextIDs.push_back(contextID);
+                }
+
+                // The router of the server drops replies beyond its high
+                // water mark, thus only a window of lookups is pending.
+                // Replies arrive in the order, the jobs completed
+                size_t const maxPendingLookups = 1000;
+                size_t nPosted = 0;
+                for(size_t lookup_i = 0; lookup_i < contextIDs.size(); ++lookup_i){
+                    for(; nPosted < contextIDs.size() && nPosted - lookup_i < maxPendingLookups; ++nPosted){
+                        SignalingMessage lookup;
+                        lookup << MsgType::PHONEBOOK_LOOKUP << contextIDs[nPosted] << static_cast<std::uint64_t>(nPeers);
+                        s_post(socket, lookup);
+                    }
+
+                    MsgType type;
+                    std::uint64_t nEntries;
+                    s_fetch(socket) >> type >> nEntries;
+                    if(type != MsgType::ACK || nEntries != nPeers){
+                        ++nFailed;
+                    }
+                }
+            });
+    }
+
+    for(std::thread &thread : threads){
+        thread.join();
+    }
+
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "SIMULATION [jobs:" << nJobs << "][peers:" << nPeers << "][threads:" << nUsedThreads << "]: "
+              << seconds << " s, "
+              << 3 * nJobs * nPeers / seconds << " requests/s, "
+              << nFailed << " failed lookups" << std::endl;
+
+}
+
 int main(const int argc, char **argv){
     /***************************************************************************
      * Parse Commandline
@@ -92,6 +446,23 @@ int main(const int argc, char **argv){
             ("protocoll",
              po::value<std::string>()->default_value("tcp"),
              "Protocoll to listen for signaling requests. Options are tcp and udp. Default is udp.")
+            ("workers,w",
+             po::value<size_t>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)),
+             "Number of worker threads, that serve signaling requests")
+            ("shards",
+             po::value<size_t>()->default_value(64),
+             "Number of shards, the contexts are distributed over")
+            ("quiet,q",
+             "Do not print each request")
+            ("simulate",
+             po::value<size_t>(),
+             "Simulate the given number of peers per job, that register and look each other up, print the elapsed time and exit")
+            ("jobs",
+             po::value<size_t>()->default_value(1),
+             "Number of concurrent jobs to simulate")
+            ("simulation-threads",
+             po::value<size_t>()->default_value(std::max(std::thread::hardware_concurrency(), 1u)),
+             "Number of threads, the simulated peers are distributed over")
             ("help,h",
              "Print this help message and exit");
 
@@ -128,121 +499,41 @@ int main(const int argc, char **argv){
 
     std::cout << "Start zmq signaling server" << std::endl;
 
-    std::map<ContextID, std::map<VAddr, Uri> > phoneBook;
-    std::map<ContextID, std::map<VAddr, Uri> > ctrlPhoneBook;
-    std::map<ContextID, VAddr> maxVAddr;
-    std::map<ContextID, std::vector<Uri> > peers;
-    std::map<ContextName, ContextID> contextIds;
+    Signaling signaling(std::max(vm["shards"].as<size_t>(), static_cast<size_t>(1)), vm.count("quiet") || vm.count("simulate"));
 
     std::cout << "Listening on: " << masterUri << std::endl;
 
     zmq::context_t context(1);
 
-    zmq::message_t request;
-    zmq::message_t reply;
-    zmq::socket_t socket (context, ZMQ_REP);
+    // Router instead of rep socket, thus phone book lookups
+    // can be answered later, when the context is complete
+    zmq::socket_t frontend (context, ZMQ_ROUTER);
     const int hwm = 10000;
-    socket.setsockopt( ZMQ_RCVHWM, &hwm, sizeof(hwm));
-    socket.setsockopt( ZMQ_SNDHWM, &hwm, sizeof(hwm));
-
-
-    socket.bind(masterUri.c_str());
-
-    ContextID maxContextID = 0;
-    ContextID maxInitialContextID = maxContextID;
-
-    while(true){
-        std::stringstream ss;
-        ss << s_recv(socket);
-
-        Uri srcUri;
-        Uri ctrlUri;
-        MsgType type;
-        ContextID contextID;
-        ContextName contextName;
-        unsigned size;
-        ss >> type;
-
-        switch(type){
-
-            case CONTEXT_REQUEST:
-            {
-                ss >> contextName;
-                if(contextIds.find(contextName) != contextIds.end()){
-                    contextID = contextIds.at(contextName);
-                }
-                else {
-                    contextID = maxContextID++;
-                    contextIds[contextName] = contextID;
-                }
-
-                s_send(socket, (std::to_string(contextID) + " ").c_str());
-                std::cout << "CONTEXT REQUEST [name:" << contextName << "]: " << contextID << std::endl;
-                break;
-
-            }
-
-            case VADDR_REQUEST:
-            {
-                // Reply with correct information
-                ss >> contextID;
-                ss >> srcUri;
-                ss >> ctrlUri;
-
-                peers[contextID].push_back(srcUri);
-                VAddr vAddr = peers[contextID].size() - 1;
-
-                phoneBook[contextID][vAddr] = srcUri;
-                ctrlPhoneBook[contextID][vAddr] = ctrlUri;
-                s_send(socket, (std::to_string(vAddr) + " ").c_str());
-                std::cout << "VADDR REQUEST [contextID:" << contextID << "][srcUri:" << srcUri << "]" << "[ctrlUri:" << ctrlUri << "]:" <<  vAddr << std::endl;
-                break;
-            }
-
-            case VADDR_LOOKUP:
-            {
-                VAddr remoteVAddr;
-                ss >> contextID;
-                ss >> remoteVAddr;
-
-                std::stringstream sss;
-
-                if(phoneBook[contextID].count(remoteVAddr) == 0){
-                    sss << RETRY << " ";
-                    s_send(socket, sss.str().c_str());
-                    //std::cout << "VADDR LOOKUP [contextID:" << contextID << "][remoteVAddr:" << remoteVAddr << "]: " << " RETRY " << std::endl;
-                }
-                else {
-                    sss << ACK << " " << phoneBook[contextID][remoteVAddr] << " " << ctrlPhoneBook[contextID][remoteVAddr] << " ";
-                    s_send(socket, sss.str().c_str());
-                    //std::cout << "VADDR LOOKUP [contextID:" << contextID << "][remoteVAddr:" << remoteVAddr << "]: " << phoneBook[contextID][remoteVAddr] << " " << ctrlPhoneBook[contextID][remoteVAddr] << std::endl;
-                }
-
-                break;
-            }
-
-            case DESTRUCT:
-                ss >> contextName;
-                if(contextIds.find(contextName) != contextIds.end()){
-                    contextIds.erase(contextIds.find(contextName));
-                }
-//                else {
-//                    contextID = maxContextID++;
-//                    contextIds[contextName] = contextID;
-//                }
+    frontend.setsockopt( ZMQ_RCVHWM, &hwm, sizeof(hwm));
+    frontend.setsockopt( ZMQ_SNDHWM, &hwm, sizeof(hwm));
+    frontend.bind(masterUri.c_str());
+
+    zmq::socket_t backend (context, ZMQ_DEALER);
+    backend.setsockopt( ZMQ_RCVHWM, &hwm, sizeof(hwm));
+    backend.setsockopt( ZMQ_SNDHWM, &hwm, sizeof(hwm));
+    backend.bind(workersUri);
+
+    std::vector<std::thread> workers;
+    for(size_t worker_i = 0; worker_i < std::max(vm["workers"].as<size_t>(), static_cast<size_t>(1)); ++worker_i){
+        workers.emplace_back(work, std::ref(context), std::ref(signaling));
+    }
 
-                s_send(socket, " ");
-                std::cout << "DESTRUCT" << std::endl;
-                break;
-            default:
-                // Reply empty message
-                s_send(socket, " ");
-                std::cout << "UNKNOWN MESSAGE TYPE" << std::endl;
+    if(vm.count("simulate")){
+        std::string const signalingUri = vm["protocoll"].as<std::string>() + "://" + (vm.count("ip") ? vm["ip"].as<std::string>() : "127.0.0.1") + ":" + std::to_string(vm["port"].as<unsigned>());
+        // The uri is copied, the thread outlives this scope
+        std::thread simulation([&, signalingUri]{
+                simulate(signalingUri, vm["simulate"].as<size_t>(), vm["jobs"].as<size_t>(), vm["simulation-threads"].as<size_t>());
                 exit(0);
-                break;
-
-        };
-
+            });
+        simulation.detach();
     }
 
+    // Forwards requests to the workers and their replies back to the peers
+    zmq::proxy(static_cast<void*>(frontend), static_cast<void*>(backend), nullptr);
+
 }